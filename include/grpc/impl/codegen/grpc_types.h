@@ -231,6 +231,24 @@ typedef struct {
 /** How much data are we willing to queue up per stream if
     GRPC_WRITE_BUFFER_HINT is set? This is an upper bound */
 #define GRPC_ARG_HTTP2_WRITE_BUFFER_SIZE "grpc.http2.write_buffer_size"
+/** How many bytes of DATA may a stream of default weight write before the
+    other streams with data to send get their turn? Streams take turns
+    writing amounts proportional to their weights (see "streamWeight" in the
+    service config). 0 lets each stream write all that flow control allows,
+    in the order the streams became writable. Int valued, bytes; defaults to
+    16384. */
+#define GRPC_ARG_HTTP2_STREAM_WRITE_QUANTUM "grpc.http2.stream_write_quantum"
+/** How many bytes should an http2 transport try to put on the wire in a
+    single write? Int valued, bytes; defaults to 1MB. */
+#define GRPC_ARG_HTTP2_TARGET_WRITE_SIZE "grpc.http2.target_write_size"
+/** For how long may an http2 transport hold back a write of stream data so
+    that frames queued shortly after it go out in the same syscall? Writes are
+    only held while the connection has other open streams and wrote within
+    the last delay, and go out early once GRPC_ARG_HTTP2_TARGET_WRITE_SIZE
+    bytes are queued; pings, settings and resets are never held. Int valued,
+    milliseconds; defaults to 0 (never hold writes). */
+#define GRPC_ARG_HTTP2_WRITE_COALESCING_DELAY_MS \
+  "grpc.http2.write_coalescing_delay_ms"
 /** Should we allow receipt of true-binary data on http2 connections?
     Defaults to on (1) */
 #define GRPC_ARG_HTTP2_ENABLE_TRUE_BINARY "grpc.http2.true_binary"
@@ -287,6 +305,16 @@ typedef struct {
  *        can break old binaries that don't support larger than 1MiB frame
  *        size. */
 #define GRPC_ARG_TSI_MAX_FRAME_SIZE "grpc.tsi.max_frame_size"
+/** If non-zero, once a TLS handshake over a TCP socket completes, the records
+ *  written on the connection are encrypted by the kernel (Linux kernel TLS)
+ *  instead of in userspace, so outgoing data is handed to the socket without
+ *  being copied into protected frames first. Only TLS 1.2 AES-GCM sessions
+ *  are offloaded; connections that can't be offloaded (no kernel support,
+ *  TLS 1.3, other ciphers, or TCP TX zerocopy enabled) keep encrypting in
+ *  userspace.
+ *  Default 0. */
+#define GRPC_ARG_TLS_KERNEL_OFFLOAD_ENABLED \
+  "grpc.experimental.tls_kernel_offload_enabled"
 /** Maximum metadata size, in bytes. Note this limit applies to the max sum of
     all metadata key-value entries in a batch of headers. */
 #define GRPC_ARG_MAX_METADATA_SIZE "grpc.max_metadata_size"
@@ -349,6 +377,17 @@ typedef struct {
    issued by the tcp_write(). By default, this is set to 4. */
 #define GRPC_ARG_TCP_TX_ZEROCOPY_MAX_SIMULT_SENDS \
   "grpc.experimental.tcp_tx_zerocopy_max_simultaneous_sends"
+/* TCP RX Zerocopy enable state: zero is disabled, non-zero is enabled. When
+   enabled, large reads map the kernel's receive pages into the slices handed
+   to the transport (TCP_ZEROCOPY_RECEIVE) instead of copying them. By default,
+   it is disabled. */
+#define GRPC_ARG_TCP_RX_ZEROCOPY_ENABLED \
+  "grpc.experimental.tcp_rx_zerocopy_enabled"
+/* TCP RX Zerocopy receive threshold: only map pages if at least this many
+   bytes are known to be pending on the socket; smaller reads are copied. By
+   default, this is set to 256KB. */
+#define GRPC_ARG_TCP_RX_ZEROCOPY_RECV_BYTES_THRESHOLD \
+  "grpc.experimental.tcp_rx_zerocopy_recv_bytes_threshold"
 /* Timeout in milliseconds to use for calls to the grpclb load balancer.
    If 0 or unset, the balancer calls will have no deadline. */
 #define GRPC_ARG_GRPCLB_CALL_TIMEOUT_MS "grpc.grpclb_call_timeout_ms"
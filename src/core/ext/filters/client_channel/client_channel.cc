@@ -2307,6 +2307,11 @@ grpc_error_handle ClientChannel::CallData::ApplyServiceConfigToCallLocked(
           *send_initial_metadata_flags &= ~GRPC_INITIAL_METADATA_WAIT_FOR_READY;
         }
       }
+      // Pass the stream weight from the service config to the transport.
+      if (method_params->stream_weight() != 0) {
+        pending_batches_[0]->payload->send_initial_metadata.stream_weight =
+            method_params->stream_weight();
+      }
     }
     // Set the dynamic filter stack.
     dynamic_filters_ = chand->dynamic_filters_;
@@ -31,6 +31,7 @@
 #include "src/core/ext/xds/xds_channel_args.h"
 #include "src/core/ext/xds/xds_client.h"
 #include "src/core/ext/xds/xds_http_filters.h"
+#include "src/core/ext/xds/xds_route_table.h"
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/iomgr/closure.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
@@ -240,6 +241,8 @@ class XdsResolver : public Resolver {
 
     RefCountedPtr<XdsResolver> resolver_;
     RouteTable route_table_;
+    // Matches requests against the matchers in route_table_.
+    std::unique_ptr<XdsRouteTable> compiled_route_table_;
     std::map<absl::string_view, RefCountedPtr<ClusterState>> clusters_;
     std::vector<const grpc_channel_filter*> filters_;
   };
@@ -419,6 +422,14 @@ XdsResolver::XdsConfigSelector::XdsConfigSelector(
       }
     }
   }
+  // Compile the path matchers of the routes.
+  std::vector<const XdsApi::Route::Matchers*> route_matchers;
+  route_matchers.reserve(route_table_.size());
+  for (const auto& entry : route_table_) {
+    route_matchers.push_back(&entry.route.matchers);
+  }
+  compiled_route_table_ =
+      absl::make_unique<XdsRouteTable>(std::move(route_matchers));
   // Populate filter list.
   for (const auto& http_filter :
        resolver_->current_listener_.http_connection_manager.http_filters) {
@@ -586,39 +597,14 @@ void XdsResolver::XdsConfigSelector::MaybeAddCluster(const std::string& name) {
   }
 }
 
-absl::optional<absl::string_view> GetHeaderValue(
-    grpc_metadata_batch* initial_metadata, absl::string_view header_name,
-    std::string* concatenated_value) {
-  // Note: If we ever allow binary headers here, we still need to
-  // special-case ignore "grpc-tags-bin" and "grpc-trace-bin", since
-  // they are not visible to the LB policy in grpc-go.
-  if (absl::EndsWith(header_name, "-bin")) {
-    return absl::nullopt;
-  } else if (header_name == "content-type") {
-    return "application/grpc";
-  }
-  return initial_metadata->GetValue(header_name, concatenated_value);
-}
-
-bool HeadersMatch(const std::vector<HeaderMatcher>& header_matchers,
-                  grpc_metadata_batch* initial_metadata) {
-  for (const auto& header_matcher : header_matchers) {
-    std::string concatenated_value;
-    if (!header_matcher.Match(GetHeaderValue(
-            initial_metadata, header_matcher.name(), &concatenated_value))) {
-      return false;
-    }
-  }
-  return true;
-}
-
 absl::optional<uint64_t> HeaderHashHelper(
     const XdsApi::Route::HashPolicy& policy,
     grpc_metadata_batch* initial_metadata) {
   GPR_ASSERT(policy.type == XdsApi::Route::HashPolicy::HEADER);
   std::string value_buffer;
   absl::optional<absl::string_view> header_value =
-      GetHeaderValue(initial_metadata, policy.header_name, &value_buffer);
+      XdsRouteTable::GetHeaderValue(initial_metadata, policy.header_name,
+                                    &value_buffer);
   if (!header_value.has_value()) {
     return absl::nullopt;
   }
@@ -634,119 +620,99 @@ absl::optional<uint64_t> HeaderHashHelper(
   return XXH64(header_value->data(), header_value->size(), 0);
 }
 
-bool UnderFraction(const uint32_t fraction_per_million) {
-  // Generate a random number in [0, 1000000).
-  const uint32_t random_number = rand() % 1000000;
-  return random_number < fraction_per_million;
-}
-
 ConfigSelector::CallConfig XdsResolver::XdsConfigSelector::GetCallConfig(
     GetCallConfigArgs args) {
-  for (const auto& entry : route_table_) {
-    // Path matching.
-    if (!entry.route.matchers.path_matcher.Match(
-            StringViewFromSlice(*args.path))) {
-      continue;
-    }
-    // Header Matching.
-    if (!HeadersMatch(entry.route.matchers.header_matchers,
-                      args.initial_metadata)) {
-      continue;
-    }
-    // Match fraction check
-    if (entry.route.matchers.fraction_per_million.has_value() &&
-        !UnderFraction(entry.route.matchers.fraction_per_million.value())) {
-      continue;
-    }
-    // Found a route match
-    absl::string_view cluster_name;
-    RefCountedPtr<ServiceConfig> method_config;
-    if (entry.route.weighted_clusters.empty()) {
-      cluster_name = entry.route.cluster_name;
-      method_config = entry.method_config;
-    } else {
-      const uint32_t key =
-          rand() %
-          entry.weighted_cluster_state[entry.weighted_cluster_state.size() - 1]
-              .range_end;
-      // Find the index in weighted clusters corresponding to key.
-      size_t mid = 0;
-      size_t start_index = 0;
-      size_t end_index = entry.weighted_cluster_state.size() - 1;
-      size_t index = 0;
-      while (end_index > start_index) {
-        mid = (start_index + end_index) / 2;
-        if (entry.weighted_cluster_state[mid].range_end > key) {
-          end_index = mid;
-        } else if (entry.weighted_cluster_state[mid].range_end < key) {
-          start_index = mid + 1;
-        } else {
-          index = mid + 1;
-          break;
-        }
-      }
-      if (index == 0) index = start_index;
-      GPR_ASSERT(entry.weighted_cluster_state[index].range_end > key);
-      cluster_name = entry.weighted_cluster_state[index].cluster;
-      method_config = entry.weighted_cluster_state[index].method_config;
-    }
-    auto it = clusters_.find(cluster_name);
-    GPR_ASSERT(it != clusters_.end());
-    // Generate a hash.
-    absl::optional<uint64_t> hash;
-    for (const auto& hash_policy : entry.route.hash_policies) {
-      absl::optional<uint64_t> new_hash;
-      switch (hash_policy.type) {
-        case XdsApi::Route::HashPolicy::HEADER:
-          new_hash = HeaderHashHelper(hash_policy, args.initial_metadata);
-          break;
-        case XdsApi::Route::HashPolicy::CHANNEL_ID:
-          new_hash = static_cast<uint64_t>(
-              reinterpret_cast<uintptr_t>(resolver_.get()));
-          break;
-        default:
-          GPR_ASSERT(0);
-      }
-      if (new_hash.has_value()) {
-        // Rotating the old value prevents duplicate hash rules from cancelling
-        // each other out and preserves all of the entropy
-        const uint64_t old_value =
-            hash.has_value() ? ((hash.value() << 1) | (hash.value() >> 63)) : 0;
-        hash = old_value ^ new_hash.value();
-      }
-      // If the policy is a terminal policy and a hash has been generated,
-      // ignore the rest of the hash policies.
-      if (hash_policy.terminal && hash.has_value()) {
+  absl::optional<size_t> route_index =
+      compiled_route_table_->GetRouteForRequest(
+          StringViewFromSlice(*args.path), args.initial_metadata);
+  if (!route_index.has_value()) return CallConfig();
+  const auto& entry = route_table_[*route_index];
+  absl::string_view cluster_name;
+  RefCountedPtr<ServiceConfig> method_config;
+  if (entry.route.weighted_clusters.empty()) {
+    cluster_name = entry.route.cluster_name;
+    method_config = entry.method_config;
+  } else {
+    const uint32_t key =
+        rand() %
+        entry.weighted_cluster_state[entry.weighted_cluster_state.size() - 1]
+            .range_end;
+    // Find the index in weighted clusters corresponding to key.
+    size_t mid = 0;
+    size_t start_index = 0;
+    size_t end_index = entry.weighted_cluster_state.size() - 1;
+    size_t index = 0;
+    while (end_index > start_index) {
+      mid = (start_index + end_index) / 2;
+      if (entry.weighted_cluster_state[mid].range_end > key) {
+        end_index = mid;
+      } else if (entry.weighted_cluster_state[mid].range_end < key) {
+        start_index = mid + 1;
+      } else {
+        index = mid + 1;
         break;
       }
     }
-    if (!hash.has_value()) {
-      // If there is no hash, we just choose a random value as a default.
-      // We cannot directly use the result of rand() as the hash value,
-      // since it is a 32-bit number and not a 64-bit number and will
-      // therefore not be evenly distributed.
-      uint32_t upper = rand();
-      uint32_t lower = rand();
-      hash = (static_cast<uint64_t>(upper) << 32) | lower;
-    }
-    CallConfig call_config;
-    if (method_config != nullptr) {
-      call_config.method_configs =
-          method_config->GetMethodParsedConfigVector(grpc_empty_slice());
-      call_config.service_config = std::move(method_config);
-    }
-    call_config.call_attributes[kXdsClusterAttribute] = it->first;
-    std::string hash_string = absl::StrCat(hash.value());
-    char* hash_value =
-        static_cast<char*>(args.arena->Alloc(hash_string.size() + 1));
-    memcpy(hash_value, hash_string.c_str(), hash_string.size());
-    hash_value[hash_string.size()] = '\0';
-    call_config.call_attributes[kRequestRingHashAttribute] = hash_value;
-    call_config.call_dispatch_controller =
-        args.arena->New<XdsCallDispatchController>(it->second->Ref());
-    return call_config;
-  }
-  return CallConfig();
+    if (index == 0) index = start_index;
+    GPR_ASSERT(entry.weighted_cluster_state[index].range_end > key);
+    cluster_name = entry.weighted_cluster_state[index].cluster;
+    method_config = entry.weighted_cluster_state[index].method_config;
+  }
+  auto it = clusters_.find(cluster_name);
+  GPR_ASSERT(it != clusters_.end());
+  // Generate a hash.
+  absl::optional<uint64_t> hash;
+  for (const auto& hash_policy : entry.route.hash_policies) {
+    absl::optional<uint64_t> new_hash;
+    switch (hash_policy.type) {
+      case XdsApi::Route::HashPolicy::HEADER:
+        new_hash = HeaderHashHelper(hash_policy, args.initial_metadata);
+        break;
+      case XdsApi::Route::HashPolicy::CHANNEL_ID:
+        new_hash = static_cast<uint64_t>(
+            reinterpret_cast<uintptr_t>(resolver_.get()));
+        break;
+      default:
+        GPR_ASSERT(0);
+    }
+    if (new_hash.has_value()) {
+      // Rotating the old value prevents duplicate hash rules from cancelling
+      // each other out and preserves all of the entropy
+      const uint64_t old_value =
+          hash.has_value() ? ((hash.value() << 1) | (hash.value() >> 63)) : 0;
+      hash = old_value ^ new_hash.value();
+    }
+    // If the policy is a terminal policy and a hash has been generated,
+    // ignore the rest of the hash policies.
+    if (hash_policy.terminal && hash.has_value()) {
+      break;
+    }
+  }
+  if (!hash.has_value()) {
+    // If there is no hash, we just choose a random value as a default.
+    // We cannot directly use the result of rand() as the hash value,
+    // since it is a 32-bit number and not a 64-bit number and will
+    // therefore not be evenly distributed.
+    uint32_t upper = rand();
+    uint32_t lower = rand();
+    hash = (static_cast<uint64_t>(upper) << 32) | lower;
+  }
+  CallConfig call_config;
+  if (method_config != nullptr) {
+    call_config.method_configs =
+        method_config->GetMethodParsedConfigVector(grpc_empty_slice());
+    call_config.service_config = std::move(method_config);
+  }
+  call_config.call_attributes[kXdsClusterAttribute] = it->first;
+  std::string hash_string = absl::StrCat(hash.value());
+  char* hash_value =
+      static_cast<char*>(args.arena->Alloc(hash_string.size() + 1));
+  memcpy(hash_value, hash_string.c_str(), hash_string.size());
+  hash_value[hash_string.size()] = '\0';
+  call_config.call_attributes[kRequestRingHashAttribute] = hash_value;
+  call_config.call_dispatch_controller =
+      args.arena->New<XdsCallDispatchController>(it->second->Ref());
+  return call_config;
 }
 
 //
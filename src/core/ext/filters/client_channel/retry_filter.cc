@@ -575,6 +575,7 @@ class RetryFilter::CallData {
   grpc_linked_mdelem* send_initial_metadata_storage_ = nullptr;
   grpc_metadata_batch send_initial_metadata_;
   uint32_t send_initial_metadata_flags_;
+  uint32_t stream_weight_;
   // TODO(roth): As part of implementing hedging, we'll probably need to
   // have the LB call set a value in CallAttempt and then propagate it
   // from CallAttempt to the parent call when we commit.  Otherwise, we
@@ -1941,6 +1942,7 @@ void RetryFilter::CallData::CallAttempt::BatchData::
       &call_attempt_->send_initial_metadata_;
   batch_.payload->send_initial_metadata.send_initial_metadata_flags =
       calld->send_initial_metadata_flags_;
+  batch_.payload->send_initial_metadata.stream_weight = calld->stream_weight_;
   batch_.payload->send_initial_metadata.peer_string = calld->peer_string_;
 }
 
@@ -2298,6 +2300,7 @@ void RetryFilter::CallData::MaybeCacheSendOpsForBatch(PendingBatch* pending) {
                              send_initial_metadata_storage_);
     send_initial_metadata_flags_ =
         batch->payload->send_initial_metadata.send_initial_metadata_flags;
+    stream_weight_ = batch->payload->send_initial_metadata.stream_weight;
     peer_string_ = batch->payload->send_initial_metadata.peer_string;
   }
   // Set up cache for send_message ops.
@@ -30,37 +30,150 @@
 
 namespace grpc_core {
 
+//
+// ServiceConfig::JsonHandler
+//
+
+// Builds the JSON tree for the top-level object, except that each element of
+// the "methodConfig" array is parsed as soon as it has been read and is then
+// discarded, so that the tree for the whole array is never built.
+class ServiceConfig::JsonHandler : public JsonEventHandler {
+ public:
+  JsonHandler(ServiceConfig* service_config, const grpc_channel_args* args)
+      : service_config_(service_config), args_(args) {}
+
+  ~JsonHandler() override {
+    for (grpc_error_handle error : error_list_) GRPC_ERROR_UNREF(error);
+  }
+
+  void StartObject() override {
+    CurrentBuilder()->StartObject();
+    ++depth_;
+  }
+
+  void EndObject() override {
+    --depth_;
+    CurrentBuilder()->EndObject();
+    MaybeParseMethodConfig();
+  }
+
+  void StartArray() override {
+    CurrentBuilder()->StartArray();
+    ++depth_;
+    if (depth_ == 2 && key_is_method_config_) in_method_configs_ = true;
+  }
+
+  void EndArray() override {
+    --depth_;
+    if (depth_ == 1) in_method_configs_ = false;
+    CurrentBuilder()->EndArray();
+    MaybeParseMethodConfig();
+  }
+
+  bool Key(absl::string_view key) override {
+    if (depth_ == 1) key_is_method_config_ = key == "methodConfig";
+    return CurrentBuilder()->Key(key);
+  }
+
+  void String(absl::string_view value) override {
+    CurrentBuilder()->String(value);
+    MaybeParseMethodConfig();
+  }
+
+  void Number(absl::string_view value) override {
+    CurrentBuilder()->Number(value);
+    MaybeParseMethodConfig();
+  }
+
+  void Bool(bool value) override {
+    CurrentBuilder()->Bool(value);
+    MaybeParseMethodConfig();
+  }
+
+  void Null() override {
+    CurrentBuilder()->Null();
+    MaybeParseMethodConfig();
+  }
+
+  // Returns the top-level value, in which the "methodConfig" array, if
+  // there was one, is empty.
+  Json TakeValue() { return top_level_.TakeValue(); }
+
+  // Returns the errors from parsing the method configs.
+  grpc_error_handle TakeMethodConfigErrors(const Json& json) {
+    auto it = json.object_value().find("methodConfig");
+    if (it != json.object_value().end() &&
+        it->second.type() != Json::Type::ARRAY) {
+      error_list_.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+          "field:methodConfig error:not of type Array"));
+    }
+    return GRPC_ERROR_CREATE_FROM_VECTOR("Method Params", &error_list_);
+  }
+
+ private:
+  JsonTreeBuilder* CurrentBuilder() {
+    return in_method_configs_ ? &method_config_ : &top_level_;
+  }
+
+  // Parses the current element of the "methodConfig" array if it is
+  // complete.
+  void MaybeParseMethodConfig() {
+    if (!in_method_configs_ || depth_ != 2) return;
+    Json json = method_config_.TakeValue();
+    if (json.type() != Json::Type::OBJECT) {
+      error_list_.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+          "field:methodConfig error:not of type Object"));
+      return;
+    }
+    grpc_error_handle error =
+        service_config_->ParseJsonMethodConfig(args_, json);
+    if (error != GRPC_ERROR_NONE) error_list_.push_back(error);
+  }
+
+  ServiceConfig* service_config_;
+  const grpc_channel_args* args_;
+  JsonTreeBuilder top_level_;
+  JsonTreeBuilder method_config_;
+  // The number of containers open.
+  int depth_ = 0;
+  // Whether the last key of the top-level object was "methodConfig".
+  bool key_is_method_config_ = false;
+  // Whether the top-level "methodConfig" array is open.
+  bool in_method_configs_ = false;
+  std::vector<grpc_error_handle> error_list_;
+};
+
+//
+// ServiceConfig
+//
+
 RefCountedPtr<ServiceConfig> ServiceConfig::Create(
     const grpc_channel_args* args, absl::string_view json_string,
     grpc_error_handle* error) {
   GPR_DEBUG_ASSERT(error != nullptr);
-  Json json = Json::Parse(json_string, error);
+  RefCountedPtr<ServiceConfig> service_config(
+      new ServiceConfig(std::string(json_string)));
+  JsonHandler handler(service_config.get(), args);
+  *error = Json::Parse(json_string, &handler);
   if (*error != GRPC_ERROR_NONE) return nullptr;
-  return MakeRefCounted<ServiceConfig>(args, std::string(json_string),
-                                       std::move(json), error);
-}
-
-ServiceConfig::ServiceConfig(const grpc_channel_args* args,
-                             std::string json_string, Json json,
-                             grpc_error_handle* error)
-    : json_string_(std::move(json_string)), json_(std::move(json)) {
-  GPR_DEBUG_ASSERT(error != nullptr);
-  if (json_.type() != Json::Type::OBJECT) {
+  Json json = handler.TakeValue();
+  if (json.type() != Json::Type::OBJECT) {
     *error =
         GRPC_ERROR_CREATE_FROM_STATIC_STRING("JSON value is not an object");
-    return;
+    return service_config;
   }
   std::vector<grpc_error_handle> error_list;
   grpc_error_handle global_error = GRPC_ERROR_NONE;
-  parsed_global_configs_ =
-      ServiceConfigParser::ParseGlobalParameters(args, json_, &global_error);
+  service_config->parsed_global_configs_ =
+      ServiceConfigParser::ParseGlobalParameters(args, json, &global_error);
   if (global_error != GRPC_ERROR_NONE) error_list.push_back(global_error);
-  grpc_error_handle local_error = ParsePerMethodParams(args);
+  grpc_error_handle local_error = handler.TakeMethodConfigErrors(json);
   if (local_error != GRPC_ERROR_NONE) error_list.push_back(local_error);
   if (!error_list.empty()) {
     *error = GRPC_ERROR_CREATE_FROM_VECTOR("Service config parsing error",
                                            &error_list);
   }
+  return service_config;
 }
 
 ServiceConfig::~ServiceConfig() {
@@ -130,30 +243,6 @@ grpc_error_handle ServiceConfig::ParseJsonMethodConfig(
   return GRPC_ERROR_CREATE_FROM_VECTOR("methodConfig", &error_list);
 }
 
-grpc_error_handle ServiceConfig::ParsePerMethodParams(
-    const grpc_channel_args* args) {
-  std::vector<grpc_error_handle> error_list;
-  auto it = json_.object_value().find("methodConfig");
-  if (it != json_.object_value().end()) {
-    if (it->second.type() != Json::Type::ARRAY) {
-      error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
-          "field:methodConfig error:not of type Array"));
-    }
-    for (const Json& method_config : it->second.array_value()) {
-      if (method_config.type() != Json::Type::OBJECT) {
-        error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
-            "field:methodConfig error:not of type Object"));
-        continue;
-      }
-      grpc_error_handle error = ParseJsonMethodConfig(args, method_config);
-      if (error != GRPC_ERROR_NONE) {
-        error_list.push_back(error);
-      }
-    }
-  }
-  return GRPC_ERROR_CREATE_FROM_VECTOR("Method Params", &error_list);
-}
-
 std::string ServiceConfig::ParseJsonMethodName(const Json& json,
                                                grpc_error_handle* error) {
   if (json.type() != Json::Type::OBJECT) {
@@ -53,6 +53,7 @@
 //       "timeout": "duration_string",
 //       "maxRequestMessageBytes": "int64_string",
 //       "maxResponseMessageBytes": "int64_string",
+//       "streamWeight": number,  // 1 to 256; the default is 16
 //     }
 //   ]
 // }
@@ -69,8 +70,6 @@ class ServiceConfig : public RefCounted<ServiceConfig> {
                                              absl::string_view json_string,
                                              grpc_error_handle* error);
 
-  ServiceConfig(const grpc_channel_args* args, std::string json_string,
-                Json json, grpc_error_handle* error);
   ~ServiceConfig() override;
 
   const std::string& json_string() const { return json_string_; }
@@ -90,8 +89,12 @@ class ServiceConfig : public RefCounted<ServiceConfig> {
       const grpc_slice& path) const;
 
  private:
-  // Helper functions for parsing the method configs.
-  grpc_error_handle ParsePerMethodParams(const grpc_channel_args* args);
+  class JsonHandler;
+
+  explicit ServiceConfig(std::string json_string)
+      : json_string_(std::move(json_string)) {}
+
+  // Helper function for parsing the method configs.
   grpc_error_handle ParseJsonMethodConfig(const grpc_channel_args* args,
                                           const Json& json);
 
@@ -101,7 +104,6 @@ class ServiceConfig : public RefCounted<ServiceConfig> {
                                          grpc_error_handle* error);
 
   std::string json_string_;
-  Json json_;
 
   absl::InlinedVector<std::unique_ptr<ServiceConfigParser::ParsedConfig>,
                       ServiceConfigParser::kNumPreallocatedParsers>
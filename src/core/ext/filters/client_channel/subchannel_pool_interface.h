@@ -38,29 +38,26 @@ class SubchannelKey {
  public:
   SubchannelKey(const grpc_resolved_address& address,
                 const grpc_channel_args* args);
-  ~SubchannelKey();
 
   // Copyable.
-  SubchannelKey(const SubchannelKey& other);
-  SubchannelKey& operator=(const SubchannelKey& other);
+  SubchannelKey(const SubchannelKey& other) = default;
+  SubchannelKey& operator=(const SubchannelKey& other) = default;
   // Movable
-  SubchannelKey(SubchannelKey&&) noexcept;
-  SubchannelKey& operator=(SubchannelKey&&) noexcept;
+  SubchannelKey(SubchannelKey&&) noexcept = default;
+  SubchannelKey& operator=(SubchannelKey&&) noexcept = default;
 
   bool operator<(const SubchannelKey& other) const;
 
   const grpc_resolved_address& address() const { return address_; }
-  const grpc_channel_args* args() const { return args_; }
+  // The args sorted by key, with duplicate keys removed.
+  const grpc_channel_args* args() const { return args_.ToC(); }
 
  private:
-  // Initializes the subchannel key with the given \a args and the function to
-  // copy channel args.
-  void Init(
-      const grpc_resolved_address& address, const grpc_channel_args* args,
-      grpc_channel_args* (*copy_channel_args)(const grpc_channel_args* args));
-
   grpc_resolved_address address_;
-  const grpc_channel_args* args_;
+  // Shared by the copies of the key, which the subchannel pools make, and
+  // hashed, so that keys with different args usually compare without
+  // walking them.
+  ChannelArgs args_;
 };
 
 // Interface for subchannel pool.
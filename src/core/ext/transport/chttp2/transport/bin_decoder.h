@@ -41,6 +41,13 @@ struct grpc_base64_decode_context {
    than 3. Returns false if decoding is failed. */
 bool grpc_base64_decode_partial(struct grpc_base64_decode_context* ctx);
 
+/* base64 decode up to num_quads groups of four characters (without pad chars)
+   from input into three bytes each at output. Stops before the first group
+   that contains a character outside the base64 alphabet. Returns the number of
+   groups decoded. */
+size_t grpc_base64_decode_quads(const uint8_t* input, size_t num_quads,
+                                uint8_t* output);
+
 /* base64 decode a slice with pad chars. Returns a new slice, does not take
    ownership of the input. Returns an empty slice if decoding is failed. */
 grpc_slice grpc_chttp2_base64_decode(const grpc_slice& input);
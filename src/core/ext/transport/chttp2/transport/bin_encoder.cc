@@ -48,6 +48,44 @@ static const b64_huff_sym huff_alphabet[64] = {
 
 static const uint8_t tail_xtra[3] = {0, 2, 3};
 
+namespace {
+/* Every 12-bit value (two base64 symbols) mapped to its two characters and to
+   the concatenation of their huffman codes, so that each input triplet is
+   encoded with two lookups rather than four. */
+struct b64_pair_huff_sym {
+  uint32_t bits;
+  uint8_t length;
+};
+class Base64PairTable {
+ public:
+  static const Base64PairTable* Get() {
+    static const Base64PairTable* table = new Base64PairTable();
+    return table;
+  }
+
+  const char* chars(uint32_t pair) const { return chars_[pair]; }
+  const b64_pair_huff_sym& huff(uint32_t pair) const { return huff_[pair]; }
+
+ private:
+  Base64PairTable() {
+    for (uint32_t pair = 0; pair < 4096; pair++) {
+      const uint32_t a = pair >> 6;
+      const uint32_t b = pair & 0x3f;
+      chars_[pair][0] = alphabet[a];
+      chars_[pair][1] = alphabet[b];
+      const b64_huff_sym sa = huff_alphabet[a];
+      const b64_huff_sym sb = huff_alphabet[b];
+      huff_[pair].bits =
+          (static_cast<uint32_t>(sa.bits) << sb.length) | sb.bits;
+      huff_[pair].length = static_cast<uint8_t>(sa.length + sb.length);
+    }
+  }
+
+  char chars_[4096][2];
+  b64_pair_huff_sym huff_[4096];
+};
+}  // namespace
+
 grpc_slice grpc_chttp2_base64_encode(const grpc_slice& input) {
   size_t input_length = GRPC_SLICE_LENGTH(input);
   size_t input_triplets = input_length / 3;
@@ -58,12 +96,11 @@ grpc_slice grpc_chttp2_base64_encode(const grpc_slice& input) {
   char* out = reinterpret_cast<char*> GRPC_SLICE_START_PTR(output);
   size_t i;
 
-  /* encode full triplets */
+  /* encode full triplets, as two 12-bit halves */
+  const Base64PairTable* pairs = Base64PairTable::Get();
   for (i = 0; i < input_triplets; i++) {
-    out[0] = alphabet[in[0] >> 2];
-    out[1] = alphabet[((in[0] & 0x3) << 4) | (in[1] >> 4)];
-    out[2] = alphabet[((in[1] & 0xf) << 2) | (in[2] >> 6)];
-    out[3] = alphabet[in[2] & 0x3f];
+    memcpy(out, pairs->chars((in[0] << 4) | (in[1] >> 4)), 2);
+    memcpy(out + 2, pairs->chars(((in[1] & 0xf) << 8) | in[2]), 2);
     out += 4;
     in += 3;
   }
@@ -92,13 +129,48 @@ grpc_slice grpc_chttp2_base64_encode(const grpc_slice& input) {
   return output;
 }
 
+/* Bits are accumulated in a 64-bit word and written out four bytes at a
+   time: with codes of at most 30 bits, fewer than 32 pending bits plus one
+   code always fit. */
+struct huff_out {
+  uint64_t temp;
+  uint32_t temp_length;
+  uint8_t* out;
+};
+static void enc_flush_some(huff_out* out) {
+  if (out->temp_length >= 32) {
+    out->temp_length -= 32;
+    const uint32_t word = static_cast<uint32_t>(out->temp >> out->temp_length);
+    out->out[0] = static_cast<uint8_t>(word >> 24);
+    out->out[1] = static_cast<uint8_t>(word >> 16);
+    out->out[2] = static_cast<uint8_t>(word >> 8);
+    out->out[3] = static_cast<uint8_t>(word);
+    out->out += 4;
+  }
+}
+
+static void enc_finish(huff_out* out) {
+  while (out->temp_length >= 8) {
+    out->temp_length -= 8;
+    *out->out++ = static_cast<uint8_t>(out->temp >> out->temp_length);
+  }
+  if (out->temp_length) {
+    /* NB: the following integer arithmetic operation needs to be in its
+     * expanded form due to the "integral promotion" performed (see section
+     * 3.2.1.1 of the C89 draft standard). A cast to the smaller container type
+     * is then required to avoid the compiler warning */
+    *out->out++ = static_cast<uint8_t>(
+        static_cast<uint8_t>(out->temp << (8u - out->temp_length)) |
+        static_cast<uint8_t>(0xffu >> out->temp_length));
+    out->temp_length = 0;
+  }
+}
+
 grpc_slice grpc_chttp2_huffman_compress(const grpc_slice& input) {
   size_t nbits;
   const uint8_t* in;
-  uint8_t* out;
   grpc_slice output;
-  uint32_t temp = 0;
-  uint32_t temp_length = 0;
+  huff_out out;
 
   nbits = 0;
   for (in = GRPC_SLICE_START_PTR(input); in != GRPC_SLICE_END_PTR(input);
@@ -107,54 +179,28 @@ grpc_slice grpc_chttp2_huffman_compress(const grpc_slice& input) {
   }
 
   output = GRPC_SLICE_MALLOC(nbits / 8 + (nbits % 8 != 0));
-  out = GRPC_SLICE_START_PTR(output);
+  out.temp = 0;
+  out.temp_length = 0;
+  out.out = GRPC_SLICE_START_PTR(output);
   for (in = GRPC_SLICE_START_PTR(input); in != GRPC_SLICE_END_PTR(input);
        ++in) {
-    int sym = *in;
-    temp <<= grpc_chttp2_huffsyms[sym].length;
-    temp |= grpc_chttp2_huffsyms[sym].bits;
-    temp_length += grpc_chttp2_huffsyms[sym].length;
-
-    while (temp_length > 8) {
-      temp_length -= 8;
-      *out++ = static_cast<uint8_t>(temp >> temp_length);
-    }
+    const grpc_chttp2_huffsym& sym = grpc_chttp2_huffsyms[*in];
+    out.temp = (out.temp << sym.length) | sym.bits;
+    out.temp_length += sym.length;
+    enc_flush_some(&out);
   }
+  enc_finish(&out);
 
-  if (temp_length) {
-    /* NB: the following integer arithmetic operation needs to be in its
-     * expanded form due to the "integral promotion" performed (see section
-     * 3.2.1.1 of the C89 draft standard). A cast to the smaller container type
-     * is then required to avoid the compiler warning */
-    *out++ =
-        static_cast<uint8_t>(static_cast<uint8_t>(temp << (8u - temp_length)) |
-                             static_cast<uint8_t>(0xffu >> temp_length));
-  }
-
-  GPR_ASSERT(out == GRPC_SLICE_END_PTR(output));
+  GPR_ASSERT(out.out == GRPC_SLICE_END_PTR(output));
 
   return output;
 }
 
-struct huff_out {
-  uint32_t temp;
-  uint32_t temp_length;
-  uint8_t* out;
-};
-static void enc_flush_some(huff_out* out) {
-  while (out->temp_length > 8) {
-    out->temp_length -= 8;
-    *out->out++ = static_cast<uint8_t>(out->temp >> out->temp_length);
-  }
-}
-
-static void enc_add2(huff_out* out, uint8_t a, uint8_t b) {
-  b64_huff_sym sa = huff_alphabet[a];
-  b64_huff_sym sb = huff_alphabet[b];
-  out->temp = (out->temp << (sa.length + sb.length)) |
-              (static_cast<uint32_t>(sa.bits) << sb.length) | sb.bits;
-  out->temp_length +=
-      static_cast<uint32_t>(sa.length) + static_cast<uint32_t>(sb.length);
+static void enc_add_pair(huff_out* out, const Base64PairTable* pairs,
+                         uint32_t pair) {
+  const b64_pair_huff_sym& s = pairs->huff(pair);
+  out->temp = (out->temp << s.length) | s.bits;
+  out->temp_length += s.length;
   enc_flush_some(out);
 }
 
@@ -183,15 +229,11 @@ grpc_slice grpc_chttp2_base64_encode_and_huffman_compress(
   out.temp_length = 0;
   out.out = start_out;
 
-  /* encode full triplets */
+  /* encode full triplets, as two 12-bit halves */
+  const Base64PairTable* pairs = Base64PairTable::Get();
   for (i = 0; i < input_triplets; i++) {
-    const uint8_t low_to_high = static_cast<uint8_t>((in[0] & 0x3) << 4);
-    const uint8_t high_to_low = in[1] >> 4;
-    enc_add2(&out, in[0] >> 2, low_to_high | high_to_low);
-
-    const uint8_t a = static_cast<uint8_t>((in[1] & 0xf) << 2);
-    const uint8_t b = (in[2] >> 6);
-    enc_add2(&out, a | b, in[2] & 0x3f);
+    enc_add_pair(&out, pairs, (in[0] << 4) | (in[1] >> 4));
+    enc_add_pair(&out, pairs, ((in[1] & 0xf) << 8) | in[2]);
     in += 3;
   }
 
@@ -200,28 +242,17 @@ grpc_slice grpc_chttp2_base64_encode_and_huffman_compress(
     case 0:
       break;
     case 1:
-      enc_add2(&out, in[0] >> 2, static_cast<uint8_t>((in[0] & 0x3) << 4));
+      enc_add_pair(&out, pairs, in[0] << 4);
       in += 1;
       break;
-    case 2: {
-      const uint8_t low_to_high = static_cast<uint8_t>((in[0] & 0x3) << 4);
-      const uint8_t high_to_low = in[1] >> 4;
-      enc_add2(&out, in[0] >> 2, low_to_high | high_to_low);
+    case 2:
+      enc_add_pair(&out, pairs, (in[0] << 4) | (in[1] >> 4));
       enc_add1(&out, static_cast<uint8_t>((in[1] & 0xf) << 2));
       in += 2;
       break;
-    }
   }
 
-  if (out.temp_length) {
-    /* NB: the following integer arithmetic operation needs to be in its
-     * expanded form due to the "integral promotion" performed (see section
-     * 3.2.1.1 of the C89 draft standard). A cast to the smaller container type
-     * is then required to avoid the compiler warning */
-    *out.out++ = static_cast<uint8_t>(
-        static_cast<uint8_t>(out.temp << (8u - out.temp_length)) |
-        static_cast<uint8_t>(0xffu >> out.temp_length));
-  }
+  enc_finish(&out);
 
   GPR_ASSERT(out.out <= GRPC_SLICE_END_PTR(output));
   GRPC_SLICE_SET_LENGTH(output, out.out - start_out);
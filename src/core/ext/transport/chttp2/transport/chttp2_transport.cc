@@ -104,6 +104,9 @@ static void write_action_begin_locked(void* t, grpc_error_handle error);
 static void write_action(void* t, grpc_error_handle error);
 static void write_action_end(void* t, grpc_error_handle error);
 static void write_action_end_locked(void* t, grpc_error_handle error);
+static void write_coalescing_timer_expired(void* tp, grpc_error_handle error);
+static void write_coalescing_timer_expired_locked(void* tp,
+                                                  grpc_error_handle error);
 
 static void read_action(void* t, grpc_error_handle error);
 static void read_action_locked(void* t, grpc_error_handle error);
@@ -303,6 +306,21 @@ static bool read_channel_args(grpc_chttp2_transport* t,
                            GRPC_ARG_HTTP2_WRITE_BUFFER_SIZE)) {
       t->write_buffer_size = static_cast<uint32_t>(grpc_channel_arg_get_integer(
           &channel_args->args[i], {0, 0, MAX_WRITE_BUFFER_SIZE}));
+    } else if (0 == strcmp(channel_args->args[i].key,
+                           GRPC_ARG_HTTP2_STREAM_WRITE_QUANTUM)) {
+      t->stream_write_quantum =
+          static_cast<uint32_t>(grpc_channel_arg_get_integer(
+              &channel_args->args[i],
+              {GRPC_CHTTP2_DEFAULT_STREAM_WRITE_QUANTUM, 0, INT_MAX}));
+    } else if (0 == strcmp(channel_args->args[i].key,
+                           GRPC_ARG_HTTP2_TARGET_WRITE_SIZE)) {
+      t->target_write_size = static_cast<uint32_t>(grpc_channel_arg_get_integer(
+          &channel_args->args[i],
+          {GRPC_CHTTP2_DEFAULT_TARGET_WRITE_SIZE, 1, INT_MAX}));
+    } else if (0 == strcmp(channel_args->args[i].key,
+                           GRPC_ARG_HTTP2_WRITE_COALESCING_DELAY_MS)) {
+      t->write_coalescing_delay = grpc_channel_arg_get_integer(
+          &channel_args->args[i], {0, 0, INT_MAX});
     } else if (0 ==
                strcmp(channel_args->args[i].key, GRPC_ARG_HTTP2_BDP_PROBE)) {
       enable_bdp = grpc_channel_arg_get_bool(&channel_args->args[i], true);
@@ -561,6 +579,10 @@ static void close_transport_locked(grpc_chttp2_transport* t,
                                  GRPC_STATUS_UNAVAILABLE);
     }
     if (t->write_state != GRPC_CHTTP2_WRITE_STATE_IDLE) {
+      // Don't let a write held back for coalescing delay the close.
+      if (t->write_coalescing_timer_pending) {
+        grpc_timer_cancel(&t->write_coalescing_timer);
+      }
       if (t->close_transport_on_writes_finished == GRPC_ERROR_NONE) {
         t->close_transport_on_writes_finished =
             GRPC_ERROR_CREATE_FROM_STATIC_STRING(
@@ -892,6 +914,29 @@ static void inc_initiate_write_reason(
   }
 }
 
+// Returns true if a write of stream data may be held back so that frames
+// queued shortly after it can join it. Like Nagle's algorithm, this only
+// kicks in while the connection is busy: a write after a quiet period, or
+// with no other streams that could add to it, goes out right away, and so
+// does a write that already has target_write_size bytes to send.
+static bool can_coalesce_write(grpc_chttp2_transport* t,
+                               grpc_chttp2_initiate_write_reason reason) {
+  switch (reason) {
+    case GRPC_CHTTP2_INITIATE_WRITE_START_NEW_STREAM:
+    case GRPC_CHTTP2_INITIATE_WRITE_SEND_MESSAGE:
+    case GRPC_CHTTP2_INITIATE_WRITE_SEND_INITIAL_METADATA:
+    case GRPC_CHTTP2_INITIATE_WRITE_SEND_TRAILING_METADATA:
+      break;
+    default:
+      return false;
+  }
+  return t->write_coalescing_delay > 0 &&
+         t->bytes_queued_since_write < t->target_write_size &&
+         grpc_chttp2_stream_map_size(&t->stream_map) > 1 &&
+         t->last_write_time >=
+             grpc_core::ExecCtx::Get()->Now() - t->write_coalescing_delay;
+}
+
 void grpc_chttp2_initiate_write(grpc_chttp2_transport* t,
                                 grpc_chttp2_initiate_write_reason reason) {
   GPR_TIMER_SCOPE("grpc_chttp2_initiate_write", 0);
@@ -902,6 +947,18 @@ void grpc_chttp2_initiate_write(grpc_chttp2_transport* t,
       set_write_state(t, GRPC_CHTTP2_WRITE_STATE_WRITING,
                       grpc_chttp2_initiate_write_reason_string(reason));
       GRPC_CHTTP2_REF_TRANSPORT(t, "writing");
+      if (can_coalesce_write(t, reason)) {
+        GRPC_STATS_INC_HTTP2_WRITES_COALESCED();
+        t->write_coalescing_timer_pending = true;
+        GRPC_CLOSURE_INIT(&t->write_coalescing_timer_expired_locked,
+                          write_coalescing_timer_expired, t,
+                          grpc_schedule_on_exec_ctx);
+        grpc_timer_init(
+            &t->write_coalescing_timer,
+            grpc_core::ExecCtx::Get()->Now() + t->write_coalescing_delay,
+            &t->write_coalescing_timer_expired_locked);
+        break;
+      }
       // Note that the 'write_action_begin_locked' closure is being scheduled
       // on the 'finally_scheduler' of t->combiner. This means that
       // 'write_action_begin_locked' is called only *after* all the other
@@ -926,12 +983,36 @@ void grpc_chttp2_initiate_write(grpc_chttp2_transport* t,
     case GRPC_CHTTP2_WRITE_STATE_WRITING:
       set_write_state(t, GRPC_CHTTP2_WRITE_STATE_WRITING_WITH_MORE,
                       grpc_chttp2_initiate_write_reason_string(reason));
-      break;
+      ABSL_FALLTHROUGH_INTENDED;
     case GRPC_CHTTP2_WRITE_STATE_WRITING_WITH_MORE:
+      // Frames that can't wait, or enough bytes to fill a write, flush a
+      // write held back for coalescing.
+      if (t->write_coalescing_timer_pending &&
+          !can_coalesce_write(t, reason)) {
+        grpc_timer_cancel(&t->write_coalescing_timer);
+      }
       break;
   }
 }
 
+static void write_coalescing_timer_expired(void* tp, grpc_error_handle error) {
+  grpc_chttp2_transport* t = static_cast<grpc_chttp2_transport*>(tp);
+  t->combiner->Run(
+      GRPC_CLOSURE_INIT(&t->write_coalescing_timer_expired_locked,
+                        write_coalescing_timer_expired_locked, t, nullptr),
+      GRPC_ERROR_REF(error));
+}
+
+// Begins the held back write, whether the timer fired or was cancelled to
+// flush it early.
+static void write_coalescing_timer_expired_locked(
+    void* tp, grpc_error_handle /*error*/) {
+  grpc_chttp2_transport* t = static_cast<grpc_chttp2_transport*>(tp);
+  GPR_ASSERT(t->write_coalescing_timer_pending);
+  t->write_coalescing_timer_pending = false;
+  write_action_begin_locked(t, GRPC_ERROR_NONE);
+}
+
 void grpc_chttp2_mark_stream_writable(grpc_chttp2_transport* t,
                                       grpc_chttp2_stream* s) {
   if (t->closed_with_error == GRPC_ERROR_NONE &&
@@ -954,12 +1035,14 @@ static void write_action_begin_locked(void* gt,
   grpc_chttp2_transport* t = static_cast<grpc_chttp2_transport*>(gt);
   GPR_ASSERT(t->write_state != GRPC_CHTTP2_WRITE_STATE_IDLE);
   grpc_chttp2_begin_write_result r;
+  t->bytes_queued_since_write = 0;
   if (t->closed_with_error != GRPC_ERROR_NONE) {
     r.writing = false;
   } else {
     r = grpc_chttp2_begin_write(t);
   }
   if (r.writing) {
+    t->last_write_time = grpc_core::ExecCtx::Get()->Now();
     if (r.partial) {
       GRPC_STATS_INC_HTTP2_PARTIAL_WRITES();
     }
@@ -1273,6 +1356,7 @@ static void add_fetched_slice_locked(grpc_chttp2_transport* t,
                                      grpc_chttp2_stream* s) {
   s->fetched_send_message_length +=
       static_cast<uint32_t> GRPC_SLICE_LENGTH(s->fetching_slice);
+  t->bytes_queued_since_write += GRPC_SLICE_LENGTH(s->fetching_slice);
   grpc_slice_buffer_add(&s->flow_controlled_buffer, s->fetching_slice);
   maybe_become_writable_due_to_send_msg(t, s);
 }
@@ -1427,6 +1511,11 @@ static void perform_stream_op_locked(void* stream_op,
       s->stream_compression_ctx = nullptr;
       grpc_slice_buffer_init(&s->compressed_data_buffer);
     }
+    if (op_payload->send_initial_metadata.stream_weight != 0) {
+      s->write_weight =
+          std::min(op_payload->send_initial_metadata.stream_weight,
+                   uint32_t(GRPC_CHTTP2_MAX_STREAM_WEIGHT));
+    }
     s->send_initial_metadata_finished = add_closure_barrier(on_complete);
     s->send_initial_metadata =
         op_payload->send_initial_metadata.send_initial_metadata;
@@ -2594,10 +2683,22 @@ static void read_action_locked(void* tp, grpc_error_handle error) {
   GRPC_ERROR_UNREF(error);
 }
 
+// Returns how many more bytes the deframer knows it needs to finish the frame
+// it is in the middle of, or 0 if it is not far enough into a frame header to
+// know.
+static size_t pending_frame_bytes(grpc_chttp2_transport* t) {
+  if (t->deframe_state < GRPC_DTS_FH_3) return 0;
+  // Bytes left in the frame header (none in GRPC_DTS_FRAME), plus the rest
+  // of the payload.
+  return static_cast<size_t>(GRPC_DTS_FRAME - t->deframe_state) +
+         t->incoming_frame_size;
+}
+
 static void continue_read_action_locked(grpc_chttp2_transport* t) {
   const bool urgent = t->goaway_error != GRPC_ERROR_NONE;
   GRPC_CLOSURE_INIT(&t->read_action_locked, read_action, t,
                     grpc_schedule_on_exec_ctx);
+  grpc_endpoint_set_read_hint(t->ep, pending_frame_bytes(t));
   grpc_endpoint_read(t->ep, &t->read_buffer, &t->read_action_locked, urgent);
   grpc_chttp2_act_on_flowctl_action(t->flow_control->MakeAction(), t, nullptr);
 }
@@ -460,6 +460,23 @@ void HPackCompressor::Framer::Encode(GrpcTimeoutMetadata,
   GRPC_MDELEM_UNREF(mdelem);
 }
 
+void HPackCompressor::Framer::Encode(TeMetadata, TeMetadata::ValueType value) {
+  if (value != TeMetadata::ValueType::kTrailers) {
+    gpr_log(GPR_ERROR, "Not encoding bad te header");
+    return;
+  }
+  Encode(GRPC_MDELEM_TE_TRAILERS);
+}
+
+void HPackCompressor::Framer::Encode(ContentTypeMetadata,
+                                     ContentTypeMetadata::ValueType value) {
+  if (value != ContentTypeMetadata::ValueType::kApplicationGrpc) {
+    gpr_log(GPR_ERROR, "Not encoding bad content-type header");
+    return;
+  }
+  Encode(GRPC_MDELEM_CONTENT_TYPE_APPLICATION_SLASH_GRPC);
+}
+
 void HPackCompressor::SetMaxUsableSize(uint32_t max_table_size) {
   max_usable_size_ = max_table_size;
   SetMaxTableSize(std::min(table_.max_size(), max_table_size));
@@ -49,6 +49,14 @@ namespace grpc_core {
 class ContextList;
 }
 
+/* weights of streams, which set their shares of the transport's outgoing
+   bandwidth while several of them have data to write */
+#define GRPC_CHTTP2_DEFAULT_STREAM_WEIGHT 16
+#define GRPC_CHTTP2_MAX_STREAM_WEIGHT 256
+#define GRPC_CHTTP2_DEFAULT_STREAM_WRITE_QUANTUM (16 * 1024)
+
+#define GRPC_CHTTP2_DEFAULT_TARGET_WRITE_SIZE (1024 * 1024)
+
 /* streams are kept in various linked lists depending on what things need to
    happen to them... this enum labels each list */
 typedef enum {
@@ -356,6 +364,28 @@ struct grpc_chttp2_transport {
    */
   uint32_t write_buffer_size = grpc_core::chttp2::kDefaultWindow;
 
+  /** how many bytes of data may a stream of default weight write before the
+      next writable stream gets its turn? 0 means as many as flow control
+      allows */
+  uint32_t stream_write_quantum = GRPC_CHTTP2_DEFAULT_STREAM_WRITE_QUANTUM;
+  /** how many bytes would we like to put on the wire during a single
+      syscall */
+  uint32_t target_write_size = GRPC_CHTTP2_DEFAULT_TARGET_WRITE_SIZE;
+
+  /* write coalescing */
+  /** how long may a write of stream data wait for more frames to join it? 0
+      disables coalescing */
+  grpc_millis write_coalescing_delay = 0;
+  /** when did the last write begin? */
+  grpc_millis last_write_time = GRPC_MILLIS_INF_PAST;
+  /** how many message bytes were queued since the last write began? A held
+      write goes out once this reaches target_write_size */
+  size_t bytes_queued_since_write = 0;
+  /** is a write waiting on write_coalescing_timer? */
+  bool write_coalescing_timer_pending = false;
+  grpc_timer write_coalescing_timer;
+  grpc_closure write_coalescing_timer_expired_locked;
+
   /** Set to a grpc_error object if a goaway frame is received. By default, set
    * to GRPC_ERROR_NONE */
   grpc_error_handle goaway_error = GRPC_ERROR_NONE;
@@ -634,6 +664,9 @@ struct grpc_chttp2_stream {
       flow_control;
 
   grpc_slice_buffer flow_controlled_buffer;
+  /** how many bytes of data this stream writes per turn, relative to other
+      streams */
+  uint32_t write_weight = GRPC_CHTTP2_DEFAULT_STREAM_WEIGHT;
 
   grpc_chttp2_write_cb* on_flow_controlled_cbs = nullptr;
   grpc_chttp2_write_cb* on_write_finished_cbs = nullptr;
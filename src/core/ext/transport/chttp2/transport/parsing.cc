@@ -490,6 +490,27 @@ handle_metadata_add_failure(grpc_chttp2_transport* t, grpc_chttp2_stream* s,
   return GRPC_ERROR_NONE;
 }
 
+// Parses md into the known metadata Which of the stream's initial metadata,
+// instead of linking it into the batch's list.
+template <typename Which>
+static grpc_error_handle handle_known_initial_header(grpc_chttp2_transport* t,
+                                                     grpc_chttp2_stream* s,
+                                                     grpc_mdelem md,
+                                                     size_t new_size) {
+  grpc_metadata_batch* batch = &s->initial_metadata_buffer.batch;
+  if (GPR_UNLIKELY(batch->get_pointer(Which()) != nullptr)) {
+    return handle_metadata_add_failure(
+        t, s, md,
+        grpc_attach_md_to_error(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+                                    "Unallowed duplicate metadata"),
+                                md));
+  }
+  s->initial_metadata_buffer.size = new_size;
+  batch->Set(Which(), Which::Parse(GRPC_MDVALUE(md)));
+  GRPC_MDELEM_UNREF(md);
+  return GRPC_ERROR_NONE;
+}
+
 static grpc_error_handle on_initial_header(void* tp, grpc_mdelem md) {
   GPR_TIMER_SCOPE("on_initial_header", 0);
 
@@ -513,6 +534,12 @@ static grpc_error_handle on_initial_header(void* tp, grpc_mdelem md) {
   if (GPR_UNLIKELY(new_size > metadata_size_limit)) {
     return handle_metadata_size_limit_exceeded(t, s, md, new_size,
                                                metadata_size_limit);
+  } else if (md_key_cmp(md, GRPC_MDSTR_TE)) {
+    return handle_known_initial_header<grpc_core::TeMetadata>(t, s, md,
+                                                              new_size);
+  } else if (md_key_cmp(md, GRPC_MDSTR_CONTENT_TYPE)) {
+    return handle_known_initial_header<grpc_core::ContentTypeMetadata>(
+        t, s, md, new_size);
   } else {
     grpc_error_handle error = grpc_chttp2_incoming_metadata_buffer_add(
         &s->initial_metadata_buffer, md);
@@ -25,6 +25,74 @@
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 
+static constexpr uint32_t kEmptySlot = UINT32_MAX;
+
+/* the index has a power of two number of slots, at least twice the capacity
+   of the arrays it covers */
+static size_t index_size_for(size_t capacity) {
+  size_t size = 1;
+  while (size < 2 * capacity) size <<= 1;
+  return size;
+}
+
+static void alloc_index(grpc_chttp2_stream_map* map) {
+  size_t size = index_size_for(map->capacity);
+  map->index = static_cast<grpc_chttp2_stream_map_slot*>(
+      gpr_malloc(sizeof(grpc_chttp2_stream_map_slot) * size));
+  map->index_mask = size - 1;
+  memset(map->index, 0xff, sizeof(grpc_chttp2_stream_map_slot) * size);
+}
+
+/* Stream ids advance in steps of two, so spread them with a multiplicative
+   hash and take the top bits (scaled to the index size). */
+static size_t home_slot(grpc_chttp2_stream_map* map, uint32_t key) {
+  uint32_t hash = key * 0x9e3779b9u;
+  return static_cast<size_t>((static_cast<uint64_t>(hash) *
+                              (map->index_mask + 1)) >>
+                             32);
+}
+
+static void index_insert(grpc_chttp2_stream_map* map, uint32_t key,
+                         uint32_t pos) {
+  size_t i = home_slot(map, key);
+  while (map->index[i].pos != kEmptySlot) {
+    i = (i + 1) & map->index_mask;
+  }
+  map->index[i].key = key;
+  map->index[i].pos = pos;
+}
+
+static grpc_chttp2_stream_map_slot* index_find(grpc_chttp2_stream_map* map,
+                                               uint32_t key) {
+  size_t i = home_slot(map, key);
+  for (;;) {
+    grpc_chttp2_stream_map_slot* slot = &map->index[i];
+    if (slot->pos == kEmptySlot) return nullptr;
+    if (slot->key == key) return slot;
+    i = (i + 1) & map->index_mask;
+  }
+}
+
+static void rebuild_index(grpc_chttp2_stream_map* map) {
+  memset(map->index, 0xff,
+         sizeof(grpc_chttp2_stream_map_slot) * (map->index_mask + 1));
+  for (size_t i = 0; i < map->count; i++) {
+    index_insert(map, map->keys[i], static_cast<uint32_t>(i));
+  }
+}
+
+/* Empty the index without touching every slot. Entries enter the index in
+   the same order as they enter the arrays, and an entry's probe sequence only
+   crosses slots taken by earlier entries, so removing entries newest first
+   never breaks the probe sequence of one still to be removed. */
+static void clear_index(grpc_chttp2_stream_map* map) {
+  for (size_t i = map->count; i > 0; i--) {
+    grpc_chttp2_stream_map_slot* slot = index_find(map, map->keys[i - 1]);
+    GPR_DEBUG_ASSERT(slot != nullptr && slot->pos == i - 1);
+    slot->pos = kEmptySlot;
+  }
+}
+
 void grpc_chttp2_stream_map_init(grpc_chttp2_stream_map* map,
                                  size_t initial_capacity) {
   GPR_DEBUG_ASSERT(initial_capacity > 1);
@@ -35,11 +103,13 @@ void grpc_chttp2_stream_map_init(grpc_chttp2_stream_map* map,
   map->count = 0;
   map->free = 0;
   map->capacity = initial_capacity;
+  alloc_index(map);
 }
 
 void grpc_chttp2_stream_map_destroy(grpc_chttp2_stream_map* map) {
   gpr_free(map->keys);
   gpr_free(map->values);
+  gpr_free(map->index);
 }
 
 static size_t compact(uint32_t* keys, void** values, size_t count) {
@@ -77,7 +147,7 @@ void grpc_chttp2_stream_map_add(grpc_chttp2_stream_map* map, uint32_t key,
 
   if (count == capacity) {
     if (map->free > capacity / 4) {
-      count = compact(keys, values, count);
+      map->count = count = compact(keys, values, count);
       map->free = 0;
     } else {
       /* resize when less than 25% of the table is free, because compaction
@@ -87,40 +157,26 @@ void grpc_chttp2_stream_map_add(grpc_chttp2_stream_map* map, uint32_t key,
           gpr_realloc(keys, capacity * sizeof(uint32_t)));
       map->values = values =
           static_cast<void**>(gpr_realloc(values, capacity * sizeof(void*)));
+      gpr_free(map->index);
+      alloc_index(map);
     }
+    /* positions moved or the index grew: either way, rebuild it */
+    rebuild_index(map);
   }
 
   keys[count] = key;
   values[count] = value;
+  index_insert(map, key, static_cast<uint32_t>(count));
   map->count = count + 1;
 }
 
 template <bool strict_find>
 static void** find(grpc_chttp2_stream_map* map, uint32_t key) {
-  size_t min_idx = 0;
-  size_t max_idx = map->count;
-  size_t mid_idx;
-  uint32_t* keys = map->keys;
-  void** values = map->values;
-  uint32_t mid_key;
-
-  GPR_DEBUG_ASSERT(!strict_find || max_idx > 0);
-  if (!strict_find && max_idx == 0) return nullptr;
-
-  while (min_idx < max_idx) {
-    /* find the midpoint, avoiding overflow */
-    mid_idx = min_idx + ((max_idx - min_idx) / 2);
-    mid_key = keys[mid_idx];
-
-    if (mid_key < key) {
-      min_idx = mid_idx + 1;
-    } else if (mid_key > key) {
-      max_idx = mid_idx;
-    } else /* mid_key == key */
-    {
-      return &values[mid_idx];
-    }
-  }
+  GPR_DEBUG_ASSERT(!strict_find || map->count > 0);
+  if (!strict_find && map->count == 0) return nullptr;
+
+  grpc_chttp2_stream_map_slot* slot = index_find(map, key);
+  if (slot != nullptr) return &map->values[slot->pos];
 
   GPR_DEBUG_ASSERT(!strict_find);
   return nullptr;
@@ -136,6 +192,7 @@ void* grpc_chttp2_stream_map_delete(grpc_chttp2_stream_map* map, uint32_t key) {
   /* recognize complete emptyness and ensure we can skip
      defragmentation later */
   if (map->free == map->count) {
+    clear_index(map);
     map->free = map->count = 0;
   }
   GPR_DEBUG_ASSERT(grpc_chttp2_stream_map_find(map, key) == nullptr);
@@ -158,6 +215,7 @@ void* grpc_chttp2_stream_map_rand(grpc_chttp2_stream_map* map) {
   if (map->free != 0) {
     map->count = compact(map->keys, map->values, map->count);
     map->free = 0;
+    rebuild_index(map);
     GPR_ASSERT(map->count > 0);
   }
   return map->values[(static_cast<size_t>(rand())) % map->count];
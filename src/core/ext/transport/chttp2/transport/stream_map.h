@@ -22,19 +22,33 @@
 #include <grpc/support/port_platform.h>
 
 #include <stddef.h>
+#include <stdint.h>
 
 /* Data structure to map a uint32_t to a data object (represented by a void*)
 
-   Represented as a sorted array of keys, and a corresponding array of values.
-   Lookups are performed with binary search.
-   Adds are restricted to strictly higher keys than previously seen (this is
-   guaranteed by http2). */
+   Represented as an array of keys, and a corresponding array of values, kept
+   in insertion order. Adds are restricted to strictly higher keys than
+   previously seen (this is guaranteed by http2), so the arrays are also sorted
+   and iteration visits streams in id order. Deletes only clear the value;
+   the arrays are compacted lazily by a later add.
+
+   Lookups go through an open-addressed hash index over the arrays, so they
+   take O(1) regardless of how many streams are open. */
+struct grpc_chttp2_stream_map_slot {
+  uint32_t key;
+  /* index into keys/values, or UINT32_MAX for an empty slot */
+  uint32_t pos;
+};
 struct grpc_chttp2_stream_map {
   uint32_t* keys;
   void** values;
   size_t count;
   size_t free;
   size_t capacity;
+  /* linear-probing index: one slot per entry in keys[0..count), including
+     deleted ones, at most half full */
+  grpc_chttp2_stream_map_slot* index;
+  size_t index_mask;
 };
 void grpc_chttp2_stream_map_init(grpc_chttp2_stream_map* map,
                                  size_t initial_capacity);
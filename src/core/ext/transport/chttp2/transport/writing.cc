@@ -188,8 +188,8 @@ static void report_stall(grpc_chttp2_transport* t, grpc_chttp2_stream* s,
 }
 
 /* How many bytes would we like to put on the wire during a single syscall */
-static uint32_t target_write_size(grpc_chttp2_transport* /*t*/) {
-  return 1024 * 1024;
+static uint32_t target_write_size(grpc_chttp2_transport* t) {
+  return t->target_write_size;
 }
 
 // Returns true if initial_metadata contains only default headers.
@@ -324,7 +324,8 @@ class DataSendContext {
       : write_context_(write_context),
         t_(t),
         s_(s),
-        sending_bytes_before_(s_->sending_bytes) {}
+        sending_bytes_before_(s_->sending_bytes),
+        write_budget_(WriteBudget(t, s)) {}
 
   uint32_t stream_remote_window() const {
     return static_cast<uint32_t>(std::max(
@@ -337,7 +338,9 @@ class DataSendContext {
 
   uint32_t max_outgoing() const {
     return static_cast<uint32_t>(std::min(
-        t_->settings[GRPC_PEER_SETTINGS][GRPC_CHTTP2_SETTINGS_MAX_FRAME_SIZE],
+        std::min(t_->settings[GRPC_PEER_SETTINGS]
+                             [GRPC_CHTTP2_SETTINGS_MAX_FRAME_SIZE],
+                 write_budget_),
         static_cast<uint32_t>(std::min(int64_t(stream_remote_window()),
                                        t_->flow_control->remote_window()))));
   }
@@ -355,6 +358,7 @@ class DataSendContext {
                             is_last_frame_, &s_->stats.outgoing, &t_->outbuf);
     s_->flow_control->SentData(send_bytes);
     s_->sending_bytes += send_bytes;
+    write_budget_ -= send_bytes;
   }
 
   void FlushCompressedBytes() {
@@ -389,6 +393,7 @@ class DataSendContext {
     grpc_chttp2_encode_data(s_->id, &s_->compressed_data_buffer, send_bytes,
                             is_last_frame_, &s_->stats.outgoing, &t_->outbuf);
     s_->flow_control->SentData(send_bytes);
+    write_budget_ -= send_bytes;
     if (s_->compressed_data_buffer.length == 0) {
       s_->sending_bytes += s_->uncompressed_data_size;
     }
@@ -424,10 +429,22 @@ class DataSendContext {
   }
 
  private:
+  // How many bytes of data the stream may write before it goes to the back of
+  // the writable list, so that streams with data to send take turns in
+  // proportion to their weights rather than the first one filling the write.
+  static uint32_t WriteBudget(grpc_chttp2_transport* t, grpc_chttp2_stream* s) {
+    if (t->stream_write_quantum == 0) return UINT32_MAX;
+    uint64_t budget = uint64_t(t->stream_write_quantum) * s->write_weight /
+                      GRPC_CHTTP2_DEFAULT_STREAM_WEIGHT;
+    return static_cast<uint32_t>(
+        std::max(uint64_t(1), std::min(budget, uint64_t(UINT32_MAX))));
+  }
+
   WriteContext* write_context_;
   grpc_chttp2_transport* t_;
   grpc_chttp2_stream* s_;
   const size_t sending_bytes_before_;
+  uint32_t write_budget_;
   bool is_last_frame_ = false;
 };
 
@@ -610,12 +627,11 @@ class StreamWriteContext {
           [num_extra_headers_for_trailing_metadata_++] =
               &s_->send_initial_metadata->legacy_index()->named.status->md;
     }
-    if (s_->send_initial_metadata->legacy_index()->named.content_type !=
-        nullptr) {
+    if (s_->send_initial_metadata->get(grpc_core::ContentTypeMetadata()) ==
+        grpc_core::ContentTypeMetadata::kApplicationGrpc) {
+      content_type_ = GRPC_MDELEM_CONTENT_TYPE_APPLICATION_SLASH_GRPC;
       extra_headers_for_trailing_metadata_
-          [num_extra_headers_for_trailing_metadata_++] =
-              &s_->send_initial_metadata->legacy_index()
-                   ->named.content_type->md;
+          [num_extra_headers_for_trailing_metadata_++] = &content_type_;
     }
   }
 
@@ -642,6 +658,7 @@ class StreamWriteContext {
   grpc_chttp2_stream* const s_;
   bool stream_became_writable_ = false;
   grpc_mdelem* extra_headers_for_trailing_metadata_[2];
+  grpc_mdelem content_type_;
   size_t num_extra_headers_for_trailing_metadata_ = 0;
 };
 }  // namespace
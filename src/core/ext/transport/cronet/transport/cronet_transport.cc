@@ -771,6 +771,19 @@ static void convert_metadata_to_cronet_headers(
 
     num_headers++;
   }
+  if (metadata->get(grpc_core::TeMetadata()) ==
+      grpc_core::TeMetadata::kTrailers) {
+    headers[num_headers].key = grpc_slice_to_c_string(GRPC_MDSTR_TE);
+    headers[num_headers].value = grpc_slice_to_c_string(GRPC_MDSTR_TRAILERS);
+    num_headers++;
+  }
+  if (metadata->get(grpc_core::ContentTypeMetadata()) ==
+      grpc_core::ContentTypeMetadata::kApplicationGrpc) {
+    headers[num_headers].key = grpc_slice_to_c_string(GRPC_MDSTR_CONTENT_TYPE);
+    headers[num_headers].value =
+        grpc_slice_to_c_string(GRPC_MDSTR_APPLICATION_SLASH_GRPC);
+    num_headers++;
+  }
 
   *p_num_headers = num_headers;
 }
@@ -0,0 +1,269 @@
+//
+//
+// Copyright 2021 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/ext/xds/xds_route_table.h"
+
+#include <stdlib.h>
+
+#include <algorithm>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/ascii.h"
+#include "absl/strings/match.h"
+
+#include "src/core/lib/gpr/murmur_hash.h"
+
+namespace grpc_core {
+
+namespace {
+
+// Bounds the memory used by the per-path cache.  Clients normally call a
+// small set of methods, so this is only reached with unusual paths.
+constexpr size_t kMaxCachedPaths = 1000;
+// Keeps the cache at most half full, so that probe sequences stay short.
+constexpr size_t kPathCacheSlots = 2 * kMaxCachedPaths;
+
+bool UnderFraction(const uint32_t fraction_per_million) {
+  // Generate a random number in [0, 1000000).
+  const uint32_t random_number = rand() % 1000000;
+  return random_number < fraction_per_million;
+}
+
+bool HasOnlyPathMatcher(const XdsApi::Route::Matchers& matchers) {
+  return matchers.header_matchers.empty() &&
+         !matchers.fraction_per_million.has_value();
+}
+
+}  // namespace
+
+//
+// XdsRouteTable::PathTrie
+//
+
+XdsRouteTable::PathTrie::PathTrie() : nodes_(1) {}
+
+void XdsRouteTable::PathTrie::Insert(absl::string_view key, bool is_prefix,
+                                     size_t route) {
+  size_t node = 0;
+  for (char c : key) {
+    auto it = nodes_[node].children.find(c);
+    if (it != nodes_[node].children.end()) {
+      node = it->second;
+      continue;
+    }
+    // Nodes are referred to by index, since emplace_back() may reallocate.
+    nodes_.emplace_back();
+    nodes_[node].children.emplace(c, nodes_.size() - 1);
+    node = nodes_.size() - 1;
+  }
+  if (is_prefix) {
+    nodes_[node].prefix_routes.push_back(route);
+  } else {
+    nodes_[node].exact_routes.push_back(route);
+  }
+}
+
+void XdsRouteTable::PathTrie::Match(absl::string_view path,
+                                    std::vector<size_t>* routes) const {
+  size_t node = 0;
+  for (size_t i = 0;; ++i) {
+    const Node& current = nodes_[node];
+    routes->insert(routes->end(), current.prefix_routes.begin(),
+                   current.prefix_routes.end());
+    if (i == path.size()) {
+      routes->insert(routes->end(), current.exact_routes.begin(),
+                     current.exact_routes.end());
+      return;
+    }
+    auto it = current.children.find(path[i]);
+    if (it == current.children.end()) return;
+    node = it->second;
+  }
+}
+
+//
+// XdsRouteTable
+//
+
+XdsRouteTable::XdsRouteTable(
+    std::vector<const XdsApi::Route::Matchers*> routes)
+    : routes_(std::move(routes)), path_cache_(kPathCacheSlots) {
+  std::vector<size_t> regex_routes;
+  for (size_t i = 0; i < routes_.size(); ++i) {
+    const StringMatcher& path_matcher = routes_[i]->path_matcher;
+    switch (path_matcher.type()) {
+      case StringMatcher::Type::kExact:
+      case StringMatcher::Type::kPrefix: {
+        const bool is_prefix =
+            path_matcher.type() == StringMatcher::Type::kPrefix;
+        if (path_matcher.case_sensitive()) {
+          case_sensitive_trie_.Insert(path_matcher.string_matcher(), is_prefix,
+                                      i);
+        } else {
+          case_insensitive_trie_.Insert(
+              absl::AsciiStrToLower(path_matcher.string_matcher()), is_prefix,
+              i);
+        }
+        break;
+      }
+      case StringMatcher::Type::kSafeRegex:
+        regex_routes.push_back(i);
+        break;
+      default:
+        other_routes_.push_back(i);
+    }
+  }
+  if (regex_routes.empty()) return;
+  // StringMatcher uses RE2::FullMatch() with default options.
+  auto regex_set =
+      absl::make_unique<RE2::Set>(RE2::Options(), RE2::ANCHOR_BOTH);
+  bool ok = true;
+  for (size_t route : regex_routes) {
+    if (regex_set->Add(routes_[route]->path_matcher.regex_matcher()->pattern(),
+                       nullptr) < 0) {
+      ok = false;
+      break;
+    }
+  }
+  if (ok && regex_set->Compile()) {
+    regex_set_ = std::move(regex_set);
+    regex_set_routes_ = std::move(regex_routes);
+  } else {
+    other_routes_.insert(other_routes_.end(), regex_routes.begin(),
+                         regex_routes.end());
+  }
+}
+
+XdsRouteTable::~XdsRouteTable() {
+  for (auto& slot : path_cache_) {
+    delete slot.load(std::memory_order_relaxed);
+  }
+}
+
+absl::optional<size_t> XdsRouteTable::GetRouteForRequest(
+    absl::string_view path, grpc_metadata_batch* initial_metadata) {
+  size_t slot;
+  const CachedPath* cached = FindCachedPath(path, &slot);
+  const std::vector<size_t>* routes;
+  std::vector<size_t> uncached_routes;
+  if (cached != nullptr) {
+    routes = &cached->routes;
+  } else {
+    uncached_routes = MatchPath(path);
+    routes = &uncached_routes;
+    MutexLock lock(&mu_);
+    if (num_cached_paths_ < kMaxCachedPaths) {
+      // Another call may have added the path, or taken the slot, in the
+      // meantime.
+      cached = FindCachedPath(path, &slot);
+      if (cached == nullptr) {
+        cached = new CachedPath{std::string(path), std::move(uncached_routes)};
+        path_cache_[slot].store(cached, std::memory_order_release);
+        ++num_cached_paths_;
+      }
+      routes = &cached->routes;
+    }
+  }
+  for (size_t route : *routes) {
+    if (MatchesHeadersAndFraction(route, initial_metadata)) return route;
+  }
+  return absl::nullopt;
+}
+
+const XdsRouteTable::CachedPath* XdsRouteTable::FindCachedPath(
+    absl::string_view path, size_t* slot) const {
+  size_t i =
+      gpr_murmur_hash3(path.data(), path.size(), 0) % path_cache_.size();
+  // The cache is never full, so probing ends at an empty slot.
+  while (true) {
+    const CachedPath* cached = path_cache_[i].load(std::memory_order_acquire);
+    if (cached == nullptr || cached->path == path) {
+      *slot = i;
+      return cached;
+    }
+    i = (i + 1) % path_cache_.size();
+  }
+}
+
+std::vector<size_t> XdsRouteTable::MatchPath(absl::string_view path) const {
+  std::vector<size_t> routes;
+  case_sensitive_trie_.Match(path, &routes);
+  if (!case_insensitive_trie_.empty()) {
+    case_insensitive_trie_.Match(absl::AsciiStrToLower(path), &routes);
+  }
+  if (regex_set_ != nullptr) {
+    std::vector<int> matches;
+    RE2::Set::ErrorInfo error_info;
+    if (regex_set_->Match(re2::StringPiece(path.data(), path.size()),
+                          &matches, &error_info)) {
+      for (int match : matches) {
+        routes.push_back(regex_set_routes_[match]);
+      }
+    } else if (error_info.kind != RE2::Set::kNoError) {
+      // The set could not be evaluated, e.g. because the DFA ran out of
+      // memory; match the regexes one by one instead.
+      for (size_t route : regex_set_routes_) {
+        if (routes_[route]->path_matcher.Match(path)) routes.push_back(route);
+      }
+    }
+  }
+  for (size_t route : other_routes_) {
+    if (routes_[route]->path_matcher.Match(path)) routes.push_back(route);
+  }
+  std::sort(routes.begin(), routes.end());
+  // Routes after one that matches on the path alone are never selected.
+  for (size_t i = 0; i < routes.size(); ++i) {
+    if (HasOnlyPathMatcher(*routes_[routes[i]])) {
+      routes.resize(i + 1);
+      break;
+    }
+  }
+  return routes;
+}
+
+bool XdsRouteTable::MatchesHeadersAndFraction(
+    size_t route, grpc_metadata_batch* initial_metadata) const {
+  const XdsApi::Route::Matchers& matchers = *routes_[route];
+  for (const auto& header_matcher : matchers.header_matchers) {
+    std::string concatenated_value;
+    if (!header_matcher.Match(GetHeaderValue(
+            initial_metadata, header_matcher.name(), &concatenated_value))) {
+      return false;
+    }
+  }
+  return !matchers.fraction_per_million.has_value() ||
+         UnderFraction(matchers.fraction_per_million.value());
+}
+
+absl::optional<absl::string_view> XdsRouteTable::GetHeaderValue(
+    grpc_metadata_batch* initial_metadata, absl::string_view header_name,
+    std::string* concatenated_value) {
+  // Note: If we ever allow binary headers here, we still need to
+  // special-case ignore "grpc-tags-bin" and "grpc-trace-bin", since
+  // they are not visible to the LB policy in grpc-go.
+  if (absl::EndsWith(header_name, "-bin")) {
+    return absl::nullopt;
+  } else if (header_name == "content-type") {
+    return "application/grpc";
+  }
+  return initial_metadata->GetValue(header_name, concatenated_value);
+}
+
+}  // namespace grpc_core
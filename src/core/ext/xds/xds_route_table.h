@@ -0,0 +1,126 @@
+//
+//
+// Copyright 2021 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+#ifndef GRPC_CORE_EXT_XDS_XDS_ROUTE_TABLE_H
+#define GRPC_CORE_EXT_XDS_XDS_ROUTE_TABLE_H
+
+#include <grpc/support/port_platform.h>
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+#include "re2/set.h"
+
+#include "src/core/ext/xds/xds_api.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/transport/metadata_batch.h"
+
+namespace grpc_core {
+
+// Selects the xDS route for a request.
+//
+// Path matchers are compiled when the table is built: exact and prefix
+// matchers go into tries and regex matchers into a single RE2::Set.  The
+// routes whose path matcher accepts a given path are cached per path, so
+// that a call to a method seen before only evaluates the header matchers and
+// runtime fractions of those routes.
+class XdsRouteTable {
+ public:
+  // The matchers must outlive the table.  routes[i] is the matchers of the
+  // route with index i; the first route that matches a request wins.
+  explicit XdsRouteTable(std::vector<const XdsApi::Route::Matchers*> routes);
+  ~XdsRouteTable();
+
+  XdsRouteTable(const XdsRouteTable&) = delete;
+  XdsRouteTable& operator=(const XdsRouteTable&) = delete;
+
+  // Returns the index of the first route matching the request, or
+  // absl::nullopt if no route matches.  Thread-safe.
+  absl::optional<size_t> GetRouteForRequest(
+      absl::string_view path, grpc_metadata_batch* initial_metadata);
+
+  // Returns the value of header_name in initial_metadata as seen by xDS
+  // header matchers and hash policies.  concatenated_value is used as
+  // storage when the header has several values.
+  static absl::optional<absl::string_view> GetHeaderValue(
+      grpc_metadata_batch* initial_metadata, absl::string_view header_name,
+      std::string* concatenated_value);
+
+ private:
+  // Trie over the strings of exact and prefix path matchers.
+  class PathTrie {
+   public:
+    PathTrie();
+
+    void Insert(absl::string_view key, bool is_prefix, size_t route);
+    // Appends the routes whose matcher accepts path to routes.
+    void Match(absl::string_view path, std::vector<size_t>* routes) const;
+    bool empty() const { return nodes_.size() == 1; }
+
+   private:
+    struct Node {
+      std::map<char, size_t> children;
+      std::vector<size_t> exact_routes;
+      std::vector<size_t> prefix_routes;
+    };
+
+    // nodes_[0] is the root, which holds the routes for the empty string.
+    std::vector<Node> nodes_;
+  };
+
+  struct CachedPath {
+    std::string path;
+    std::vector<size_t> routes;
+  };
+
+  // Returns the cache entry for path, or null if path is not cached; slot is
+  // set to the index of the entry, or of the empty slot where path would go.
+  const CachedPath* FindCachedPath(absl::string_view path, size_t* slot) const;
+  // Returns the routes whose path matcher accepts path, in order, up to and
+  // including the first one that has no other matchers.
+  std::vector<size_t> MatchPath(absl::string_view path) const;
+  bool MatchesHeadersAndFraction(size_t route,
+                                 grpc_metadata_batch* initial_metadata) const;
+
+  std::vector<const XdsApi::Route::Matchers*> routes_;
+  PathTrie case_sensitive_trie_;
+  // Keys are lower-cased.
+  PathTrie case_insensitive_trie_;
+  std::unique_ptr<RE2::Set> regex_set_;
+  // Route index of each pattern in regex_set_.
+  std::vector<size_t> regex_set_routes_;
+  // Routes whose path matcher is evaluated on its own: suffix and contains
+  // matchers, and regex matchers if regex_set_ could not be built.
+  std::vector<size_t> other_routes_;
+
+  // Open-addressed hash table with linear probing. Slots are only ever set
+  // once, from null to an entry, under mu_, so cache hits read them without
+  // taking the lock. Entries are freed with the table.
+  std::vector<std::atomic<const CachedPath*>> path_cache_;
+  Mutex mu_;
+  size_t num_cached_paths_ ABSL_GUARDED_BY(mu_) = 0;
+};
+
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_EXT_XDS_XDS_ROUTE_TABLE_H
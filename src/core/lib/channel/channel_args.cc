@@ -23,6 +23,7 @@
 #include <limits.h>
 #include <string.h>
 
+#include <atomic>
 #include <vector>
 
 #include "absl/strings/str_format.h"
@@ -35,8 +36,11 @@
 #include <grpc/support/log.h>
 #include <grpc/support/string_util.h>
 
+#include "src/core/lib/avl/avl.h"
+#include "src/core/lib/gpr/murmur_hash.h"
 #include "src/core/lib/gpr/string.h"
 #include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/gprpp/ref_counted.h"
 
 static grpc_arg copy_arg(const grpc_arg* src) {
   grpc_arg dst;
@@ -202,21 +206,25 @@ grpc_channel_args* grpc_channel_args_normalize(const grpc_channel_args* src) {
   return b;
 }
 
+static void destroy_arg(grpc_arg* arg) {
+  switch (arg->type) {
+    case GRPC_ARG_STRING:
+      gpr_free(arg->value.string);
+      break;
+    case GRPC_ARG_INTEGER:
+      break;
+    case GRPC_ARG_POINTER:
+      arg->value.pointer.vtable->destroy(arg->value.pointer.p);
+      break;
+  }
+  gpr_free(arg->key);
+}
+
 void grpc_channel_args_destroy(grpc_channel_args* a) {
   size_t i;
   if (!a) return;
   for (i = 0; i < a->num_args; i++) {
-    switch (a->args[i].type) {
-      case GRPC_ARG_STRING:
-        gpr_free(a->args[i].value.string);
-        break;
-      case GRPC_ARG_INTEGER:
-        break;
-      case GRPC_ARG_POINTER:
-        a->args[i].value.pointer.vtable->destroy(a->args[i].value.pointer.p);
-        break;
-    }
-    gpr_free(a->args[i].key);
+    destroy_arg(&a->args[i]);
   }
   gpr_free(a->args);
   gpr_free(a);
@@ -381,3 +389,221 @@ grpc_channel_args_client_channel_creation_mutator
 grpc_channel_args_get_client_channel_creation_mutator() {
   return g_mutator;
 }
+
+namespace grpc_core {
+
+namespace {
+
+// An arg in a ChannelArgs tree, shared by every tree node that holds it.
+class ChannelArgsEntry
+    : public RefCounted<ChannelArgsEntry, NonPolymorphicRefCount> {
+ public:
+  explicit ChannelArgsEntry(const grpc_arg& arg) : arg_(copy_arg(&arg)) {
+    hash_ = gpr_murmur_hash3(arg_.key, strlen(arg_.key), arg_.type);
+    switch (arg_.type) {
+      case GRPC_ARG_STRING:
+        hash_ = gpr_murmur_hash3(arg_.value.string, strlen(arg_.value.string),
+                                 hash_);
+        break;
+      case GRPC_ARG_INTEGER:
+        hash_ = gpr_murmur_hash3(&arg_.value.integer,
+                                 sizeof(arg_.value.integer), hash_);
+        break;
+      case GRPC_ARG_POINTER:
+        // Pointers that differ may still compare equal through the vtable, so
+        // only the vtable is hashed.
+        hash_ = gpr_murmur_hash3(&arg_.value.pointer.vtable,
+                                 sizeof(arg_.value.pointer.vtable), hash_);
+        break;
+    }
+  }
+  ~ChannelArgsEntry() { destroy_arg(&arg_); }
+
+  const grpc_arg& arg() const { return arg_; }
+  uint32_t hash() const { return hash_; }
+
+ private:
+  grpc_arg arg_;
+  uint32_t hash_;
+};
+
+// Tree keys are the keys of the entries that are the values of the same nodes,
+// which keep them alive.
+void destroy_entry_key(void* /*key*/, void* /*user_data*/) {}
+void* copy_entry_key(void* key, void* /*user_data*/) { return key; }
+long compare_entry_keys(void* key1, void* key2, void* /*user_data*/) {
+  return strcmp(static_cast<const char*>(key1), static_cast<const char*>(key2));
+}
+void destroy_entry(void* value, void* /*user_data*/) {
+  static_cast<ChannelArgsEntry*>(value)->Unref();
+}
+void* copy_entry(void* value, void* /*user_data*/) {
+  return static_cast<ChannelArgsEntry*>(value)->Ref().release();
+}
+
+const grpc_avl_vtable entry_avl_vtable = {destroy_entry_key, copy_entry_key,
+                                          compare_entry_keys, destroy_entry,
+                                          copy_entry};
+
+ChannelArgsEntry* avl_get_entry(grpc_avl avl, const char* name) {
+  return static_cast<ChannelArgsEntry*>(
+      grpc_avl_get(avl, const_cast<char*>(name), nullptr));
+}
+
+// Adds a new entry for \a arg to \a avl, which it unrefs.
+grpc_avl avl_add_entry(grpc_avl avl, const grpc_arg& arg,
+                       ChannelArgsEntry** entry) {
+  *entry = new ChannelArgsEntry(arg);
+  return grpc_avl_add(avl, (*entry)->arg().key, *entry, nullptr);
+}
+
+void append_entries(const grpc_avl_node* node, grpc_arg* args, size_t* n) {
+  if (node == nullptr) return;
+  append_entries(node->left, args, n);
+  args[(*n)++] = static_cast<const ChannelArgsEntry*>(node->value)->arg();
+  append_entries(node->right, args, n);
+}
+
+}  // namespace
+
+class ChannelArgs::Rep : public RefCounted<Rep, NonPolymorphicRefCount> {
+ public:
+  Rep(grpc_avl avl, size_t size, uint32_t hash)
+      : avl_(avl), size_(size), hash_(hash) {}
+  ~Rep() {
+    grpc_channel_args* c_args = c_args_.load(std::memory_order_relaxed);
+    if (c_args != nullptr) {
+      // The args themselves belong to the entries.
+      gpr_free(c_args->args);
+      gpr_free(c_args);
+    }
+    grpc_avl_unref(avl_, nullptr);
+  }
+
+  grpc_avl avl() const { return avl_; }
+  size_t size() const { return size_; }
+  uint32_t hash() const { return hash_; }
+
+  const grpc_channel_args* ToC() {
+    grpc_channel_args* c_args = c_args_.load(std::memory_order_acquire);
+    if (c_args != nullptr) return c_args;
+    c_args =
+        static_cast<grpc_channel_args*>(gpr_malloc(sizeof(grpc_channel_args)));
+    c_args->num_args = 0;
+    c_args->args = static_cast<grpc_arg*>(gpr_malloc(sizeof(grpc_arg) * size_));
+    append_entries(avl_.root, c_args->args, &c_args->num_args);
+    GPR_ASSERT(c_args->num_args == size_);
+    grpc_channel_args* expected = nullptr;
+    if (!c_args_.compare_exchange_strong(expected, c_args,
+                                         std::memory_order_acq_rel,
+                                         std::memory_order_acquire)) {
+      // Another thread built it first.
+      gpr_free(c_args->args);
+      gpr_free(c_args);
+      c_args = expected;
+    }
+    return c_args;
+  }
+
+ private:
+  const grpc_avl avl_;
+  const size_t size_;
+  // The sum of the hashes of the entries, so that it can be updated as
+  // entries are added and removed.
+  const uint32_t hash_;
+  std::atomic<grpc_channel_args*> c_args_{nullptr};
+};
+
+ChannelArgs::ChannelArgs() = default;
+
+ChannelArgs::ChannelArgs(const grpc_channel_args* args) {
+  if (args == nullptr || args->num_args == 0) return;
+  grpc_avl avl = grpc_avl_create(&entry_avl_vtable);
+  size_t size = 0;
+  uint32_t hash = 0;
+  for (size_t i = 0; i < args->num_args; i++) {
+    if (avl_get_entry(avl, args->args[i].key) != nullptr) continue;
+    ChannelArgsEntry* entry;
+    avl = avl_add_entry(avl, args->args[i], &entry);
+    size++;
+    hash += entry->hash();
+  }
+  rep_ = MakeRefCounted<Rep>(avl, size, hash);
+}
+
+ChannelArgs::ChannelArgs(RefCountedPtr<Rep> rep) : rep_(std::move(rep)) {}
+
+ChannelArgs::~ChannelArgs() = default;
+ChannelArgs::ChannelArgs(const ChannelArgs& other) = default;
+ChannelArgs& ChannelArgs::operator=(const ChannelArgs& other) = default;
+ChannelArgs::ChannelArgs(ChannelArgs&& other) noexcept = default;
+ChannelArgs& ChannelArgs::operator=(ChannelArgs&& other) noexcept = default;
+
+ChannelArgs ChannelArgs::Set(const grpc_arg& arg) const {
+  if (rep_ == nullptr) {
+    ChannelArgsEntry* entry;
+    grpc_avl avl =
+        avl_add_entry(grpc_avl_create(&entry_avl_vtable), arg, &entry);
+    return ChannelArgs(MakeRefCounted<Rep>(avl, 1, entry->hash()));
+  }
+  size_t size = rep_->size();
+  uint32_t hash = rep_->hash();
+  ChannelArgsEntry* old_entry = avl_get_entry(rep_->avl(), arg.key);
+  if (old_entry != nullptr) {
+    size--;
+    hash -= old_entry->hash();
+  }
+  ChannelArgsEntry* entry;
+  grpc_avl avl =
+      avl_add_entry(grpc_avl_ref(rep_->avl(), nullptr), arg, &entry);
+  return ChannelArgs(MakeRefCounted<Rep>(avl, size + 1, hash + entry->hash()));
+}
+
+ChannelArgs ChannelArgs::Remove(const char* name) const {
+  if (rep_ == nullptr) return *this;
+  ChannelArgsEntry* entry = avl_get_entry(rep_->avl(), name);
+  if (entry == nullptr) return *this;
+  if (rep_->size() == 1) return ChannelArgs();
+  uint32_t hash = rep_->hash() - entry->hash();
+  grpc_avl avl = grpc_avl_remove(grpc_avl_ref(rep_->avl(), nullptr),
+                                 const_cast<char*>(name), nullptr);
+  return ChannelArgs(MakeRefCounted<Rep>(avl, rep_->size() - 1, hash));
+}
+
+const grpc_arg* ChannelArgs::Get(const char* name) const {
+  if (rep_ == nullptr) return nullptr;
+  ChannelArgsEntry* entry = avl_get_entry(rep_->avl(), name);
+  return entry == nullptr ? nullptr : &entry->arg();
+}
+
+size_t ChannelArgs::size() const {
+  return rep_ == nullptr ? 0 : rep_->size();
+}
+
+uint32_t ChannelArgs::Hash() const {
+  return rep_ == nullptr ? 0 : rep_->hash();
+}
+
+int ChannelArgs::Compare(const ChannelArgs& other) const {
+  if (rep_ == other.rep_) return 0;
+  int c = QsortCompare(size(), other.size());
+  if (c != 0) return c;
+  c = QsortCompare(Hash(), other.Hash());
+  if (c != 0) return c;
+  const grpc_channel_args* a = ToC();
+  const grpc_channel_args* b = other.ToC();
+  for (size_t i = 0; i < a->num_args; i++) {
+    // Args with the same key string come from the same entry.
+    if (a->args[i].key == b->args[i].key) continue;
+    c = cmp_arg(&a->args[i], &b->args[i]);
+    if (c != 0) return c;
+  }
+  return 0;
+}
+
+const grpc_channel_args* ChannelArgs::ToC() const {
+  static const grpc_channel_args kEmpty = {0, nullptr};
+  return rep_ == nullptr ? &kEmpty : rep_->ToC();
+}
+
+}  // namespace grpc_core
@@ -25,6 +25,7 @@
 
 #include <grpc/grpc.h>
 
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
 #include "src/core/lib/surface/channel_stack_type.h"
 
 // Channel args are intentionally immutable, to avoid the need for locking.
@@ -131,4 +132,60 @@ void grpc_channel_args_set_client_channel_creation_mutator(
 grpc_channel_args_client_channel_creation_mutator
 grpc_channel_args_get_client_channel_creation_mutator();
 
+namespace grpc_core {
+
+// An immutable set of channel args with at most one arg per key, stored in a
+// persistent AVL tree: Set() and Remove() take O(log n) time and share all but
+// O(log n) tree nodes with the set they are called on. Copying a set takes a
+// reference, and each set keeps a hash of its args so that comparing unequal
+// sets is usually O(1).
+class ChannelArgs {
+ public:
+  ChannelArgs();
+  // Of the args in \a args with the same key, only the first is kept, as it is
+  // the one grpc_channel_args_find() returns.
+  explicit ChannelArgs(const grpc_channel_args* args);
+  ~ChannelArgs();
+
+  ChannelArgs(const ChannelArgs& other);
+  ChannelArgs& operator=(const ChannelArgs& other);
+  ChannelArgs(ChannelArgs&& other) noexcept;
+  ChannelArgs& operator=(ChannelArgs&& other) noexcept;
+
+  // Returns a set with \a arg added, replacing any arg with the same key.
+  ChannelArgs Set(const grpc_arg& arg) const;
+  // Returns a set without the arg whose key is \a name.
+  ChannelArgs Remove(const char* name) const;
+  // Returns the arg whose key is \a name, or nullptr if there is none.
+  const grpc_arg* Get(const char* name) const;
+
+  size_t size() const;
+  uint32_t Hash() const;
+
+  // A total order on sets of args: sets with equal args compare equal, like
+  // normalized grpc_channel_args do with grpc_channel_args_compare().
+  int Compare(const ChannelArgs& other) const;
+  bool operator==(const ChannelArgs& other) const {
+    return Compare(other) == 0;
+  }
+  bool operator!=(const ChannelArgs& other) const {
+    return Compare(other) != 0;
+  }
+  bool operator<(const ChannelArgs& other) const { return Compare(other) < 0; }
+
+  // Returns the args sorted by key. The result is built on the first call and
+  // stays valid as long as this set or a copy of it exists.
+  const grpc_channel_args* ToC() const;
+
+ private:
+  class Rep;
+
+  explicit ChannelArgs(RefCountedPtr<Rep> rep);
+
+  // Null when the set is empty.
+  RefCountedPtr<Rep> rep_;
+};
+
+}  // namespace grpc_core
+
 #endif /* GRPC_CORE_LIB_CHANNEL_CHANNEL_ARGS_H */
@@ -34,6 +34,8 @@ const char* grpc_stats_counter_name[GRPC_STATS_COUNTER_COUNT] = {
     "client_subchannels_created",
     "server_channels_created",
     "syscall_poll",
+    "busy_poll_spins",
+    "busy_poll_hits",
     "syscall_wait",
     "pollset_kick",
     "pollset_kicked_without_poller",
@@ -48,6 +50,8 @@ const char* grpc_stats_counter_name[GRPC_STATS_COUNTER_COUNT] = {
     "syscall_read",
     "tcp_backup_pollers_created",
     "tcp_backup_poller_polls",
+    "tcp_rx_zerocopy_hits",
+    "tcp_rx_zerocopy_fallbacks",
     "http2_op_batches",
     "http2_op_cancel",
     "http2_op_send_initial_metadata",
@@ -62,6 +66,7 @@ const char* grpc_stats_counter_name[GRPC_STATS_COUNTER_COUNT] = {
     "http2_writes_offloaded",
     "http2_writes_continued",
     "http2_partial_writes",
+    "http2_writes_coalesced",
     "http2_initiate_write_due_to_initial_write",
     "http2_initiate_write_due_to_start_new_stream",
     "http2_initiate_write_due_to_send_message",
@@ -134,6 +139,10 @@ const char* grpc_stats_counter_doc[GRPC_STATS_COUNTER_COUNT] = {
     "Number of client subchannels created",
     "Number of server channels created",
     "Number of polling syscalls (epoll_wait, poll, etc) made by this process",
+    "Number of non-blocking polls made while busy polling before parking the "
+    "poller",
+    "Number of busy polling episodes that found events before the spin budget "
+    "ran out",
     "Number of sleeping syscalls made by this process",
     "How many polling wakeups were performed by the process (only valid for "
     "epoll1 right now)",
@@ -157,6 +166,10 @@ const char* grpc_stats_counter_doc[GRPC_STATS_COUNTER_COUNT] = {
     "Number of read syscalls (or equivalent - eg recvmsg) made by this process",
     "Number of times a backup poller has been created (this can be expensive)",
     "Number of polls performed on the backup poller",
+    "Number of reads served by mapping the kernel's receive pages into slices "
+    "(TCP_ZEROCOPY_RECEIVE)",
+    "Number of reads with enough bytes queued for receive zerocopy that were "
+    "served by copying",
     "Number of batches received by HTTP2 transport",
     "Number of cancelations received by HTTP2 transport",
     "Number of batches containing send initial metadata",
@@ -173,6 +186,8 @@ const char* grpc_stats_counter_doc[GRPC_STATS_COUNTER_COUNT] = {
     "written",
     "Number of HTTP2 writes that were made knowing there was still more data "
     "to be written (we cap maximum write size to syscall_write)",
+    "Number of HTTP2 writes held back so that frames queued shortly after them "
+    "could go out in the same syscall_write",
     "Number of HTTP2 writes initiated due to 'initial_write'",
     "Number of HTTP2 writes initiated due to 'start_new_stream'",
     "Number of HTTP2 writes initiated due to 'send_message'",
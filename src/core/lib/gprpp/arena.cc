@@ -22,29 +22,144 @@
 
 #include <string.h>
 
+#include <algorithm>
+#include <atomic>
 #include <new>
 
 #include <grpc/support/alloc.h>
 #include <grpc/support/atm.h>
+#include <grpc/support/cpu.h>
 #include <grpc/support/log.h>
 #include <grpc/support/sync.h>
 
 #include "src/core/lib/gpr/alloc.h"
+#include "src/core/lib/gprpp/global_config.h"
 #include "src/core/lib/gprpp/memory.h"
 
+GPR_GLOBAL_CONFIG_DEFINE_INT32(
+    grpc_arena_cache_size_kb, 4096,
+    "Maximum total size in KiB of the storage cached for reuse by arenas. 0 "
+    "disables the cache.");
+
 namespace {
 
-void* ArenaStorage(size_t initial_size) {
-  static constexpr size_t base_size =
-      GPR_ROUND_UP_TO_ALIGNMENT_SIZE(sizeof(grpc_core::Arena));
-  initial_size = GPR_ROUND_UP_TO_ALIGNMENT_SIZE(initial_size);
-  size_t alloc_size = base_size + initial_size;
-  static constexpr size_t alignment =
-      (GPR_CACHELINE_SIZE > GPR_MAX_ALIGNMENT &&
-       GPR_CACHELINE_SIZE % GPR_MAX_ALIGNMENT == 0)
-          ? GPR_CACHELINE_SIZE
-          : GPR_MAX_ALIGNMENT;
-  return gpr_malloc_aligned(alloc_size, alignment);
+// Storage of at most 64 KiB is rounded up to a power of two size class, the
+// smallest being 256 bytes, and recycled on the CPU that frees it; larger
+// storage goes straight to malloc.
+constexpr size_t kMinSizeClassShift = 8;
+constexpr size_t kMaxSizeClassShift = 16;
+constexpr size_t kNumSizeClasses = kMaxSizeClassShift - kMinSizeClassShift + 1;
+constexpr size_t kStorageAlignment =
+    (GPR_CACHELINE_SIZE > GPR_MAX_ALIGNMENT &&
+     GPR_CACHELINE_SIZE % GPR_MAX_ALIGNMENT == 0)
+        ? GPR_CACHELINE_SIZE
+        : GPR_MAX_ALIGNMENT;
+
+struct CachedBlock {
+  CachedBlock* next;
+};
+
+struct CacheShard {
+  gpr_spinlock lock = GPR_SPINLOCK_STATIC_INITIALIZER;
+  size_t cached_bytes = 0;
+  CachedBlock* free_blocks[kNumSizeClasses] = {};
+  char padding[GPR_CACHELINE_SIZE];
+};
+
+gpr_once g_cache_once = GPR_ONCE_INIT;
+std::atomic<CacheShard*> g_cache_shards{nullptr};
+size_t g_num_cache_shards;
+// Limit on the bytes cached by each shard.
+size_t g_shard_cache_limit;
+
+void InitCache() {
+  g_num_cache_shards = std::max(1u, gpr_cpu_num_cores());
+  int32_t cache_size_kb = GPR_GLOBAL_CONFIG_GET(grpc_arena_cache_size_kb);
+  if (cache_size_kb < 0) {
+    gpr_log(GPR_ERROR, "Invalid arena cache size %d, disabling the cache",
+            cache_size_kb);
+    cache_size_kb = 0;
+  }
+  g_shard_cache_limit =
+      static_cast<size_t>(cache_size_kb) * 1024 / g_num_cache_shards;
+  g_cache_shards.store(new CacheShard[g_num_cache_shards],
+                       std::memory_order_release);
+}
+
+CacheShard* CacheShards() {
+  CacheShard* shards = g_cache_shards.load(std::memory_order_acquire);
+  if (GPR_UNLIKELY(shards == nullptr)) {
+    gpr_once_init(&g_cache_once, InitCache);
+    shards = g_cache_shards.load(std::memory_order_acquire);
+  }
+  return shards;
+}
+
+CacheShard* CurrentShard(CacheShard* shards) {
+  if (g_num_cache_shards == 1) return shards;
+  return &shards[gpr_cpu_current_cpu() % g_num_cache_shards];
+}
+
+size_t SizeClass(size_t size) {
+  size_t size_class = 0;
+  while ((size_t(1) << (size_class + kMinSizeClassShift)) < size) {
+    size_class++;
+  }
+  return size_class;
+}
+
+// Returns storage of at least *size bytes, and sets *size to its actual size.
+void* AllocStorage(size_t* size) {
+  if (*size > (size_t(1) << kMaxSizeClassShift)) {
+    return gpr_malloc_aligned(*size, kStorageAlignment);
+  }
+  size_t size_class = SizeClass(*size);
+  *size = size_t(1) << (size_class + kMinSizeClassShift);
+  CacheShard* shards = CacheShards();
+  if (g_shard_cache_limit != 0) {
+    CacheShard* shard = CurrentShard(shards);
+    gpr_spinlock_lock(&shard->lock);
+    CachedBlock* block = shard->free_blocks[size_class];
+    if (block != nullptr) {
+      shard->free_blocks[size_class] = block->next;
+      shard->cached_bytes -= *size;
+    }
+    gpr_spinlock_unlock(&shard->lock);
+    if (block != nullptr) return block;
+  }
+  return gpr_malloc_aligned(*size, kStorageAlignment);
+}
+
+// Frees storage of \a size bytes returned by AllocStorage().
+void FreeStorage(void* storage, size_t size) {
+  if (size <= (size_t(1) << kMaxSizeClassShift) && g_shard_cache_limit != 0) {
+    size_t size_class = SizeClass(size);
+    CacheShard* shard = CurrentShard(CacheShards());
+    gpr_spinlock_lock(&shard->lock);
+    bool cached = shard->cached_bytes + size <= g_shard_cache_limit;
+    if (cached) {
+      CachedBlock* block = new (storage) CachedBlock();
+      block->next = shard->free_blocks[size_class];
+      shard->free_blocks[size_class] = block;
+      shard->cached_bytes += size;
+    }
+    gpr_spinlock_unlock(&shard->lock);
+    if (cached) return;
+  }
+  gpr_free_aligned(storage);
+}
+
+constexpr size_t kArenaBaseSize =
+    GPR_ROUND_UP_TO_ALIGNMENT_SIZE(sizeof(grpc_core::Arena));
+
+// Returns the storage of an arena whose initial zone holds at least
+// *initial_size bytes, and sets *initial_size to the size of that zone.
+void* ArenaStorage(size_t* initial_size) {
+  size_t alloc_size =
+      kArenaBaseSize + GPR_ROUND_UP_TO_ALIGNMENT_SIZE(*initial_size);
+  void* storage = AllocStorage(&alloc_size);
+  *initial_size = alloc_size - kArenaBaseSize;
+  return storage;
 }
 
 }  // namespace
@@ -55,33 +170,56 @@ Arena::~Arena() {
   Zone* z = last_zone_;
   while (z) {
     Zone* prev_z = z->prev;
+    size_t size = z->size;
     z->~Zone();
-    gpr_free_aligned(z);
+    FreeStorage(z, size);
     z = prev_z;
   }
 }
 
 Arena* Arena::Create(size_t initial_size) {
-  return new (ArenaStorage(initial_size)) Arena(initial_size);
+  void* storage = ArenaStorage(&initial_size);
+  return new (storage) Arena(initial_size);
 }
 
 std::pair<Arena*, void*> Arena::CreateWithAlloc(size_t initial_size,
                                                 size_t alloc_size) {
-  static constexpr size_t base_size =
-      GPR_ROUND_UP_TO_ALIGNMENT_SIZE(sizeof(Arena));
-  auto* new_arena =
-      new (ArenaStorage(initial_size)) Arena(initial_size, alloc_size);
-  void* first_alloc = reinterpret_cast<char*>(new_arena) + base_size;
+  void* storage = ArenaStorage(&initial_size);
+  auto* new_arena = new (storage) Arena(initial_size, alloc_size);
+  void* first_alloc = reinterpret_cast<char*>(new_arena) + kArenaBaseSize;
   return std::make_pair(new_arena, first_alloc);
 }
 
 size_t Arena::Destroy() {
   size_t size = total_used_.load(std::memory_order_relaxed);
+  size_t storage_size = kArenaBaseSize + initial_zone_size_;
   this->~Arena();
-  gpr_free_aligned(this);
+  FreeStorage(this, storage_size);
   return size;
 }
 
+void Arena::TrimCache() {
+  CacheShard* shards = CacheShards();
+  for (size_t i = 0; i < g_num_cache_shards; i++) {
+    CacheShard* shard = &shards[i];
+    CachedBlock* free_blocks[kNumSizeClasses];
+    gpr_spinlock_lock(&shard->lock);
+    for (size_t j = 0; j < kNumSizeClasses; j++) {
+      free_blocks[j] = shard->free_blocks[j];
+      shard->free_blocks[j] = nullptr;
+    }
+    shard->cached_bytes = 0;
+    gpr_spinlock_unlock(&shard->lock);
+    for (CachedBlock* block : free_blocks) {
+      while (block != nullptr) {
+        CachedBlock* next = block->next;
+        gpr_free_aligned(block);
+        block = next;
+      }
+    }
+  }
+}
+
 void* Arena::AllocZone(size_t size) {
   // If the allocation isn't able to end in the initial zone, create a new
   // zone for this allocation, and any unused space in the initial zone is
@@ -91,7 +229,9 @@ void* Arena::AllocZone(size_t size) {
   static constexpr size_t zone_base_size =
       GPR_ROUND_UP_TO_ALIGNMENT_SIZE(sizeof(Zone));
   size_t alloc_size = zone_base_size + size;
-  Zone* z = new (gpr_malloc_aligned(alloc_size, GPR_MAX_ALIGNMENT)) Zone();
+  void* storage = AllocStorage(&alloc_size);
+  Zone* z = new (storage) Zone();
+  z->size = alloc_size;
   {
     gpr_spinlock_lock(&arena_growth_spinlock_);
     z->prev = last_zone_;
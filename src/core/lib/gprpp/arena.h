@@ -21,6 +21,8 @@
 // the arena as a whole is freed
 // Tracks the total memory allocated against it, so that future arenas can
 // pre-allocate the right amount of memory
+// Arena and zone storage is recycled through per-CPU size-class freelists, so
+// that creating and destroying arenas does not call malloc in steady state
 
 #ifndef GRPC_CORE_LIB_GPRPP_ARENA_H
 #define GRPC_CORE_LIB_GPRPP_ARENA_H
@@ -54,6 +56,11 @@ class Arena {
 
   // Destroy an arena, returning the total number of bytes allocated.
   size_t Destroy();
+
+  // Free the storage cached for reuse by future arenas. Called when memory is
+  // short.
+  static void TrimCache();
+
   // Allocate \a size bytes from the arena.
   void* Alloc(size_t size) {
     static constexpr size_t base_size =
@@ -81,14 +88,16 @@ class Arena {
  private:
   struct Zone {
     Zone* prev;
+    size_t size;
   };
 
   // Initialize an arena.
   // Parameters:
   //   initial_size: The initial size of the whole arena in bytes. These bytes
-  //   are contained within 'zone 0'. If the arena user ends up requiring more
-  //   memory than the arena contains in zone 0, subsequent zones are allocated
-  //   on demand and maintained in a tail-linked list.
+  //   are contained within 'zone 0', whose storage may be rounded up to a
+  //   size class; the extra bytes are usable too. If the arena user ends up
+  //   requiring more memory than the arena contains in zone 0, subsequent
+  //   zones are allocated on demand and maintained in a tail-linked list.
   //
   //   initial_alloc: Optionally, construct the arena as though a call to
   //   Alloc() had already been made for initial_alloc bytes. This provides a
@@ -111,8 +120,9 @@ class Arena {
   // If the initial arena allocation wasn't enough, we allocate additional zones
   // in a reverse linked list. Each additional zone consists of (1) a pointer to
   // the zone added before this zone (null if this is the first additional zone)
-  // and (2) the allocated memory. The arena itself maintains a pointer to the
-  // last zone; the zone list is reverse-walked during arena destruction only.
+  // and the size of its storage, and (2) the allocated memory. The arena
+  // itself maintains a pointer to the last zone; the zone list is
+  // reverse-walked during arena destruction only.
   Zone* last_zone_ = nullptr;
 };
 
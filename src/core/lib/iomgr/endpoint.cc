@@ -65,3 +65,9 @@ int grpc_endpoint_get_fd(grpc_endpoint* ep) { return ep->vtable->get_fd(ep); }
 bool grpc_endpoint_can_track_err(grpc_endpoint* ep) {
   return ep->vtable->can_track_err(ep);
 }
+
+void grpc_endpoint_set_read_hint(grpc_endpoint* ep, size_t bytes) {
+  if (ep->vtable->set_read_hint != nullptr) {
+    ep->vtable->set_read_hint(ep, bytes);
+  }
+}
@@ -51,6 +51,8 @@ struct grpc_endpoint_vtable {
   absl::string_view (*get_local_address)(grpc_endpoint* ep);
   int (*get_fd)(grpc_endpoint* ep);
   bool (*can_track_err)(grpc_endpoint* ep);
+  /* Optional: may be null if the endpoint has no use for read hints. */
+  void (*set_read_hint)(grpc_endpoint* ep, size_t bytes);
 };
 
 /* When data is available on the connection, calls the callback with slices.
@@ -101,6 +103,12 @@ void grpc_endpoint_delete_from_pollset_set(grpc_endpoint* ep,
 
 bool grpc_endpoint_can_track_err(grpc_endpoint* ep);
 
+/* Tells \a ep that the reader expects at least \a bytes more bytes before it
+   can make progress (e.g. the remainder of the frame currently being parsed),
+   or 0 if it does not know. Endpoints may use this to size their next read
+   buffer; it is purely advisory. */
+void grpc_endpoint_set_read_hint(grpc_endpoint* ep, size_t bytes);
+
 struct grpc_endpoint {
   const grpc_endpoint_vtable* vtable;
 };
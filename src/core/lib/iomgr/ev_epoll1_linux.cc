@@ -28,7 +28,6 @@
 #include <assert.h>
 #include <errno.h>
 #include <fcntl.h>
-#include <limits.h>
 #include <poll.h>
 #include <pthread.h>
 #include <string.h>
@@ -37,30 +36,23 @@
 #include <unistd.h>
 
 #include <string>
-#include <vector>
 
 #include "absl/strings/str_cat.h"
-#include "absl/strings/str_format.h"
-#include "absl/strings/str_join.h"
 
 #include <grpc/support/alloc.h>
-#include <grpc/support/cpu.h>
 
 #include "src/core/lib/debug/stats.h"
 #include "src/core/lib/gpr/string.h"
-#include "src/core/lib/gpr/tls.h"
-#include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/manual_constructor.h"
 #include "src/core/lib/iomgr/block_annotate.h"
 #include "src/core/lib/iomgr/ev_epoll1_linux.h"
 #include "src/core/lib/iomgr/ev_posix.h"
 #include "src/core/lib/iomgr/iomgr_internal.h"
 #include "src/core/lib/iomgr/lockfree_event.h"
+#include "src/core/lib/iomgr/turnstile_pollset_linux.h"
 #include "src/core/lib/iomgr/wakeup_fd_posix.h"
 #include "src/core/lib/profiling/timers.h"
 
-static grpc_wakeup_fd global_wakeup_fd;
-
 /*******************************************************************************
  * Singleton epoll set related fields
  */
@@ -161,81 +153,6 @@ struct grpc_fd {
 static void fd_global_init(void);
 static void fd_global_shutdown(void);
 
-/*******************************************************************************
- * Pollset Declarations
- */
-
-typedef enum { UNKICKED, KICKED, DESIGNATED_POLLER } kick_state;
-
-static const char* kick_state_string(kick_state st) {
-  switch (st) {
-    case UNKICKED:
-      return "UNKICKED";
-    case KICKED:
-      return "KICKED";
-    case DESIGNATED_POLLER:
-      return "DESIGNATED_POLLER";
-  }
-  GPR_UNREACHABLE_CODE(return "UNKNOWN");
-}
-
-struct grpc_pollset_worker {
-  kick_state state;
-  int kick_state_mutator;  // which line of code last changed kick state
-  bool initialized_cv;
-  grpc_pollset_worker* next;
-  grpc_pollset_worker* prev;
-  gpr_cv cv;
-  grpc_closure_list schedule_on_end_work;
-};
-
-#define SET_KICK_STATE(worker, kick_state)   \
-  do {                                       \
-    (worker)->state = (kick_state);          \
-    (worker)->kick_state_mutator = __LINE__; \
-  } while (false)
-
-#define MAX_NEIGHBORHOODS 1024u
-
-typedef struct pollset_neighborhood {
-  union {
-    char pad[GPR_CACHELINE_SIZE];
-    struct {
-      gpr_mu mu;
-      grpc_pollset* active_root;
-    };
-  };
-} pollset_neighborhood;
-
-struct grpc_pollset {
-  gpr_mu mu;
-  pollset_neighborhood* neighborhood;
-  bool reassigning_neighborhood;
-  grpc_pollset_worker* root_worker;
-  bool kicked_without_poller;
-
-  /* Set to true if the pollset is observed to have no workers available to
-     poll */
-  bool seen_inactive;
-  bool shutting_down;             /* Is the pollset shutting down ? */
-  grpc_closure* shutdown_closure; /* Called after shutdown is complete */
-
-  /* Number of workers who are *about-to* attach themselves to the pollset
-   * worker list */
-  int begin_refs;
-
-  grpc_pollset* next;
-  grpc_pollset* prev;
-};
-
-/*******************************************************************************
- * Pollset-set Declarations
- */
-
-struct grpc_pollset_set {
-  char unused;
-};
-
 /*******************************************************************************
  * Common helpers
  */
@@ -267,11 +184,6 @@ static bool append_error(grpc_error_handle* composite, grpc_error_handle error,
  * becomes a spurious read notification on a reused fd.
  */
 
-/* The alarm system needs to be able to wakeup 'some poller' sometimes
- * (specifically when a new alarm needs to be triggered earlier than the next
- * alarm 'epoch'). This wakeup_fd gives us something to alert on when such a
- * case occurs. */
-
 static grpc_fd* fd_freelist = nullptr;
 static gpr_mu fd_freelist_mu;
 
@@ -463,194 +375,6 @@ static void fd_has_errors(grpc_fd* fd) { fd->error_closure->SetReady(); }
  * Pollset Definitions
  */
 
-static GPR_THREAD_LOCAL(grpc_pollset*) g_current_thread_pollset;
-static GPR_THREAD_LOCAL(grpc_pollset_worker*) g_current_thread_worker;
-
-/* The designated poller */
-static gpr_atm g_active_poller;
-
-static pollset_neighborhood* g_neighborhoods;
-static size_t g_num_neighborhoods;
-
-/* Return true if first in list */
-static bool worker_insert(grpc_pollset* pollset, grpc_pollset_worker* worker) {
-  if (pollset->root_worker == nullptr) {
-    pollset->root_worker = worker;
-    worker->next = worker->prev = worker;
-    return true;
-  } else {
-    worker->next = pollset->root_worker;
-    worker->prev = worker->next->prev;
-    worker->next->prev = worker;
-    worker->prev->next = worker;
-    return false;
-  }
-}
-
-/* Return true if last in list */
-typedef enum { EMPTIED, NEW_ROOT, REMOVED } worker_remove_result;
-
-static worker_remove_result worker_remove(grpc_pollset* pollset,
-                                          grpc_pollset_worker* worker) {
-  if (worker == pollset->root_worker) {
-    if (worker == worker->next) {
-      pollset->root_worker = nullptr;
-      return EMPTIED;
-    } else {
-      pollset->root_worker = worker->next;
-      worker->prev->next = worker->next;
-      worker->next->prev = worker->prev;
-      return NEW_ROOT;
-    }
-  } else {
-    worker->prev->next = worker->next;
-    worker->next->prev = worker->prev;
-    return REMOVED;
-  }
-}
-
-static size_t choose_neighborhood(void) {
-  return static_cast<size_t>(gpr_cpu_current_cpu()) % g_num_neighborhoods;
-}
-
-static grpc_error_handle pollset_global_init(void) {
-  gpr_atm_no_barrier_store(&g_active_poller, 0);
-  global_wakeup_fd.read_fd = -1;
-  grpc_error_handle err = grpc_wakeup_fd_init(&global_wakeup_fd);
-  if (err != GRPC_ERROR_NONE) return err;
-  struct epoll_event ev;
-  ev.events = static_cast<uint32_t>(EPOLLIN | EPOLLET);
-  ev.data.ptr = &global_wakeup_fd;
-  if (epoll_ctl(g_epoll_set.epfd, EPOLL_CTL_ADD, global_wakeup_fd.read_fd,
-                &ev) != 0) {
-    return GRPC_OS_ERROR(errno, "epoll_ctl");
-  }
-  g_num_neighborhoods =
-      grpc_core::Clamp(gpr_cpu_num_cores(), 1u, MAX_NEIGHBORHOODS);
-  g_neighborhoods = static_cast<pollset_neighborhood*>(
-      gpr_zalloc(sizeof(*g_neighborhoods) * g_num_neighborhoods));
-  for (size_t i = 0; i < g_num_neighborhoods; i++) {
-    gpr_mu_init(&g_neighborhoods[i].mu);
-  }
-  return GRPC_ERROR_NONE;
-}
-
-static void pollset_global_shutdown(void) {
-  if (global_wakeup_fd.read_fd != -1) grpc_wakeup_fd_destroy(&global_wakeup_fd);
-  for (size_t i = 0; i < g_num_neighborhoods; i++) {
-    gpr_mu_destroy(&g_neighborhoods[i].mu);
-  }
-  gpr_free(g_neighborhoods);
-}
-
-static void pollset_init(grpc_pollset* pollset, gpr_mu** mu) {
-  gpr_mu_init(&pollset->mu);
-  *mu = &pollset->mu;
-  pollset->neighborhood = &g_neighborhoods[choose_neighborhood()];
-  pollset->reassigning_neighborhood = false;
-  pollset->root_worker = nullptr;
-  pollset->kicked_without_poller = false;
-  pollset->seen_inactive = true;
-  pollset->shutting_down = false;
-  pollset->shutdown_closure = nullptr;
-  pollset->begin_refs = 0;
-  pollset->next = pollset->prev = nullptr;
-}
-
-static void pollset_destroy(grpc_pollset* pollset) {
-  gpr_mu_lock(&pollset->mu);
-  if (!pollset->seen_inactive) {
-    pollset_neighborhood* neighborhood = pollset->neighborhood;
-    gpr_mu_unlock(&pollset->mu);
-  retry_lock_neighborhood:
-    gpr_mu_lock(&neighborhood->mu);
-    gpr_mu_lock(&pollset->mu);
-    if (!pollset->seen_inactive) {
-      if (pollset->neighborhood != neighborhood) {
-        gpr_mu_unlock(&neighborhood->mu);
-        neighborhood = pollset->neighborhood;
-        gpr_mu_unlock(&pollset->mu);
-        goto retry_lock_neighborhood;
-      }
-      pollset->prev->next = pollset->next;
-      pollset->next->prev = pollset->prev;
-      if (pollset == pollset->neighborhood->active_root) {
-        pollset->neighborhood->active_root =
-            pollset->next == pollset ? nullptr : pollset->next;
-      }
-    }
-    gpr_mu_unlock(&pollset->neighborhood->mu);
-  }
-  gpr_mu_unlock(&pollset->mu);
-  gpr_mu_destroy(&pollset->mu);
-}
-
-static grpc_error_handle pollset_kick_all(grpc_pollset* pollset) {
-  GPR_TIMER_SCOPE("pollset_kick_all", 0);
-  grpc_error_handle error = GRPC_ERROR_NONE;
-  if (pollset->root_worker != nullptr) {
-    grpc_pollset_worker* worker = pollset->root_worker;
-    do {
-      GRPC_STATS_INC_POLLSET_KICK();
-      switch (worker->state) {
-        case KICKED:
-          GRPC_STATS_INC_POLLSET_KICKED_AGAIN();
-          break;
-        case UNKICKED:
-          SET_KICK_STATE(worker, KICKED);
-          if (worker->initialized_cv) {
-            GRPC_STATS_INC_POLLSET_KICK_WAKEUP_CV();
-            gpr_cv_signal(&worker->cv);
-          }
-          break;
-        case DESIGNATED_POLLER:
-          GRPC_STATS_INC_POLLSET_KICK_WAKEUP_FD();
-          SET_KICK_STATE(worker, KICKED);
-          append_error(&error, grpc_wakeup_fd_wakeup(&global_wakeup_fd),
-                       "pollset_kick_all");
-          break;
-      }
-
-      worker = worker->next;
-    } while (worker != pollset->root_worker);
-  }
-  // TODO(sreek): Check if we need to set 'kicked_without_poller' to true here
-  // in the else case
-  return error;
-}
-
-static void pollset_maybe_finish_shutdown(grpc_pollset* pollset) {
-  if (pollset->shutdown_closure != nullptr && pollset->root_worker == nullptr &&
-      pollset->begin_refs == 0) {
-    GPR_TIMER_MARK("pollset_finish_shutdown", 0);
-    grpc_core::ExecCtx::Run(DEBUG_LOCATION, pollset->shutdown_closure,
-                            GRPC_ERROR_NONE);
-    pollset->shutdown_closure = nullptr;
-  }
-}
-
-static void pollset_shutdown(grpc_pollset* pollset, grpc_closure* closure) {
-  GPR_TIMER_SCOPE("pollset_shutdown", 0);
-  GPR_ASSERT(pollset->shutdown_closure == nullptr);
-  GPR_ASSERT(!pollset->shutting_down);
-  pollset->shutdown_closure = closure;
-  pollset->shutting_down = true;
-  GRPC_LOG_IF_ERROR("pollset_shutdown", pollset_kick_all(pollset));
-  pollset_maybe_finish_shutdown(pollset);
-}
-
-static int poll_deadline_to_millis_timeout(grpc_millis millis) {
-  if (millis == GRPC_MILLIS_INF_FUTURE) return -1;
-  grpc_millis delta = millis - grpc_core::ExecCtx::Get()->Now();
-  if (delta > INT_MAX) {
-    return INT_MAX;
-  } else if (delta < 0) {
-    return 0;
-  } else {
-    return static_cast<int>(delta);
-  }
-}
-
 /* Process the epoll events found by do_epoll_wait() function.
    - g_epoll_set.cursor points to the index of the first event to be processed
    - This function then processes up-to MAX_EPOLL_EVENTS_PER_ITERATION and
@@ -673,8 +397,9 @@ static grpc_error_handle process_epoll_events(grpc_pollset* /*pollset*/) {
     struct epoll_event* ev = &g_epoll_set.events[c];
     void* data_ptr = ev->data.ptr;
 
-    if (data_ptr == &global_wakeup_fd) {
-      append_error(&error, grpc_wakeup_fd_consume_wakeup(&global_wakeup_fd),
+    if (data_ptr == grpc_turnstile_wakeup_fd()) {
+      append_error(&error,
+                   grpc_wakeup_fd_consume_wakeup(grpc_turnstile_wakeup_fd()),
                    err_desc);
     } else {
       grpc_fd* fd = reinterpret_cast<grpc_fd*>(
@@ -711,21 +436,63 @@ static grpc_error_handle process_epoll_events(grpc_pollset* /*pollset*/) {
    NOTE ON SYNCHRONIZATION: At any point of time, only the g_active_poller
    (i.e the designated poller thread) will be calling this function. So there is
    no need for any synchronization when accesing fields in g_epoll_set */
+/* Spins on non-blocking epoll_wait() calls for up to busy_poll_us (and no
+   longer than timeout milliseconds, if not infinite), so that events arriving
+   shortly after the poller runs out of work are picked up without paying for
+   a sleep and a wakeup. Returns the result of the last epoll_wait() call: 0 if
+   the budget ran out without any events.
+
+   NOTE ON SYNCHRONIZATION: Only called by the g_active_poller thread, from
+   do_epoll_wait() */
+static int busy_poll_epoll_wait(int busy_poll_us, int timeout) {
+  GPR_TIMER_SCOPE("busy_poll_epoll_wait", 0);
+  gpr_timespec now = gpr_now(GPR_CLOCK_MONOTONIC);
+  gpr_timespec end =
+      gpr_time_add(now, gpr_time_from_micros(busy_poll_us, GPR_TIMESPAN));
+  if (timeout > 0) {
+    end = gpr_time_min(
+        end, gpr_time_add(now, gpr_time_from_millis(timeout, GPR_TIMESPAN)));
+  }
+  do {
+    GRPC_STATS_INC_SYSCALL_POLL();
+    GRPC_STATS_INC_BUSY_POLL_SPINS();
+    int r =
+        epoll_wait(g_epoll_set.epfd, g_epoll_set.events, MAX_EPOLL_EVENTS, 0);
+    if (r > 0) {
+      GRPC_STATS_INC_BUSY_POLL_HITS();
+      return r;
+    }
+    if (r < 0 && errno != EINTR) return r;
+  } while (gpr_time_cmp(gpr_now(GPR_CLOCK_MONOTONIC), end) < 0);
+  return 0;
+}
+
 static grpc_error_handle do_epoll_wait(grpc_pollset* ps, grpc_millis deadline) {
   GPR_TIMER_SCOPE("do_epoll_wait", 0);
 
-  int r;
-  int timeout = poll_deadline_to_millis_timeout(deadline);
-  if (timeout != 0) {
-    GRPC_SCHEDULING_START_BLOCKING_REGION;
+  int r = 0;
+  int timeout = grpc_turnstile_deadline_to_millis_timeout(deadline);
+  int busy_poll_us = grpc_event_engine_busy_poll_us();
+  if (timeout != 0 && busy_poll_us > 0) {
+    r = busy_poll_epoll_wait(busy_poll_us, timeout);
+    if (r == 0) {
+      /* Nothing turned up while spinning: park for the rest of the timeout */
+      grpc_core::ExecCtx::Get()->InvalidateNow();
+      timeout = grpc_turnstile_deadline_to_millis_timeout(deadline);
+    }
   }
-  do {
-    GRPC_STATS_INC_SYSCALL_POLL();
-    r = epoll_wait(g_epoll_set.epfd, g_epoll_set.events, MAX_EPOLL_EVENTS,
-                   timeout);
-  } while (r < 0 && errno == EINTR);
-  if (timeout != 0) {
-    GRPC_SCHEDULING_END_BLOCKING_REGION;
+  if (r == 0) {
+    if (timeout != 0) {
+      GRPC_SCHEDULING_START_BLOCKING_REGION;
+    }
+    do {
+      GRPC_STATS_INC_SYSCALL_POLL();
+      r = epoll_wait(g_epoll_set.epfd, g_epoll_set.events, MAX_EPOLL_EVENTS,
+                     timeout);
+    } while (r < 0 && errno == EINTR);
+    if (timeout != 0) {
+      GRPC_SCHEDULING_END_BLOCKING_REGION;
+    }
   }
 
   if (r < 0) return GRPC_OS_ERROR(errno, "epoll_wait");
@@ -742,508 +509,30 @@ static grpc_error_handle do_epoll_wait(grpc_pollset* ps, grpc_millis deadline) {
   return GRPC_ERROR_NONE;
 }
 
-static bool begin_worker(grpc_pollset* pollset, grpc_pollset_worker* worker,
-                         grpc_pollset_worker** worker_hdl,
-                         grpc_millis deadline) {
-  GPR_TIMER_SCOPE("begin_worker", 0);
-  if (worker_hdl != nullptr) *worker_hdl = worker;
-  worker->initialized_cv = false;
-  SET_KICK_STATE(worker, UNKICKED);
-  worker->schedule_on_end_work = (grpc_closure_list)GRPC_CLOSURE_LIST_INIT;
-  pollset->begin_refs++;
-
-  if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
-    gpr_log(GPR_INFO, "PS:%p BEGIN_STARTS:%p", pollset, worker);
-  }
-
-  if (pollset->seen_inactive) {
-    // pollset has been observed to be inactive, we need to move back to the
-    // active list
-    bool is_reassigning = false;
-    if (!pollset->reassigning_neighborhood) {
-      is_reassigning = true;
-      pollset->reassigning_neighborhood = true;
-      pollset->neighborhood = &g_neighborhoods[choose_neighborhood()];
-    }
-    pollset_neighborhood* neighborhood = pollset->neighborhood;
-    gpr_mu_unlock(&pollset->mu);
-  // pollset unlocked: state may change (even worker->kick_state)
-  retry_lock_neighborhood:
-    gpr_mu_lock(&neighborhood->mu);
-    gpr_mu_lock(&pollset->mu);
-    if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
-      gpr_log(GPR_INFO, "PS:%p BEGIN_REORG:%p kick_state=%s is_reassigning=%d",
-              pollset, worker, kick_state_string(worker->state),
-              is_reassigning);
-    }
-    if (pollset->seen_inactive) {
-      if (neighborhood != pollset->neighborhood) {
-        gpr_mu_unlock(&neighborhood->mu);
-        neighborhood = pollset->neighborhood;
-        gpr_mu_unlock(&pollset->mu);
-        goto retry_lock_neighborhood;
-      }
-
-      /* In the brief time we released the pollset locks above, the worker MAY
-         have been kicked. In this case, the worker should get out of this
-         pollset ASAP and hence this should neither add the pollset to
-         neighborhood nor mark the pollset as active.
-
-         On a side note, the only way a worker's kick state could have changed
-         at this point is if it were "kicked specifically". Since the worker has
-         not added itself to the pollset yet (by calling worker_insert()), it is
-         not visible in the "kick any" path yet */
-      if (worker->state == UNKICKED) {
-        pollset->seen_inactive = false;
-        if (neighborhood->active_root == nullptr) {
-          neighborhood->active_root = pollset->next = pollset->prev = pollset;
-          /* Make this the designated poller if there isn't one already */
-          if (worker->state == UNKICKED &&
-              gpr_atm_no_barrier_cas(&g_active_poller, 0,
-                                     reinterpret_cast<gpr_atm>(worker))) {
-            SET_KICK_STATE(worker, DESIGNATED_POLLER);
-          }
-        } else {
-          pollset->next = neighborhood->active_root;
-          pollset->prev = pollset->next->prev;
-          pollset->next->prev = pollset->prev->next = pollset;
-        }
-      }
-    }
-    if (is_reassigning) {
-      GPR_ASSERT(pollset->reassigning_neighborhood);
-      pollset->reassigning_neighborhood = false;
-    }
-    gpr_mu_unlock(&neighborhood->mu);
-  }
-
-  worker_insert(pollset, worker);
-  pollset->begin_refs--;
-  if (worker->state == UNKICKED && !pollset->kicked_without_poller) {
-    GPR_ASSERT(gpr_atm_no_barrier_load(&g_active_poller) != (gpr_atm)worker);
-    worker->initialized_cv = true;
-    gpr_cv_init(&worker->cv);
-    while (worker->state == UNKICKED && !pollset->shutting_down) {
-      if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
-        gpr_log(GPR_INFO, "PS:%p BEGIN_WAIT:%p kick_state=%s shutdown=%d",
-                pollset, worker, kick_state_string(worker->state),
-                pollset->shutting_down);
-      }
-
-      if (gpr_cv_wait(&worker->cv, &pollset->mu,
-                      grpc_millis_to_timespec(deadline, GPR_CLOCK_MONOTONIC)) &&
-          worker->state == UNKICKED) {
-        /* If gpr_cv_wait returns true (i.e a timeout), pretend that the worker
-           received a kick */
-        SET_KICK_STATE(worker, KICKED);
-      }
-    }
-    grpc_core::ExecCtx::Get()->InvalidateNow();
-  }
-
-  if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
-    gpr_log(GPR_INFO,
-            "PS:%p BEGIN_DONE:%p kick_state=%s shutdown=%d "
-            "kicked_without_poller: %d",
-            pollset, worker, kick_state_string(worker->state),
-            pollset->shutting_down, pollset->kicked_without_poller);
-  }
-
-  /* We release pollset lock in this function at a couple of places:
-   *   1. Briefly when assigning pollset to a neighborhood
-   *   2. When doing gpr_cv_wait()
-   * It is possible that 'kicked_without_poller' was set to true during (1) and
-   * 'shutting_down' is set to true during (1) or (2). If either of them is
-   * true, this worker cannot do polling */
-  /* TODO(sreek): Perhaps there is a better way to handle kicked_without_poller
-   * case; especially when the worker is the DESIGNATED_POLLER */
-
-  if (pollset->kicked_without_poller) {
-    pollset->kicked_without_poller = false;
-    return false;
-  }
-
-  return worker->state == DESIGNATED_POLLER && !pollset->shutting_down;
-}
-
-static bool check_neighborhood_for_available_poller(
-    pollset_neighborhood* neighborhood) {
-  GPR_TIMER_SCOPE("check_neighborhood_for_available_poller", 0);
-  bool found_worker = false;
-  do {
-    grpc_pollset* inspect = neighborhood->active_root;
-    if (inspect == nullptr) {
-      break;
-    }
-    gpr_mu_lock(&inspect->mu);
-    GPR_ASSERT(!inspect->seen_inactive);
-    grpc_pollset_worker* inspect_worker = inspect->root_worker;
-    if (inspect_worker != nullptr) {
-      do {
-        switch (inspect_worker->state) {
-          case UNKICKED:
-            if (gpr_atm_no_barrier_cas(
-                    &g_active_poller, 0,
-                    reinterpret_cast<gpr_atm>(inspect_worker))) {
-              if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
-                gpr_log(GPR_INFO, " .. choose next poller to be %p",
-                        inspect_worker);
-              }
-              SET_KICK_STATE(inspect_worker, DESIGNATED_POLLER);
-              if (inspect_worker->initialized_cv) {
-                GPR_TIMER_MARK("signal worker", 0);
-                GRPC_STATS_INC_POLLSET_KICK_WAKEUP_CV();
-                gpr_cv_signal(&inspect_worker->cv);
-              }
-            } else {
-              if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
-                gpr_log(GPR_INFO, " .. beaten to choose next poller");
-              }
-            }
-            // even if we didn't win the cas, there's a worker, we can stop
-            found_worker = true;
-            break;
-          case KICKED:
-            break;
-          case DESIGNATED_POLLER:
-            found_worker = true;  // ok, so someone else found the worker, but
-                                  // we'll accept that
-            break;
-        }
-        inspect_worker = inspect_worker->next;
-      } while (!found_worker && inspect_worker != inspect->root_worker);
-    }
-    if (!found_worker) {
-      if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
-        gpr_log(GPR_INFO, " .. mark pollset %p inactive", inspect);
-      }
-      inspect->seen_inactive = true;
-      if (inspect == neighborhood->active_root) {
-        neighborhood->active_root =
-            inspect->next == inspect ? nullptr : inspect->next;
-      }
-      inspect->next->prev = inspect->prev;
-      inspect->prev->next = inspect->next;
-      inspect->next = inspect->prev = nullptr;
-    }
-    gpr_mu_unlock(&inspect->mu);
-  } while (!found_worker);
-  return found_worker;
-}
-
-static void end_worker(grpc_pollset* pollset, grpc_pollset_worker* worker,
-                       grpc_pollset_worker** worker_hdl) {
-  GPR_TIMER_SCOPE("end_worker", 0);
-  if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
-    gpr_log(GPR_INFO, "PS:%p END_WORKER:%p", pollset, worker);
-  }
-  if (worker_hdl != nullptr) *worker_hdl = nullptr;
-  /* Make sure we appear kicked */
-  SET_KICK_STATE(worker, KICKED);
-  grpc_closure_list_move(&worker->schedule_on_end_work,
-                         grpc_core::ExecCtx::Get()->closure_list());
-  if (gpr_atm_no_barrier_load(&g_active_poller) ==
-      reinterpret_cast<gpr_atm>(worker)) {
-    if (worker->next != worker && worker->next->state == UNKICKED) {
-      if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
-        gpr_log(GPR_INFO, " .. choose next poller to be peer %p", worker);
-      }
-      GPR_ASSERT(worker->next->initialized_cv);
-      gpr_atm_no_barrier_store(&g_active_poller, (gpr_atm)worker->next);
-      SET_KICK_STATE(worker->next, DESIGNATED_POLLER);
-      GRPC_STATS_INC_POLLSET_KICK_WAKEUP_CV();
-      gpr_cv_signal(&worker->next->cv);
-      if (grpc_core::ExecCtx::Get()->HasWork()) {
-        gpr_mu_unlock(&pollset->mu);
-        grpc_core::ExecCtx::Get()->Flush();
-        gpr_mu_lock(&pollset->mu);
-      }
-    } else {
-      gpr_atm_no_barrier_store(&g_active_poller, 0);
-      size_t poller_neighborhood_idx =
-          static_cast<size_t>(pollset->neighborhood - g_neighborhoods);
-      gpr_mu_unlock(&pollset->mu);
-      bool found_worker = false;
-      bool scan_state[MAX_NEIGHBORHOODS];
-      for (size_t i = 0; !found_worker && i < g_num_neighborhoods; i++) {
-        pollset_neighborhood* neighborhood =
-            &g_neighborhoods[(poller_neighborhood_idx + i) %
-                             g_num_neighborhoods];
-        if (gpr_mu_trylock(&neighborhood->mu)) {
-          found_worker = check_neighborhood_for_available_poller(neighborhood);
-          gpr_mu_unlock(&neighborhood->mu);
-          scan_state[i] = true;
-        } else {
-          scan_state[i] = false;
-        }
-      }
-      for (size_t i = 0; !found_worker && i < g_num_neighborhoods; i++) {
-        if (scan_state[i]) continue;
-        pollset_neighborhood* neighborhood =
-            &g_neighborhoods[(poller_neighborhood_idx + i) %
-                             g_num_neighborhoods];
-        gpr_mu_lock(&neighborhood->mu);
-        found_worker = check_neighborhood_for_available_poller(neighborhood);
-        gpr_mu_unlock(&neighborhood->mu);
-      }
-      grpc_core::ExecCtx::Get()->Flush();
-      gpr_mu_lock(&pollset->mu);
-    }
-  } else if (grpc_core::ExecCtx::Get()->HasWork()) {
-    gpr_mu_unlock(&pollset->mu);
-    grpc_core::ExecCtx::Get()->Flush();
-    gpr_mu_lock(&pollset->mu);
-  }
-  if (worker->initialized_cv) {
-    gpr_cv_destroy(&worker->cv);
-  }
-  if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
-    gpr_log(GPR_INFO, " .. remove worker");
-  }
-  if (EMPTIED == worker_remove(pollset, worker)) {
-    pollset_maybe_finish_shutdown(pollset);
-  }
-  GPR_ASSERT(gpr_atm_no_barrier_load(&g_active_poller) != (gpr_atm)worker);
-}
-
-/* pollset->po.mu lock must be held by the caller before calling this.
-   The function pollset_work() may temporarily release the lock (pollset->po.mu)
-   during the course of its execution but it will always re-acquire the lock and
-   ensure that it is held by the time the function returns */
-static grpc_error_handle pollset_work(grpc_pollset* ps,
-                                      grpc_pollset_worker** worker_hdl,
-                                      grpc_millis deadline) {
-  GPR_TIMER_SCOPE("pollset_work", 0);
-  grpc_pollset_worker worker;
-  grpc_error_handle error = GRPC_ERROR_NONE;
-  static const char* err_desc = "pollset_work";
-  if (ps->kicked_without_poller) {
-    ps->kicked_without_poller = false;
-    return GRPC_ERROR_NONE;
-  }
-
-  if (begin_worker(ps, &worker, worker_hdl, deadline)) {
-    g_current_thread_pollset = ps;
-    g_current_thread_worker = &worker;
-    GPR_ASSERT(!ps->shutting_down);
-    GPR_ASSERT(!ps->seen_inactive);
-
-    gpr_mu_unlock(&ps->mu); /* unlock */
-    /* This is the designated polling thread at this point and should ideally do
-       polling. However, if there are unprocessed events left from a previous
-       call to do_epoll_wait(), skip calling epoll_wait() in this iteration and
-       process the pending epoll events.
-
-       The reason for decoupling do_epoll_wait and process_epoll_events is to
-       better distribute the work (i.e handling epoll events) across multiple
-       threads
-
-       process_epoll_events() returns very quickly: It just queues the work on
-       exec_ctx but does not execute it (the actual exectution or more
-       accurately grpc_core::ExecCtx::Get()->Flush() happens in end_worker()
-       AFTER selecting a designated poller). So we are not waiting long periods
-       without a designated poller */
-    if (gpr_atm_acq_load(&g_epoll_set.cursor) ==
-        gpr_atm_acq_load(&g_epoll_set.num_events)) {
-      append_error(&error, do_epoll_wait(ps, deadline), err_desc);
-    }
-    append_error(&error, process_epoll_events(ps), err_desc);
-
-    gpr_mu_lock(&ps->mu); /* lock */
-
-    g_current_thread_worker = nullptr;
-  } else {
-    g_current_thread_pollset = ps;
-  }
-  end_worker(ps, &worker, worker_hdl);
-
-  g_current_thread_pollset = nullptr;
-  return error;
+static bool epoll_has_pending_events(void) {
+  return gpr_atm_acq_load(&g_epoll_set.cursor) !=
+         gpr_atm_acq_load(&g_epoll_set.num_events);
 }
 
-static grpc_error_handle pollset_kick(grpc_pollset* pollset,
-                                      grpc_pollset_worker* specific_worker) {
-  GPR_TIMER_SCOPE("pollset_kick", 0);
-  GRPC_STATS_INC_POLLSET_KICK();
-  grpc_error_handle ret_err = GRPC_ERROR_NONE;
-  if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
-    std::vector<std::string> log;
-    log.push_back(absl::StrFormat(
-        "PS:%p KICK:%p curps=%p curworker=%p root=%p", pollset, specific_worker,
-        static_cast<void*>(g_current_thread_pollset),
-        static_cast<void*>(g_current_thread_worker), pollset->root_worker));
-    if (pollset->root_worker != nullptr) {
-      log.push_back(absl::StrFormat(
-          " {kick_state=%s next=%p {kick_state=%s}}",
-          kick_state_string(pollset->root_worker->state),
-          pollset->root_worker->next,
-          kick_state_string(pollset->root_worker->next->state)));
-    }
-    if (specific_worker != nullptr) {
-      log.push_back(absl::StrFormat(" worker_kick_state=%s",
-                                    kick_state_string(specific_worker->state)));
-    }
-    gpr_log(GPR_DEBUG, "%s", absl::StrJoin(log, "").c_str());
-  }
+static const grpc_turnstile_poller epoll_poller = {
+    epoll_has_pending_events, do_epoll_wait, process_epoll_events};
 
-  if (specific_worker == nullptr) {
-    if (g_current_thread_pollset != pollset) {
-      grpc_pollset_worker* root_worker = pollset->root_worker;
-      if (root_worker == nullptr) {
-        GRPC_STATS_INC_POLLSET_KICKED_WITHOUT_POLLER();
-        pollset->kicked_without_poller = true;
-        if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
-          gpr_log(GPR_INFO, " .. kicked_without_poller");
-        }
-        goto done;
-      }
-      grpc_pollset_worker* next_worker = root_worker->next;
-      if (root_worker->state == KICKED) {
-        GRPC_STATS_INC_POLLSET_KICKED_AGAIN();
-        if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
-          gpr_log(GPR_INFO, " .. already kicked %p", root_worker);
-        }
-        SET_KICK_STATE(root_worker, KICKED);
-        goto done;
-      } else if (next_worker->state == KICKED) {
-        GRPC_STATS_INC_POLLSET_KICKED_AGAIN();
-        if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
-          gpr_log(GPR_INFO, " .. already kicked %p", next_worker);
-        }
-        SET_KICK_STATE(next_worker, KICKED);
-        goto done;
-      } else if (root_worker == next_worker &&  // only try and wake up a poller
-                                                // if there is no next worker
-                 root_worker ==
-                     reinterpret_cast<grpc_pollset_worker*>(
-                         gpr_atm_no_barrier_load(&g_active_poller))) {
-        GRPC_STATS_INC_POLLSET_KICK_WAKEUP_FD();
-        if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
-          gpr_log(GPR_INFO, " .. kicked %p", root_worker);
-        }
-        SET_KICK_STATE(root_worker, KICKED);
-        ret_err = grpc_wakeup_fd_wakeup(&global_wakeup_fd);
-        goto done;
-      } else if (next_worker->state == UNKICKED) {
-        GRPC_STATS_INC_POLLSET_KICK_WAKEUP_CV();
-        if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
-          gpr_log(GPR_INFO, " .. kicked %p", next_worker);
-        }
-        GPR_ASSERT(next_worker->initialized_cv);
-        SET_KICK_STATE(next_worker, KICKED);
-        gpr_cv_signal(&next_worker->cv);
-        goto done;
-      } else if (next_worker->state == DESIGNATED_POLLER) {
-        if (root_worker->state != DESIGNATED_POLLER) {
-          if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
-            gpr_log(
-                GPR_INFO,
-                " .. kicked root non-poller %p (initialized_cv=%d) (poller=%p)",
-                root_worker, root_worker->initialized_cv, next_worker);
-          }
-          SET_KICK_STATE(root_worker, KICKED);
-          if (root_worker->initialized_cv) {
-            GRPC_STATS_INC_POLLSET_KICK_WAKEUP_CV();
-            gpr_cv_signal(&root_worker->cv);
-          }
-          goto done;
-        } else {
-          GRPC_STATS_INC_POLLSET_KICK_WAKEUP_FD();
-          if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
-            gpr_log(GPR_INFO, " .. non-root poller %p (root=%p)", next_worker,
-                    root_worker);
-          }
-          SET_KICK_STATE(next_worker, KICKED);
-          ret_err = grpc_wakeup_fd_wakeup(&global_wakeup_fd);
-          goto done;
-        }
-      } else {
-        GRPC_STATS_INC_POLLSET_KICKED_AGAIN();
-        GPR_ASSERT(next_worker->state == KICKED);
-        SET_KICK_STATE(next_worker, KICKED);
-        goto done;
-      }
-    } else {
-      GRPC_STATS_INC_POLLSET_KICK_OWN_THREAD();
-      if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
-        gpr_log(GPR_INFO, " .. kicked while waking up");
-      }
-      goto done;
-    }
-
-    GPR_UNREACHABLE_CODE(goto done);
-  }
-
-  if (specific_worker->state == KICKED) {
-    if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
-      gpr_log(GPR_INFO, " .. specific worker already kicked");
-    }
-    goto done;
-  } else if (g_current_thread_worker == specific_worker) {
-    GRPC_STATS_INC_POLLSET_KICK_OWN_THREAD();
-    if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
-      gpr_log(GPR_INFO, " .. mark %p kicked", specific_worker);
-    }
-    SET_KICK_STATE(specific_worker, KICKED);
-    goto done;
-  } else if (specific_worker ==
-             reinterpret_cast<grpc_pollset_worker*>(
-                 gpr_atm_no_barrier_load(&g_active_poller))) {
-    GRPC_STATS_INC_POLLSET_KICK_WAKEUP_FD();
-    if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
-      gpr_log(GPR_INFO, " .. kick active poller");
-    }
-    SET_KICK_STATE(specific_worker, KICKED);
-    ret_err = grpc_wakeup_fd_wakeup(&global_wakeup_fd);
-    goto done;
-  } else if (specific_worker->initialized_cv) {
-    GRPC_STATS_INC_POLLSET_KICK_WAKEUP_CV();
-    if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
-      gpr_log(GPR_INFO, " .. kick waiting worker");
-    }
-    SET_KICK_STATE(specific_worker, KICKED);
-    gpr_cv_signal(&specific_worker->cv);
-    goto done;
-  } else {
-    GRPC_STATS_INC_POLLSET_KICKED_AGAIN();
-    if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
-      gpr_log(GPR_INFO, " .. kick non-waiting worker");
-    }
-    SET_KICK_STATE(specific_worker, KICKED);
-    goto done;
+static grpc_error_handle pollset_global_init(void) {
+  grpc_error_handle err = grpc_turnstile_pollset_global_init(&epoll_poller);
+  if (err != GRPC_ERROR_NONE) return err;
+  grpc_wakeup_fd* wakeup_fd = grpc_turnstile_wakeup_fd();
+  struct epoll_event ev;
+  ev.events = static_cast<uint32_t>(EPOLLIN | EPOLLET);
+  ev.data.ptr = wakeup_fd;
+  if (epoll_ctl(g_epoll_set.epfd, EPOLL_CTL_ADD, wakeup_fd->read_fd, &ev) !=
+      0) {
+    err = GRPC_OS_ERROR(errno, "epoll_ctl");
+    grpc_turnstile_pollset_global_shutdown();
+    return err;
   }
-done:
-  return ret_err;
-}
-
-static void pollset_add_fd(grpc_pollset* /*pollset*/, grpc_fd* /*fd*/) {}
-
-/*******************************************************************************
- * Pollset-set Definitions
- */
-
-static grpc_pollset_set* pollset_set_create(void) {
-  return reinterpret_cast<grpc_pollset_set*>(static_cast<intptr_t>(0xdeafbeef));
+  return GRPC_ERROR_NONE;
 }
 
-static void pollset_set_destroy(grpc_pollset_set* /*pss*/) {}
-
-static void pollset_set_add_fd(grpc_pollset_set* /*pss*/, grpc_fd* /*fd*/) {}
-
-static void pollset_set_del_fd(grpc_pollset_set* /*pss*/, grpc_fd* /*fd*/) {}
-
-static void pollset_set_add_pollset(grpc_pollset_set* /*pss*/,
-                                    grpc_pollset* /*ps*/) {}
-
-static void pollset_set_del_pollset(grpc_pollset_set* /*pss*/,
-                                    grpc_pollset* /*ps*/) {}
-
-static void pollset_set_add_pollset_set(grpc_pollset_set* /*bag*/,
-                                        grpc_pollset_set* /*item*/) {}
-
-static void pollset_set_del_pollset_set(grpc_pollset_set* /*bag*/,
-                                        grpc_pollset_set* /*item*/) {}
-
 /*******************************************************************************
  * Event engine binding
  */
@@ -1259,7 +548,7 @@ static bool add_closure_to_background_poller(grpc_closure* /*closure*/,
 
 static void shutdown_engine(void) {
   fd_global_shutdown();
-  pollset_global_shutdown();
+  grpc_turnstile_pollset_global_shutdown();
   epoll_set_shutdown();
   if (grpc_core::Fork::Enabled()) {
     gpr_mu_destroy(&fork_fd_list_mu);
@@ -1284,21 +573,21 @@ static const grpc_event_engine_vtable vtable = {
     fd_has_errors,
     fd_is_shutdown,
 
-    pollset_init,
-    pollset_shutdown,
-    pollset_destroy,
-    pollset_work,
-    pollset_kick,
-    pollset_add_fd,
-
-    pollset_set_create,
-    pollset_set_destroy,
-    pollset_set_add_pollset,
-    pollset_set_del_pollset,
-    pollset_set_add_pollset_set,
-    pollset_set_del_pollset_set,
-    pollset_set_add_fd,
-    pollset_set_del_fd,
+    grpc_turnstile_pollset_init,
+    grpc_turnstile_pollset_shutdown,
+    grpc_turnstile_pollset_destroy,
+    grpc_turnstile_pollset_work,
+    grpc_turnstile_pollset_kick,
+    grpc_turnstile_pollset_add_fd,
+
+    grpc_turnstile_pollset_set_create,
+    grpc_turnstile_pollset_set_destroy,
+    grpc_turnstile_pollset_set_add_pollset,
+    grpc_turnstile_pollset_set_del_pollset,
+    grpc_turnstile_pollset_set_add_pollset_set,
+    grpc_turnstile_pollset_set_del_pollset_set,
+    grpc_turnstile_pollset_set_add_fd,
+    grpc_turnstile_pollset_set_del_fd,
 
     is_any_background_poller_thread,
     shutdown_background_closure,
@@ -0,0 +1,1037 @@
+/*
+ *
+ * Copyright 2021 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <grpc/support/port_platform.h>
+
+#include <grpc/support/log.h>
+
+#include "src/core/lib/iomgr/port.h"
+
+/* This polling engine is only relevant on linux kernels that support io_uring
+   with extended io_uring_enter() arguments (5.11+). It uses the same turnstile
+   polling scheme as epoll1, but the singleton epoll set is replaced by a
+   singleton io_uring instance whose readiness notifications are one-shot
+   IORING_OP_POLL_ADD requests armed on demand. */
+#ifdef GRPC_LINUX_IO_URING
+#include <errno.h>
+#include <linux/io_uring.h>
+#include <poll.h>
+#include <signal.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <string>
+
+#include "absl/strings/str_cat.h"
+
+#include <grpc/support/alloc.h>
+
+#include "src/core/lib/debug/stats.h"
+#include "src/core/lib/gprpp/manual_constructor.h"
+#include "src/core/lib/iomgr/block_annotate.h"
+#include "src/core/lib/iomgr/ev_io_uring_linux.h"
+#include "src/core/lib/iomgr/ev_posix.h"
+#include "src/core/lib/iomgr/iomgr_internal.h"
+#include "src/core/lib/iomgr/lockfree_event.h"
+#include "src/core/lib/iomgr/turnstile_pollset_linux.h"
+#include "src/core/lib/iomgr/wakeup_fd_posix.h"
+#include "src/core/lib/profiling/timers.h"
+
+#if defined(__NR_io_uring_setup) && defined(IORING_FEAT_EXT_ARG)
+
+/*******************************************************************************
+ * Singleton io_uring related fields
+ */
+
+#define RING_ENTRIES 1024
+#define MAX_RING_EVENTS 100
+#define MAX_RING_EVENTS_HANDLED_PER_ITERATION 1
+
+/* The user_data of a poll request is the address of the grpc_fd it is for (or
+ * of the turnstile wakeup fd), which is at least 8-byte aligned and fits in 56
+ * bits. The low bits say what the request is for and the top byte holds the
+ * generation of the grpc_fd, so that completions of requests made for an
+ * earlier user of a recycled grpc_fd can be told apart. A user_data of zero is
+ * used for requests whose completions are ignored (IORING_OP_POLL_REMOVE). */
+#define USER_DATA_KIND_MASK static_cast<uint64_t>(3)
+#define USER_DATA_TRACK_ERR static_cast<uint64_t>(4)
+#define USER_DATA_FLAGS_MASK static_cast<uint64_t>(7)
+#define USER_DATA_GENERATION_SHIFT 56
+#define USER_DATA_ADDRESS_MASK                                      \
+  (((static_cast<uint64_t>(1) << USER_DATA_GENERATION_SHIFT) - 1) & \
+   ~USER_DATA_FLAGS_MASK)
+
+typedef enum {
+  POLL_KIND_WAKEUP = 0,
+  POLL_KIND_READ = 1,
+  POLL_KIND_WRITE = 2,
+  POLL_KIND_ERROR = 3
+} poll_kind;
+
+typedef struct ring_event {
+  uint64_t user_data;
+  int32_t res;
+} ring_event;
+
+/* A poll request that did not fit in the submission queue */
+typedef struct ring_request {
+  int fd;
+  uint32_t poll_mask;
+  uint64_t user_data;
+  bool remove;
+  struct ring_request* next;
+} ring_request;
+
+/* NOTE ON SYNCHRONIZATION:
+ * - The submission queue is shared by every thread that arms a poll request
+ *   (i.e. any thread calling grpc_fd_notify_on_*), so all submission-side
+ *   fields, including the backlog, are protected by sq_mu.
+ * - The completion queue and the events array are only touched by the
+ *   designated poller. As with epoll1, num_events and cursor are atomics only
+ *   to provide memory visibility as the designated poller changes.
+ */
+typedef struct io_uring_set {
+  int ring_fd;
+
+  void* sq_ring;
+  size_t sq_ring_size;
+  void* cq_ring;
+  size_t cq_ring_size;
+  struct io_uring_sqe* sqes;
+  size_t sqes_size;
+
+  /* Submission queue ring, mapped from the kernel */
+  unsigned* sq_head;
+  unsigned* sq_tail;
+  unsigned sq_mask;
+  unsigned sq_entries;
+  unsigned* sq_array;
+
+  /* Completion queue ring, mapped from the kernel */
+  unsigned* cq_head;
+  unsigned* cq_tail;
+  unsigned cq_mask;
+  struct io_uring_cqe* cqes;
+
+  gpr_mu sq_mu;
+  /* True while the designated poller is blocked in io_uring_enter(). Requests
+     queued while this is set must be submitted by the queueing thread. */
+  bool poller_in_kernel;
+  /* Requests that found the submission queue full while the kernel would not
+     take more (its completion queue is overflowing), oldest first. Requests
+     are never dropped: they wait here, and any request made after them too so
+     that a removal never overtakes the poll it removes, until the designated
+     poller has reaped completions. */
+  ring_request* backlog_head;
+  ring_request* backlog_tail;
+
+  /* The completions reaped after the last call to io_uring_enter() */
+  ring_event events[MAX_RING_EVENTS];
+
+  /* The number of completions reaped after the last call to io_uring_enter() */
+  gpr_atm num_events;
+
+  /* Index of the first event in events that has to be processed. This field
+   * is only valid if num_events > 0 */
+  gpr_atm cursor;
+} io_uring_set;
+
+/* The global singleton io_uring instance */
+static io_uring_set g_ring;
+
+static int sys_io_uring_setup(unsigned entries, struct io_uring_params* p) {
+  return static_cast<int>(syscall(__NR_io_uring_setup, entries, p));
+}
+
+static int sys_io_uring_enter(int fd, unsigned to_submit, unsigned min_complete,
+                              unsigned flags, const void* arg, size_t argsz) {
+  return static_cast<int>(syscall(__NR_io_uring_enter, fd, to_submit,
+                                  min_complete, flags, arg, argsz));
+}
+
+static void ring_unmap() {
+  if (g_ring.sqes != nullptr) {
+    munmap(g_ring.sqes, g_ring.sqes_size);
+    g_ring.sqes = nullptr;
+  }
+  if (g_ring.cq_ring != nullptr && g_ring.cq_ring != g_ring.sq_ring) {
+    munmap(g_ring.cq_ring, g_ring.cq_ring_size);
+  }
+  g_ring.cq_ring = nullptr;
+  if (g_ring.sq_ring != nullptr) {
+    munmap(g_ring.sq_ring, g_ring.sq_ring_size);
+    g_ring.sq_ring = nullptr;
+  }
+}
+
+/* Must be called *only* once */
+static bool ring_init() {
+  struct io_uring_params params;
+  memset(&params, 0, sizeof(params));
+  memset(&g_ring, 0, sizeof(g_ring));
+  g_ring.ring_fd = sys_io_uring_setup(RING_ENTRIES, &params);
+  if (g_ring.ring_fd < 0) {
+    gpr_log(GPR_ERROR, "io_uring_setup unavailable: %s", strerror(errno));
+    return false;
+  }
+  if ((params.features & IORING_FEAT_EXT_ARG) == 0 ||
+      (params.features & IORING_FEAT_NODROP) == 0) {
+    gpr_log(GPR_ERROR, "io_uring lacks required features (have 0x%x)",
+            params.features);
+    close(g_ring.ring_fd);
+    g_ring.ring_fd = -1;
+    return false;
+  }
+
+  g_ring.sq_ring_size =
+      params.sq_off.array + params.sq_entries * sizeof(unsigned);
+  g_ring.cq_ring_size =
+      params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+  bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+  if (single_mmap) {
+    g_ring.sq_ring_size = g_ring.cq_ring_size =
+        std::max(g_ring.sq_ring_size, g_ring.cq_ring_size);
+  }
+  g_ring.sq_ring =
+      mmap(nullptr, g_ring.sq_ring_size, PROT_READ | PROT_WRITE,
+           MAP_SHARED | MAP_POPULATE, g_ring.ring_fd, IORING_OFF_SQ_RING);
+  if (g_ring.sq_ring == MAP_FAILED) {
+    g_ring.sq_ring = nullptr;
+    gpr_log(GPR_ERROR, "mmap of io_uring sq ring failed: %s", strerror(errno));
+    close(g_ring.ring_fd);
+    g_ring.ring_fd = -1;
+    return false;
+  }
+  if (single_mmap) {
+    g_ring.cq_ring = g_ring.sq_ring;
+  } else {
+    g_ring.cq_ring =
+        mmap(nullptr, g_ring.cq_ring_size, PROT_READ | PROT_WRITE,
+             MAP_SHARED | MAP_POPULATE, g_ring.ring_fd, IORING_OFF_CQ_RING);
+    if (g_ring.cq_ring == MAP_FAILED) {
+      g_ring.cq_ring = nullptr;
+      gpr_log(GPR_ERROR, "mmap of io_uring cq ring failed: %s",
+              strerror(errno));
+      ring_unmap();
+      close(g_ring.ring_fd);
+      g_ring.ring_fd = -1;
+      return false;
+    }
+  }
+  g_ring.sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+  void* sqes =
+      mmap(nullptr, g_ring.sqes_size, PROT_READ | PROT_WRITE,
+           MAP_SHARED | MAP_POPULATE, g_ring.ring_fd, IORING_OFF_SQES);
+  if (sqes == MAP_FAILED) {
+    gpr_log(GPR_ERROR, "mmap of io_uring sqes failed: %s", strerror(errno));
+    ring_unmap();
+    close(g_ring.ring_fd);
+    g_ring.ring_fd = -1;
+    return false;
+  }
+  g_ring.sqes = static_cast<struct io_uring_sqe*>(sqes);
+
+  char* sq = static_cast<char*>(g_ring.sq_ring);
+  g_ring.sq_head = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+  g_ring.sq_tail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+  g_ring.sq_mask = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+  g_ring.sq_entries =
+      *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_entries);
+  g_ring.sq_array = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+  char* cq = static_cast<char*>(g_ring.cq_ring);
+  g_ring.cq_head = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+  g_ring.cq_tail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+  g_ring.cq_mask = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+  g_ring.cqes =
+      reinterpret_cast<struct io_uring_cqe*>(cq + params.cq_off.cqes);
+
+  gpr_mu_init(&g_ring.sq_mu);
+  g_ring.poller_in_kernel = false;
+  gpr_log(GPR_INFO, "grpc io_uring fd: %d", g_ring.ring_fd);
+  gpr_atm_no_barrier_store(&g_ring.num_events, 0);
+  gpr_atm_no_barrier_store(&g_ring.cursor, 0);
+  return true;
+}
+
+/* ring_init() MUST be called before calling this. */
+static void ring_shutdown() {
+  if (g_ring.ring_fd >= 0) {
+    while (g_ring.backlog_head != nullptr) {
+      ring_request* req = g_ring.backlog_head;
+      g_ring.backlog_head = req->next;
+      gpr_free(req);
+    }
+    g_ring.backlog_tail = nullptr;
+    ring_unmap();
+    close(g_ring.ring_fd);
+    g_ring.ring_fd = -1;
+    gpr_mu_destroy(&g_ring.sq_mu);
+  }
+}
+
+/* Number of sqes queued but not yet consumed by the kernel. The kernel
+   advances sq_head as it consumes entries, so this may be an overestimate by
+   the time it is used; io_uring_enter() only consumes what is available.
+   g_ring.sq_mu must be held. */
+static unsigned ring_sq_pending_locked() {
+  return *g_ring.sq_tail - __atomic_load_n(g_ring.sq_head, __ATOMIC_ACQUIRE);
+}
+
+/* Hands every queued sqe to the kernel without waiting for completions.
+   g_ring.sq_mu must be held. */
+static grpc_error_handle ring_submit_locked() {
+  unsigned to_submit;
+  while ((to_submit = ring_sq_pending_locked()) > 0) {
+    GRPC_STATS_INC_SYSCALL_POLL();
+    int r = sys_io_uring_enter(g_ring.ring_fd, to_submit, 0, 0, nullptr, 0);
+    if (r < 0) {
+      if (errno == EINTR) continue;
+      if (errno == EAGAIN || errno == EBUSY) return GRPC_ERROR_NONE;
+      return GRPC_OS_ERROR(errno, "io_uring_enter");
+    }
+    if (r == 0) break;
+  }
+  return GRPC_ERROR_NONE;
+}
+
+static bool ring_sq_full_locked() {
+  return ring_sq_pending_locked() >= g_ring.sq_entries;
+}
+
+/* Writes a request to the submission queue, which must not be full.
+   g_ring.sq_mu must be held. */
+static void ring_push_locked(int fd, uint32_t poll_mask, uint64_t user_data,
+                             bool remove) {
+  unsigned tail = *g_ring.sq_tail;
+  unsigned idx = tail & g_ring.sq_mask;
+  struct io_uring_sqe* sqe = &g_ring.sqes[idx];
+  memset(sqe, 0, sizeof(*sqe));
+  if (remove) {
+    sqe->opcode = IORING_OP_POLL_REMOVE;
+    sqe->fd = -1;
+    sqe->addr = user_data;
+    sqe->user_data = 0;
+  } else {
+    sqe->opcode = IORING_OP_POLL_ADD;
+    sqe->fd = fd;
+#if __BYTE_ORDER == __BIG_ENDIAN
+    /* poll32_events is read as two 16 bit halves on big-endian kernels */
+    poll_mask = (poll_mask << 16) | (poll_mask >> 16);
+#endif
+    sqe->poll32_events = poll_mask;
+    sqe->user_data = user_data;
+  }
+  g_ring.sq_array[idx] = idx;
+  __atomic_store_n(g_ring.sq_tail, tail + 1, __ATOMIC_RELEASE);
+}
+
+/* Moves backlogged requests to the submission queue, handing queued sqes to
+   the kernel whenever it is full. Returns true if the backlog is now empty,
+   false if the kernel stopped taking requests. g_ring.sq_mu must be held. */
+static bool ring_flush_backlog_locked() {
+  while (g_ring.backlog_head != nullptr) {
+    if (ring_sq_full_locked()) {
+      GRPC_LOG_IF_ERROR("ring_flush_backlog", ring_submit_locked());
+      if (ring_sq_full_locked()) return false;
+    }
+    ring_request* req = g_ring.backlog_head;
+    g_ring.backlog_head = req->next;
+    if (g_ring.backlog_head == nullptr) g_ring.backlog_tail = nullptr;
+    ring_push_locked(req->fd, req->poll_mask, req->user_data, req->remove);
+    gpr_free(req);
+  }
+  return true;
+}
+
+/* Queues a poll request (or, if 'remove' is set, the removal of a previously
+   queued one identified by 'user_data'). Requests are normally handed to the
+   kernel in a batch by the designated poller right before it waits; they are
+   only submitted immediately when the poller is already blocked in the kernel
+   or the submission queue is full. If even that does not make room, the
+   request goes to the backlog and the designated poller is woken up to reap
+   completions and submit it. */
+static void ring_queue_poll(int fd, uint32_t poll_mask, uint64_t user_data,
+                            bool remove) {
+  gpr_mu_lock(&g_ring.sq_mu);
+  bool queued = false;
+  if (ring_flush_backlog_locked()) {
+    if (ring_sq_full_locked()) {
+      GRPC_LOG_IF_ERROR("ring_queue_poll", ring_submit_locked());
+    }
+    if (!ring_sq_full_locked()) {
+      ring_push_locked(fd, poll_mask, user_data, remove);
+      queued = true;
+    }
+  }
+  if (!queued) {
+    ring_request* req =
+        static_cast<ring_request*>(gpr_malloc(sizeof(ring_request)));
+    req->fd = fd;
+    req->poll_mask = poll_mask;
+    req->user_data = user_data;
+    req->remove = remove;
+    req->next = nullptr;
+    if (g_ring.backlog_tail == nullptr) {
+      g_ring.backlog_head = req;
+    } else {
+      g_ring.backlog_tail->next = req;
+    }
+    g_ring.backlog_tail = req;
+    if (g_ring.poller_in_kernel) {
+      GRPC_LOG_IF_ERROR("ring_queue_poll",
+                        grpc_wakeup_fd_wakeup(grpc_turnstile_wakeup_fd()));
+    }
+  } else if (g_ring.poller_in_kernel) {
+    GRPC_LOG_IF_ERROR("ring_queue_poll", ring_submit_locked());
+  }
+  gpr_mu_unlock(&g_ring.sq_mu);
+}
+
+/*******************************************************************************
+ * Fd Declarations
+ */
+
+/* Only used when GRPC_ENABLE_FORK_SUPPORT=1 */
+struct grpc_fork_fd_list {
+  grpc_fd* fd;
+  grpc_fd* next;
+  grpc_fd* prev;
+};
+
+struct grpc_fd {
+  int fd;
+  bool track_err;
+
+  grpc_core::ManualConstructor<grpc_core::LockfreeEvent> read_closure;
+  grpc_core::ManualConstructor<grpc_core::LockfreeEvent> write_closure;
+  grpc_core::ManualConstructor<grpc_core::LockfreeEvent> error_closure;
+
+  /* Bitmask (1 << poll_kind) of the poll requests currently outstanding in the
+     ring for this fd */
+  gpr_atm armed;
+
+  /* Incremented (modulo 256) every time the grpc_fd is orphaned. Part of the
+     user_data of every poll request, so that completions that arrive after
+     the grpc_fd has been recycled are ignored. */
+  gpr_atm generation;
+
+  struct grpc_fd* freelist_next;
+
+  grpc_iomgr_object iomgr_object;
+
+  /* Only used when GRPC_ENABLE_FORK_SUPPORT=1 */
+  grpc_fork_fd_list* fork_fd_list;
+};
+
+static void fd_global_init(void);
+static void fd_global_shutdown(void);
+
+/*******************************************************************************
+ * Common helpers
+ */
+
+static bool append_error(grpc_error_handle* composite, grpc_error_handle error,
+                         const char* desc) {
+  if (error == GRPC_ERROR_NONE) return true;
+  if (*composite == GRPC_ERROR_NONE) {
+    *composite = GRPC_ERROR_CREATE_FROM_COPIED_STRING(desc);
+  }
+  *composite = grpc_error_add_child(*composite, error);
+  return false;
+}
+
+/*******************************************************************************
+ * Fd Definitions
+ */
+
+/* As in epoll1, grpc_fd structures are freelisted rather than freed: a poll
+ * request may still be in flight in the ring when the fd is orphaned, and its
+ * completion carries the address of the grpc_fd. If we keep the object
+ * freelisted, in the worst case losing this race just becomes a spurious
+ * notification on a reused fd. */
+
+static grpc_fd* fd_freelist = nullptr;
+static gpr_mu fd_freelist_mu;
+
+/* Only used when GRPC_ENABLE_FORK_SUPPORT=1 */
+static grpc_fd* fork_fd_list_head = nullptr;
+static gpr_mu fork_fd_list_mu;
+
+static void fd_global_init(void) { gpr_mu_init(&fd_freelist_mu); }
+
+static void fd_global_shutdown(void) {
+  gpr_mu_lock(&fd_freelist_mu);
+  gpr_mu_unlock(&fd_freelist_mu);
+  while (fd_freelist != nullptr) {
+    grpc_fd* fd = fd_freelist;
+    fd_freelist = fd_freelist->freelist_next;
+    gpr_free(fd);
+  }
+  gpr_mu_destroy(&fd_freelist_mu);
+}
+
+static void fork_fd_list_add_grpc_fd(grpc_fd* fd) {
+  if (grpc_core::Fork::Enabled()) {
+    gpr_mu_lock(&fork_fd_list_mu);
+    fd->fork_fd_list =
+        static_cast<grpc_fork_fd_list*>(gpr_malloc(sizeof(grpc_fork_fd_list)));
+    fd->fork_fd_list->next = fork_fd_list_head;
+    fd->fork_fd_list->prev = nullptr;
+    if (fork_fd_list_head != nullptr) {
+      fork_fd_list_head->fork_fd_list->prev = fd;
+    }
+    fork_fd_list_head = fd;
+    gpr_mu_unlock(&fork_fd_list_mu);
+  }
+}
+
+static void fork_fd_list_remove_grpc_fd(grpc_fd* fd) {
+  if (grpc_core::Fork::Enabled()) {
+    gpr_mu_lock(&fork_fd_list_mu);
+    if (fork_fd_list_head == fd) {
+      fork_fd_list_head = fd->fork_fd_list->next;
+    }
+    if (fd->fork_fd_list->prev != nullptr) {
+      fd->fork_fd_list->prev->fork_fd_list->next = fd->fork_fd_list->next;
+    }
+    if (fd->fork_fd_list->next != nullptr) {
+      fd->fork_fd_list->next->fork_fd_list->prev = fd->fork_fd_list->prev;
+    }
+    gpr_free(fd->fork_fd_list);
+    gpr_mu_unlock(&fork_fd_list_mu);
+  }
+}
+
+static uint64_t fd_user_data(grpc_fd* fd, poll_kind kind) {
+  return reinterpret_cast<uint64_t>(fd) |
+         (static_cast<uint64_t>(gpr_atm_acq_load(&fd->generation))
+          << USER_DATA_GENERATION_SHIFT) |
+         static_cast<uint64_t>(kind) |
+         (fd->track_err ? USER_DATA_TRACK_ERR : 0);
+}
+
+/* Arms a one-shot poll request of the given kind for fd unless one is already
+   outstanding. */
+static void fd_arm(grpc_fd* fd, poll_kind kind) {
+  gpr_atm bit = static_cast<gpr_atm>(1) << kind;
+  gpr_atm armed;
+  do {
+    armed = gpr_atm_acq_load(&fd->armed);
+    if (armed & bit) return;
+  } while (!gpr_atm_full_cas(&fd->armed, armed, armed | bit));
+  uint32_t mask;
+  switch (kind) {
+    case POLL_KIND_READ:
+      mask = POLLIN | POLLPRI;
+      break;
+    case POLL_KIND_WRITE:
+      mask = POLLOUT;
+      break;
+    default:
+      /* POLLERR and POLLHUP are always reported */
+      mask = 0;
+      break;
+  }
+  ring_queue_poll(fd->fd, mask, fd_user_data(fd, kind), false);
+}
+
+/* Records that the poll request of the given kind has completed */
+static void fd_disarm(grpc_fd* fd, poll_kind kind) {
+  gpr_atm bit = static_cast<gpr_atm>(1) << kind;
+  gpr_atm armed;
+  do {
+    armed = gpr_atm_acq_load(&fd->armed);
+    if ((armed & bit) == 0) return;
+  } while (!gpr_atm_full_cas(&fd->armed, armed, armed & ~bit));
+}
+
+/* Cancels every poll request outstanding for fd */
+static void fd_disarm_all(grpc_fd* fd) {
+  gpr_atm armed = gpr_atm_full_xchg(&fd->armed, 0);
+  for (int kind = POLL_KIND_READ; kind <= POLL_KIND_ERROR; kind++) {
+    if (armed & (static_cast<gpr_atm>(1) << kind)) {
+      ring_queue_poll(-1, 0, fd_user_data(fd, static_cast<poll_kind>(kind)),
+                      true);
+    }
+  }
+}
+
+static grpc_fd* fd_create(int fd, const char* name, bool track_err) {
+  grpc_fd* new_fd = nullptr;
+
+  gpr_mu_lock(&fd_freelist_mu);
+  if (fd_freelist != nullptr) {
+    new_fd = fd_freelist;
+    fd_freelist = fd_freelist->freelist_next;
+  }
+  gpr_mu_unlock(&fd_freelist_mu);
+
+  if (new_fd == nullptr) {
+    new_fd = static_cast<grpc_fd*>(gpr_malloc(sizeof(grpc_fd)));
+    /* The poll kind, track_err and generation bits of user_data live in the
+       bits of the grpc_fd address that are always zero */
+    GPR_ASSERT((reinterpret_cast<uint64_t>(new_fd) & ~USER_DATA_ADDRESS_MASK) ==
+               0);
+    gpr_atm_no_barrier_store(&new_fd->generation, 0);
+    new_fd->read_closure.Init();
+    new_fd->write_closure.Init();
+    new_fd->error_closure.Init();
+  }
+  new_fd->fd = fd;
+  new_fd->track_err = track_err;
+  gpr_atm_no_barrier_store(&new_fd->armed, 0);
+  new_fd->read_closure->InitEvent();
+  new_fd->write_closure->InitEvent();
+  new_fd->error_closure->InitEvent();
+
+  new_fd->freelist_next = nullptr;
+
+  std::string fd_name = absl::StrCat(name, " fd=", fd);
+  grpc_iomgr_register_object(&new_fd->iomgr_object, fd_name.c_str());
+  fork_fd_list_add_grpc_fd(new_fd);
+#ifndef NDEBUG
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_trace_fd_refcount)) {
+    gpr_log(GPR_DEBUG, "FD %d %p create %s", fd, new_fd, fd_name.c_str());
+  }
+#endif
+
+  /* Unlike epoll1 there is nothing to register here: poll requests are only
+     queued once somebody is interested in an event on this fd */
+  return new_fd;
+}
+
+static int fd_wrapped_fd(grpc_fd* fd) { return fd->fd; }
+
+/* if 'releasing_fd' is true, it means that we are going to detach the internal
+ * fd from grpc_fd structure (i.e which means we should not be calling
+ * shutdown() syscall on that fd) */
+static void fd_shutdown_internal(grpc_fd* fd, grpc_error_handle why,
+                                 bool releasing_fd) {
+  if (fd->read_closure->SetShutdown(GRPC_ERROR_REF(why))) {
+    if (!releasing_fd) {
+      shutdown(fd->fd, SHUT_RDWR);
+    } else {
+      fd_disarm_all(fd);
+    }
+    fd->write_closure->SetShutdown(GRPC_ERROR_REF(why));
+    fd->error_closure->SetShutdown(GRPC_ERROR_REF(why));
+  }
+  GRPC_ERROR_UNREF(why);
+}
+
+/* Might be called multiple times */
+static void fd_shutdown(grpc_fd* fd, grpc_error_handle why) {
+  fd_shutdown_internal(fd, why, false);
+}
+
+static void fd_orphan(grpc_fd* fd, grpc_closure* on_done, int* release_fd,
+                      const char* reason) {
+  grpc_error_handle error = GRPC_ERROR_NONE;
+  bool is_release_fd = (release_fd != nullptr);
+
+  if (!fd->read_closure->IsShutdown()) {
+    fd_shutdown_internal(fd, GRPC_ERROR_CREATE_FROM_COPIED_STRING(reason),
+                         is_release_fd);
+  }
+  /* Outstanding poll requests hold a reference to the underlying file, so they
+     must be cancelled even when the fd is closed */
+  fd_disarm_all(fd);
+  /* Their completions may still be on their way: make sure they are not taken
+     for completions of requests made by the next user of this grpc_fd */
+  gpr_atm_rel_store(&fd->generation,
+                    (gpr_atm_no_barrier_load(&fd->generation) + 1) & 0xff);
+
+  /* If release_fd is not NULL, we should be relinquishing control of the file
+     descriptor fd->fd (but we still own the grpc_fd structure). */
+  if (is_release_fd) {
+    *release_fd = fd->fd;
+  } else {
+    close(fd->fd);
+  }
+
+  grpc_core::ExecCtx::Run(DEBUG_LOCATION, on_done, GRPC_ERROR_REF(error));
+
+  grpc_iomgr_unregister_object(&fd->iomgr_object);
+  fork_fd_list_remove_grpc_fd(fd);
+  fd->read_closure->DestroyEvent();
+  fd->write_closure->DestroyEvent();
+  fd->error_closure->DestroyEvent();
+
+  gpr_mu_lock(&fd_freelist_mu);
+  fd->freelist_next = fd_freelist;
+  fd_freelist = fd;
+  gpr_mu_unlock(&fd_freelist_mu);
+}
+
+static bool fd_is_shutdown(grpc_fd* fd) {
+  return fd->read_closure->IsShutdown();
+}
+
+static void fd_notify_on_read(grpc_fd* fd, grpc_closure* closure) {
+  fd->read_closure->NotifyOn(closure);
+  if (!fd->read_closure->IsShutdown()) fd_arm(fd, POLL_KIND_READ);
+}
+
+static void fd_notify_on_write(grpc_fd* fd, grpc_closure* closure) {
+  fd->write_closure->NotifyOn(closure);
+  if (!fd->write_closure->IsShutdown()) fd_arm(fd, POLL_KIND_WRITE);
+}
+
+static void fd_notify_on_error(grpc_fd* fd, grpc_closure* closure) {
+  fd->error_closure->NotifyOn(closure);
+  if (!fd->error_closure->IsShutdown()) fd_arm(fd, POLL_KIND_ERROR);
+}
+
+static void fd_become_readable(grpc_fd* fd) { fd->read_closure->SetReady(); }
+
+static void fd_become_writable(grpc_fd* fd) { fd->write_closure->SetReady(); }
+
+static void fd_has_errors(grpc_fd* fd) { fd->error_closure->SetReady(); }
+
+/*******************************************************************************
+ * Pollset Definitions
+ */
+
+/* Process the completions reaped by do_ring_wait() function.
+   - g_ring.cursor points to the index of the first event to be processed
+   - This function then processes up-to MAX_RING_EVENTS_HANDLED_PER_ITERATION
+     and updates the g_ring.cursor
+
+   NOTE ON SYNCRHONIZATION: Similar to do_ring_wait(), this function is only
+   called by g_active_poller thread. So there is no need for synchronization
+   when accessing the events array */
+static grpc_error_handle process_ring_events(grpc_pollset* /*pollset*/) {
+  GPR_TIMER_SCOPE("process_ring_events", 0);
+
+  static const char* err_desc = "process_events";
+  grpc_error_handle error = GRPC_ERROR_NONE;
+  long num_events = gpr_atm_acq_load(&g_ring.num_events);
+  long cursor = gpr_atm_acq_load(&g_ring.cursor);
+  for (int idx = 0;
+       (idx < MAX_RING_EVENTS_HANDLED_PER_ITERATION) && cursor != num_events;
+       idx++) {
+    long c = cursor++;
+    ring_event* ev = &g_ring.events[c];
+    if (ev->user_data == 0) {
+      /* completion of a poll removal */
+      continue;
+    }
+    grpc_wakeup_fd* wakeup_fd = grpc_turnstile_wakeup_fd();
+    if (ev->user_data == reinterpret_cast<uint64_t>(wakeup_fd)) {
+      append_error(&error, grpc_wakeup_fd_consume_wakeup(wakeup_fd), err_desc);
+      ring_queue_poll(wakeup_fd->read_fd, POLLIN, ev->user_data, false);
+      continue;
+    }
+
+    grpc_fd* fd = reinterpret_cast<grpc_fd*>(ev->user_data &
+                                             USER_DATA_ADDRESS_MASK);
+    /* The request was made before the grpc_fd was orphaned: it may have been
+       recycled since, so don't touch it. The grpc_fd itself is never freed
+       while the engine runs, so reading its generation is safe. */
+    if ((ev->user_data >> USER_DATA_GENERATION_SHIFT) !=
+        static_cast<uint64_t>(gpr_atm_acq_load(&fd->generation))) {
+      continue;
+    }
+    /* The request was cancelled by fd_disarm_all() because the fd is being
+       released: there is nothing to report */
+    if (ev->res == -ECANCELED) continue;
+
+    poll_kind kind =
+        static_cast<poll_kind>(ev->user_data & USER_DATA_KIND_MASK);
+    bool track_err = (ev->user_data & USER_DATA_TRACK_ERR) != 0;
+    fd_disarm(fd, kind);
+
+    uint32_t revents = ev->res < 0 ? static_cast<uint32_t>(POLLERR)
+                                   : static_cast<uint32_t>(ev->res);
+    bool cancel = (revents & POLLHUP) != 0;
+    bool error = (revents & POLLERR) != 0;
+    bool read_ev = (revents & (POLLIN | POLLPRI)) != 0;
+    bool write_ev = (revents & POLLOUT) != 0;
+    bool err_fallback = error && !track_err;
+
+    if (error && !err_fallback) {
+      fd_has_errors(fd);
+    }
+
+    switch (kind) {
+      case POLL_KIND_READ:
+        if (read_ev || cancel || err_fallback) {
+          fd_become_readable(fd);
+        } else {
+          /* Only the error queue is readable: unlike an edge-triggered epoll
+             registration, a one-shot poll is gone once it fires, so re-arm it
+             for the reader that is still waiting */
+          fd_arm(fd, POLL_KIND_READ);
+        }
+        break;
+      case POLL_KIND_WRITE:
+        if (write_ev || cancel || err_fallback) {
+          fd_become_writable(fd);
+        } else {
+          fd_arm(fd, POLL_KIND_WRITE);
+        }
+        break;
+      case POLL_KIND_ERROR:
+        if (cancel || err_fallback) {
+          fd_become_readable(fd);
+          fd_become_writable(fd);
+        }
+        break;
+      case POLL_KIND_WAKEUP:
+        GPR_UNREACHABLE_CODE(break);
+    }
+  }
+  gpr_atm_rel_store(&g_ring.cursor, cursor);
+  return error;
+}
+
+/* Copies up to MAX_RING_EVENTS completions out of the completion queue and
+   stores them in g_ring.events. Anything left in the completion queue is
+   picked up by the next call. */
+static int reap_completions() {
+  unsigned head = *g_ring.cq_head;
+  unsigned tail = __atomic_load_n(g_ring.cq_tail, __ATOMIC_ACQUIRE);
+  int n = 0;
+  while (head != tail && n < MAX_RING_EVENTS) {
+    struct io_uring_cqe* cqe = &g_ring.cqes[head & g_ring.cq_mask];
+    g_ring.events[n].user_data = cqe->user_data;
+    g_ring.events[n].res = cqe->res;
+    n++;
+    head++;
+  }
+  __atomic_store_n(g_ring.cq_head, head, __ATOMIC_RELEASE);
+  return n;
+}
+
+/* Submits every queued poll request and waits for at least one completion
+   (or the deadline), all in a single io_uring_enter() call. The completions
+   are then stored in g_ring.events; they are "processed" in
+   process_ring_events(). If some requests are still backlogged because the
+   kernel would not take them, it does not wait: reaping completions is what
+   lets the kernel take requests again.
+
+   NOTE ON SYNCHRONIZATION: At any point of time, only the g_active_poller
+   (i.e the designated poller thread) will be calling this function. So there is
+   no need for any synchronization when accesing the completion queue */
+static grpc_error_handle do_ring_wait(grpc_pollset* ps, grpc_millis deadline) {
+  GPR_TIMER_SCOPE("do_ring_wait", 0);
+
+  int timeout = grpc_turnstile_deadline_to_millis_timeout(deadline);
+  int r = reap_completions();
+  if (r == 0) {
+    struct __kernel_timespec ts;
+    struct io_uring_getevents_arg arg;
+    memset(&arg, 0, sizeof(arg));
+    arg.sigmask_sz = _NSIG / 8;
+    if (timeout >= 0) {
+      ts.tv_sec = timeout / GPR_MS_PER_SEC;
+      ts.tv_nsec = (timeout % GPR_MS_PER_SEC) * GPR_NS_PER_MS;
+      arg.ts = reinterpret_cast<uint64_t>(&ts);
+    }
+    if (timeout != 0) {
+      GRPC_SCHEDULING_START_BLOCKING_REGION;
+    }
+    int enter_r;
+    do {
+      gpr_mu_lock(&g_ring.sq_mu);
+      bool backlogged = !ring_flush_backlog_locked();
+      unsigned to_submit = ring_sq_pending_locked();
+      g_ring.poller_in_kernel = true;
+      gpr_mu_unlock(&g_ring.sq_mu);
+      GRPC_STATS_INC_SYSCALL_POLL();
+      enter_r = sys_io_uring_enter(
+          g_ring.ring_fd, to_submit, timeout == 0 || backlogged ? 0 : 1,
+          IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG, &arg, sizeof(arg));
+      gpr_mu_lock(&g_ring.sq_mu);
+      g_ring.poller_in_kernel = false;
+      gpr_mu_unlock(&g_ring.sq_mu);
+    } while (enter_r < 0 && errno == EINTR);
+    if (timeout != 0) {
+      GRPC_SCHEDULING_END_BLOCKING_REGION;
+    }
+
+    if (enter_r < 0 && errno != ETIME && errno != EBUSY && errno != EAGAIN) {
+      return GRPC_OS_ERROR(errno, "io_uring_enter");
+    }
+    r = reap_completions();
+  }
+
+  GRPC_STATS_INC_POLL_EVENTS_RETURNED(r);
+
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
+    gpr_log(GPR_INFO, "ps: %p poll got %d events", ps, r);
+  }
+
+  gpr_atm_rel_store(&g_ring.num_events, r);
+  gpr_atm_rel_store(&g_ring.cursor, 0);
+
+  return GRPC_ERROR_NONE;
+}
+
+static bool ring_has_pending_events(void) {
+  return gpr_atm_acq_load(&g_ring.cursor) !=
+         gpr_atm_acq_load(&g_ring.num_events);
+}
+
+static const grpc_turnstile_poller ring_poller = {
+    ring_has_pending_events, do_ring_wait, process_ring_events};
+
+static grpc_error_handle pollset_global_init(void) {
+  grpc_error_handle err = grpc_turnstile_pollset_global_init(&ring_poller);
+  if (err != GRPC_ERROR_NONE) return err;
+  grpc_wakeup_fd* wakeup_fd = grpc_turnstile_wakeup_fd();
+  ring_queue_poll(wakeup_fd->read_fd, POLLIN,
+                  reinterpret_cast<uint64_t>(wakeup_fd), false);
+  return GRPC_ERROR_NONE;
+}
+
+/*******************************************************************************
+ * Event engine binding
+ */
+
+static bool is_any_background_poller_thread(void) { return false; }
+
+static void shutdown_background_closure(void) {}
+
+static bool add_closure_to_background_poller(grpc_closure* /*closure*/,
+                                             grpc_error_handle /*error*/) {
+  return false;
+}
+
+static void shutdown_engine(void) {
+  fd_global_shutdown();
+  grpc_turnstile_pollset_global_shutdown();
+  ring_shutdown();
+  if (grpc_core::Fork::Enabled()) {
+    gpr_mu_destroy(&fork_fd_list_mu);
+    grpc_core::Fork::SetResetChildPollingEngineFunc(nullptr);
+  }
+}
+
+static const grpc_event_engine_vtable vtable = {
+    sizeof(grpc_pollset),
+    true,
+    false,
+
+    fd_create,
+    fd_wrapped_fd,
+    fd_orphan,
+    fd_shutdown,
+    fd_notify_on_read,
+    fd_notify_on_write,
+    fd_notify_on_error,
+    fd_become_readable,
+    fd_become_writable,
+    fd_has_errors,
+    fd_is_shutdown,
+
+    grpc_turnstile_pollset_init,
+    grpc_turnstile_pollset_shutdown,
+    grpc_turnstile_pollset_destroy,
+    grpc_turnstile_pollset_work,
+    grpc_turnstile_pollset_kick,
+    grpc_turnstile_pollset_add_fd,
+
+    grpc_turnstile_pollset_set_create,
+    grpc_turnstile_pollset_set_destroy,
+    grpc_turnstile_pollset_set_add_pollset,
+    grpc_turnstile_pollset_set_del_pollset,
+    grpc_turnstile_pollset_set_add_pollset_set,
+    grpc_turnstile_pollset_set_del_pollset_set,
+    grpc_turnstile_pollset_set_add_fd,
+    grpc_turnstile_pollset_set_del_fd,
+
+    is_any_background_poller_thread,
+    shutdown_background_closure,
+    shutdown_engine,
+    add_closure_to_background_poller,
+};
+
+/* Called by the child process's post-fork handler to close open fds, including
+ * the io_uring fd. This allows gRPC to shutdown in the child process without
+ * interfering with connections or RPCs ongoing in the parent. */
+static void reset_event_manager_on_fork() {
+  gpr_mu_lock(&fork_fd_list_mu);
+  while (fork_fd_list_head != nullptr) {
+    close(fork_fd_list_head->fd);
+    fork_fd_list_head->fd = -1;
+    fork_fd_list_head = fork_fd_list_head->fork_fd_list->next;
+  }
+  gpr_mu_unlock(&fork_fd_list_mu);
+  shutdown_engine();
+  grpc_init_io_uring_linux(true);
+}
+
+/* The headers may know about io_uring while the running kernel doesn't (or
+ * has it disabled). ring_init() creates the ring to make sure the features we
+ * depend on are available. This engine is never picked implicitly: it has to
+ * be requested by name through GRPC_POLL_STRATEGY. */
+const grpc_event_engine_vtable* grpc_init_io_uring_linux(
+    bool explicit_request) {
+  if (!explicit_request) {
+    return nullptr;
+  }
+
+  if (!grpc_has_wakeup_fd()) {
+    gpr_log(GPR_ERROR, "Skipping io_uring because of no wakeup fd.");
+    return nullptr;
+  }
+
+  if (!ring_init()) {
+    return nullptr;
+  }
+
+  fd_global_init();
+
+  if (!GRPC_LOG_IF_ERROR("pollset_global_init", pollset_global_init())) {
+    fd_global_shutdown();
+    ring_shutdown();
+    return nullptr;
+  }
+
+  if (grpc_core::Fork::Enabled()) {
+    gpr_mu_init(&fork_fd_list_mu);
+    grpc_core::Fork::SetResetChildPollingEngineFunc(
+        reset_event_manager_on_fork);
+  }
+  return &vtable;
+}
+
+#else /* defined(__NR_io_uring_setup) && defined(IORING_FEAT_EXT_ARG) */
+/* The kernel headers are too old for the features this engine relies on */
+const grpc_event_engine_vtable* grpc_init_io_uring_linux(
+    bool /*explicit_request*/) {
+  return nullptr;
+}
+#endif /* defined(__NR_io_uring_setup) && defined(IORING_FEAT_EXT_ARG) */
+
+#else /* defined(GRPC_LINUX_IO_URING) */
+#if defined(GRPC_POSIX_SOCKET_EV_IO_URING)
+#include "src/core/lib/iomgr/ev_io_uring_linux.h"
+/* If GRPC_LINUX_IO_URING is not defined, it means io_uring is not available.
+ * Return NULL */
+const grpc_event_engine_vtable* grpc_init_io_uring_linux(
+    bool /*explicit_request*/) {
+  return nullptr;
+}
+#endif /* defined(GRPC_POSIX_SOCKET_EV_IO_URING) */
+#endif /* !defined(GRPC_LINUX_IO_URING) */
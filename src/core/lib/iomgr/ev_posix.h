@@ -31,6 +31,7 @@
 #include "src/core/lib/iomgr/wakeup_fd_posix.h"
 
 GPR_GLOBAL_CONFIG_DECLARE_STRING(grpc_poll_strategy);
+GPR_GLOBAL_CONFIG_DECLARE_INT32(grpc_busy_poll_us);
 
 extern grpc_core::DebugOnlyTraceFlag grpc_fd_trace; /* Disabled by default */
 extern grpc_core::DebugOnlyTraceFlag
@@ -115,6 +116,18 @@ bool grpc_event_engine_can_track_errors();
  */
 bool grpc_event_engine_run_in_background();
 
+/* Returns the busy polling budget in microseconds (GRPC_BUSY_POLL_US), or 0
+ * if busy polling is disabled. Pollers that support it spin for up to this
+ * long before sleeping, and accepted server sockets get SO_BUSY_POLL set to
+ * it.
+ */
+int grpc_event_engine_busy_poll_us();
+
+/* Overrides the busy polling budget configured through GRPC_BUSY_POLL_US.
+ * Takes effect from the next poll, and for sockets accepted afterwards.
+ */
+void grpc_event_engine_set_busy_poll_us(int usec);
+
 /* Create a wrapped file descriptor.
    Requires fd is a non-blocking file descriptor.
    \a track_err if true means that error events would be tracked separately
@@ -151,7 +151,8 @@ grpc_endpoint_vtable grpc_event_engine_endpoint_vtable = {
     endpoint_get_peer,
     endpoint_get_local_address,
     endpoint_get_fd,
-    endpoint_can_track_err};
+    endpoint_can_track_err,
+    nullptr};
 
 }  // namespace
 
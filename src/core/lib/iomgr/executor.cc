@@ -35,6 +35,11 @@
 
 #define MAX_DEPTH 2
 
+GPR_GLOBAL_CONFIG_DEFINE_STRING(
+    grpc_executor_impl, "threads",
+    "Executor implementation to use: threads (a closure list per thread) or "
+    "work_stealing (a work-stealing deque per thread).")
+
 #define EXECUTOR_TRACE(format, ...)                       \
   do {                                                    \
     if (GRPC_TRACE_FLAG_ENABLED(executor_trace)) {        \
@@ -78,6 +83,16 @@ void resolver_enqueue_long(grpc_closure* closure, grpc_error_handle error) {
 
 using EnqueueFunc = void (*)(grpc_closure* closure, grpc_error_handle error);
 
+bool UseWorkStealingPool() {
+  grpc_core::UniquePtr<char> value = GPR_GLOBAL_CONFIG_GET(grpc_executor_impl);
+  if (strcmp(value.get(), "work_stealing") == 0) return true;
+  if (strcmp(value.get(), "threads") != 0) {
+    gpr_log(GPR_ERROR, "Unknown executor implementation '%s', using threads",
+            value.get());
+  }
+  return false;
+}
+
 const EnqueueFunc
     executor_enqueue_fns_[static_cast<size_t>(ExecutorType::NUM_EXECUTORS)]
                          [static_cast<size_t>(ExecutorJobType::NUM_JOB_TYPES)] =
@@ -147,6 +162,12 @@ void Executor::SetThreading(bool threading) {
     }
 
     GPR_ASSERT(num_threads_ == 0);
+    if (UseWorkStealingPool()) {
+      pool_ = new WorkStealingThreadPool(name_, max_threads_);
+      gpr_atm_rel_store(&num_threads_, 1);
+      EXECUTOR_TRACE("(%s) SetThreading(%d) done", name_, threading);
+      return;
+    }
     gpr_atm_rel_store(&num_threads_, 1);
     thd_state_ = static_cast<ThreadState*>(
         gpr_zalloc(sizeof(ThreadState) * max_threads_));
@@ -169,6 +190,18 @@ void Executor::SetThreading(bool threading) {
       return;
     }
 
+    if (pool_ != nullptr) {
+      pool_->Shutdown();
+      // The closures left in the pool run on this thread, and any they
+      // enqueue go to its ExecCtx, as below.
+      gpr_atm_rel_store(&num_threads_, 0);
+      delete pool_;
+      pool_ = nullptr;
+      grpc_iomgr_platform_shutdown_background_closure();
+      EXECUTOR_TRACE("(%s) SetThreading(%d) done", name_, threading);
+      return;
+    }
+
     for (size_t i = 0; i < max_threads_; i++) {
       gpr_mu_lock(&thd_state_[i].mu);
       thd_state_[i].shutdown = true;
@@ -276,6 +309,19 @@ void Executor::Enqueue(grpc_closure* closure, grpc_error_handle error,
       return;
     }
 
+    if (pool_ != nullptr) {
+#ifndef NDEBUG
+      EXECUTOR_TRACE("(%s) schedule %p (%s) (created %s:%d) to pool", name_,
+                     closure, is_short ? "short" : "long",
+                     closure->file_created, closure->line_created);
+#else
+      EXECUTOR_TRACE("(%s) schedule %p (%s) to pool", name_, closure,
+                     is_short ? "short" : "long");
+#endif
+      pool_->Add(closure, error, is_short);
+      return;
+    }
+
     ThreadState* ts = g_this_thread_state;
     if (ts == nullptr) {
       ts = &thd_state_[grpc_core::HashPointer(grpc_core::ExecCtx::Get(),
@@ -22,8 +22,14 @@
 #include <grpc/support/port_platform.h>
 
 #include "src/core/lib/gpr/spinlock.h"
+#include "src/core/lib/gprpp/global_config.h"
 #include "src/core/lib/gprpp/thd.h"
 #include "src/core/lib/iomgr/closure.h"
+#include "src/core/lib/iomgr/executor/work_stealing_pool.h"
+
+// Executor implementation: "threads" or "work_stealing". Read when an
+// executor starts its threads.
+GPR_GLOBAL_CONFIG_DECLARE_STRING(grpc_executor_impl);
 
 namespace grpc_core {
 
@@ -108,6 +114,8 @@ class Executor {
   static void ThreadMain(void* arg);
 
   const char* name_;
+  // Set instead of thd_state_ when GRPC_EXECUTOR_IMPL is work_stealing.
+  WorkStealingThreadPool* pool_ = nullptr;
   ThreadState* thd_state_;
   size_t max_threads_;
   gpr_atm num_threads_;
@@ -0,0 +1,320 @@
+/*
+ *
+ * Copyright 2021 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/iomgr/executor/work_stealing_pool.h"
+
+#include <algorithm>
+
+#include <grpc/support/log.h>
+
+#include "src/core/lib/gpr/tls.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+
+namespace grpc_core {
+
+namespace {
+
+// Every kSharedQueueInterval closures, a thread takes from the shared queue
+// before its own.
+constexpr uint32_t kSharedQueueInterval = 61;
+// A thread runs at most kMaxLifoRuns closures in a row from its LIFO slot.
+constexpr uint32_t kMaxLifoRuns = 3;
+
+GPR_THREAD_LOCAL(void*) g_current_worker;
+
+}  // namespace
+
+//
+// WorkStealingDeque
+//
+
+WorkStealingDeque::WorkStealingDeque() {
+  for (size_t i = 0; i < kCapacity; i++) {
+    buffer_[i].store(nullptr, std::memory_order_relaxed);
+  }
+}
+
+bool WorkStealingDeque::Push(grpc_closure* closure) {
+  int64_t b = bottom_.load(std::memory_order_relaxed);
+  int64_t t = top_.load(std::memory_order_acquire);
+  if (b - t >= static_cast<int64_t>(kCapacity)) return false;
+  buffer_[b & (kCapacity - 1)].store(closure, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  bottom_.store(b + 1, std::memory_order_relaxed);
+  return true;
+}
+
+grpc_closure* WorkStealingDeque::Pop() {
+  int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+  bottom_.store(b, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  int64_t t = top_.load(std::memory_order_relaxed);
+  if (t > b) {
+    // Empty.
+    bottom_.store(b + 1, std::memory_order_relaxed);
+    return nullptr;
+  }
+  grpc_closure* closure =
+      buffer_[b & (kCapacity - 1)].load(std::memory_order_relaxed);
+  if (t == b) {
+    // Last closure: race thieves for it.
+    if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                      std::memory_order_relaxed)) {
+      closure = nullptr;
+    }
+    bottom_.store(b + 1, std::memory_order_relaxed);
+  }
+  return closure;
+}
+
+grpc_closure* WorkStealingDeque::Steal() {
+  int64_t t = top_.load(std::memory_order_acquire);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  int64_t b = bottom_.load(std::memory_order_acquire);
+  if (t >= b) return nullptr;
+  grpc_closure* closure =
+      buffer_[t & (kCapacity - 1)].load(std::memory_order_relaxed);
+  if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                    std::memory_order_relaxed)) {
+    return nullptr;
+  }
+  return closure;
+}
+
+bool WorkStealingDeque::Empty() const {
+  return bottom_.load(std::memory_order_relaxed) <=
+         top_.load(std::memory_order_relaxed);
+}
+
+//
+// WorkStealingThreadPool
+//
+
+WorkStealingThreadPool::WorkStealingThreadPool(const char* name,
+                                               size_t max_threads)
+    : name_(name),
+      max_threads_(std::max<size_t>(1, max_threads)),
+      workers_(new Worker[max_threads_]) {
+  for (size_t i = 0; i < max_threads_; i++) {
+    workers_[i].pool = this;
+    workers_[i].rng = static_cast<uint32_t>(i) * 2654435761u + 1;
+  }
+  StartThread();
+}
+
+WorkStealingThreadPool::~WorkStealingThreadPool() {
+  GPR_ASSERT(shutdown_.load(std::memory_order_relaxed));
+  for (size_t i = 0; i < max_threads_; i++) {
+    Worker* w = &workers_[i];
+    grpc_closure* closure = w->lifo.exchange(nullptr);
+    if (closure != nullptr) RunClosure(closure);
+    while ((closure = w->deque.Pop()) != nullptr) RunClosure(closure);
+  }
+  grpc_closure* closure;
+  while ((closure = PopShared()) != nullptr) RunClosure(closure);
+  delete[] workers_;
+}
+
+void WorkStealingThreadPool::Shutdown() {
+  {
+    MutexLock lock(&mu_);
+    shutdown_.store(true, std::memory_order_relaxed);
+    cv_.SignalAll();
+  }
+  // Once this is past, no thread is being started or will be.
+  gpr_spinlock_lock(&adding_thread_lock_);
+  gpr_spinlock_unlock(&adding_thread_lock_);
+  size_t n = num_threads_.load(std::memory_order_acquire);
+  for (size_t i = 0; i < n; i++) {
+    workers_[i].thd.Join();
+  }
+}
+
+void WorkStealingThreadPool::Add(grpc_closure* closure,
+                                 grpc_error_handle error, bool is_short) {
+  closure->error_data.error = error;
+  Worker* self = static_cast<Worker*>(g_current_worker);
+  if (is_short && self != nullptr && self->pool == this) {
+    closure = self->lifo.exchange(closure, std::memory_order_acq_rel);
+    if (closure != nullptr && !self->deque.Push(closure)) PushShared(closure);
+  } else {
+    // Long closures always go to the shared queue, so they never sit behind
+    // the closure running on this thread.
+    PushShared(closure);
+  }
+  // Even a closure left in the LIFO slot may need another thread: the one
+  // running now may block.
+  WakeOrStartThread();
+}
+
+void WorkStealingThreadPool::PushShared(grpc_closure* closure) {
+  MutexLock lock(&shared_mu_);
+  closure->next_data.next = nullptr;
+  if (shared_queue_.head == nullptr) {
+    shared_queue_.head = closure;
+  } else {
+    shared_queue_.tail->next_data.next = closure;
+  }
+  shared_queue_.tail = closure;
+  shared_size_.fetch_add(1, std::memory_order_relaxed);
+}
+
+grpc_closure* WorkStealingThreadPool::PopShared() {
+  if (shared_size_.load(std::memory_order_relaxed) == 0) return nullptr;
+  MutexLock lock(&shared_mu_);
+  grpc_closure* closure = shared_queue_.head;
+  if (closure == nullptr) return nullptr;
+  shared_queue_.head = closure->next_data.next;
+  if (shared_queue_.head == nullptr) shared_queue_.tail = nullptr;
+  shared_size_.fetch_sub(1, std::memory_order_relaxed);
+  return closure;
+}
+
+void WorkStealingThreadPool::WakeOrStartThread() {
+  // Pairs with the fence in ThreadMain(): either this sees the parking thread
+  // in idle_, or that thread sees the closure just added.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (idle_.load(std::memory_order_relaxed) > 0) {
+    MutexLock lock(&mu_);
+    cv_.Signal();
+    return;
+  }
+  if (num_threads_.load(std::memory_order_relaxed) < max_threads_ &&
+      gpr_spinlock_trylock(&adding_thread_lock_)) {
+    if (!shutdown_.load(std::memory_order_relaxed) &&
+        num_threads_.load(std::memory_order_relaxed) < max_threads_) {
+      StartThread();
+    }
+    gpr_spinlock_unlock(&adding_thread_lock_);
+  }
+}
+
+void WorkStealingThreadPool::StartThread() {
+  size_t n = num_threads_.load(std::memory_order_relaxed);
+  workers_[n].thd = Thread(name_, &ThreadMain, &workers_[n]);
+  // Publish the worker before it can be stolen from.
+  num_threads_.store(n + 1, std::memory_order_release);
+  workers_[n].thd.Start();
+}
+
+grpc_closure* WorkStealingThreadPool::FindWork(Worker* worker) {
+  grpc_closure* closure;
+  // Now and then look at the shared queue first, so that closures added from
+  // outside the pool are not starved by closures the pool keeps adding.
+  if (++worker->ticks % kSharedQueueInterval == 0) {
+    closure = PopShared();
+    if (closure != nullptr) return closure;
+  }
+  // Limit how many closures in a row come from the LIFO slot, so that a
+  // closure that keeps adding itself does not starve the rest.
+  if (worker->lifo_runs < kMaxLifoRuns) {
+    closure = worker->lifo.exchange(nullptr, std::memory_order_acq_rel);
+    if (closure != nullptr) {
+      worker->lifo_runs++;
+      return closure;
+    }
+  }
+  worker->lifo_runs = 0;
+  // The owner takes from its own deque in FIFO order too.
+  closure = worker->deque.Steal();
+  if (closure != nullptr) return closure;
+  closure = PopShared();
+  if (closure != nullptr) return closure;
+  closure = worker->lifo.exchange(nullptr, std::memory_order_acq_rel);
+  if (closure != nullptr) return closure;
+  return Steal(worker);
+}
+
+grpc_closure* WorkStealingThreadPool::Steal(Worker* worker) {
+  size_t n = num_threads_.load(std::memory_order_acquire);
+  // A steal can fail only because the victim's deque is empty or because
+  // another thread won its top closure; retry while that may hide work.
+  bool retry = true;
+  while (retry) {
+    retry = false;
+    worker->rng = worker->rng * 1103515245 + 12345;
+    size_t start = (worker->rng >> 16) % n;
+    for (size_t i = 0; i < n; i++) {
+      Worker* victim = &workers_[(start + i) % n];
+      if (victim == worker) continue;
+      grpc_closure* closure = victim->deque.Steal();
+      if (closure != nullptr) return closure;
+      if (!victim->deque.Empty()) retry = true;
+      // The victim may be stuck in a long closure: don't let the closure in
+      // its LIFO slot wait on it.
+      if (victim->lifo.load(std::memory_order_relaxed) != nullptr) {
+        closure = victim->lifo.exchange(nullptr, std::memory_order_acq_rel);
+        if (closure != nullptr) return closure;
+      }
+    }
+  }
+  return nullptr;
+}
+
+bool WorkStealingThreadPool::HasWork() {
+  if (shared_size_.load(std::memory_order_relaxed) > 0) return true;
+  size_t n = num_threads_.load(std::memory_order_acquire);
+  for (size_t i = 0; i < n; i++) {
+    if (!workers_[i].deque.Empty() ||
+        workers_[i].lifo.load(std::memory_order_relaxed) != nullptr) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void WorkStealingThreadPool::RunClosure(grpc_closure* closure) {
+  // As in the executor, this is where application callbacks may start being
+  // queued: run them after each closure, so none waits behind the rest.
+  ApplicationCallbackExecCtx callback_exec_ctx(
+      GRPC_APP_CALLBACK_EXEC_CTX_FLAG_IS_INTERNAL_THREAD);
+  grpc_error_handle error = closure->error_data.error;
+#ifndef NDEBUG
+  closure->scheduled = false;
+#endif
+  closure->cb(closure->cb_arg, error);
+  GRPC_ERROR_UNREF(error);
+  ExecCtx::Get()->Flush();
+}
+
+void WorkStealingThreadPool::ThreadMain(void* arg) {
+  Worker* worker = static_cast<Worker*>(arg);
+  WorkStealingThreadPool* pool = worker->pool;
+  g_current_worker = worker;
+  ExecCtx exec_ctx(GRPC_EXEC_CTX_FLAG_IS_INTERNAL_THREAD);
+  while (!pool->shutdown_.load(std::memory_order_relaxed)) {
+    grpc_closure* closure = pool->FindWork(worker);
+    if (closure != nullptr) {
+      RunClosure(closure);
+      continue;
+    }
+    MutexLock lock(&pool->mu_);
+    pool->idle_.fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!pool->HasWork() && !pool->shutdown_.load(std::memory_order_relaxed)) {
+      pool->cv_.Wait(&pool->mu_);
+      ExecCtx::Get()->InvalidateNow();
+    }
+    pool->idle_.fetch_sub(1, std::memory_order_relaxed);
+  }
+  g_current_worker = nullptr;
+}
+
+}  // namespace grpc_core
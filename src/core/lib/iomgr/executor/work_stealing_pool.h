@@ -0,0 +1,147 @@
+/*
+ *
+ * Copyright 2021 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPC_CORE_LIB_IOMGR_EXECUTOR_WORK_STEALING_POOL_H
+#define GRPC_CORE_LIB_IOMGR_EXECUTOR_WORK_STEALING_POOL_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+
+#include "src/core/lib/gpr/spinlock.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/gprpp/thd.h"
+#include "src/core/lib/iomgr/closure.h"
+
+namespace grpc_core {
+
+// A bounded work-stealing deque of closures (Chase-Lev), following the C11
+// formulation of "Correct and Efficient Work-Stealing for Weak Memory Models"
+// (Le et al., PPoPP 2013). The owning thread pushes and pops at the bottom in
+// LIFO order; any thread may steal from the top in FIFO order.
+class WorkStealingDeque {
+ public:
+  static constexpr size_t kCapacity = 256;  // a power of two
+
+  WorkStealingDeque();
+
+  WorkStealingDeque(const WorkStealingDeque&) = delete;
+  WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+  // Owner only. Returns false, leaving the deque unchanged, if it is full.
+  bool Push(grpc_closure* closure);
+  // Owner only. Returns nullptr if the deque is empty.
+  grpc_closure* Pop();
+  // Any thread. Returns nullptr if the deque is empty, or if another thread
+  // took the top closure first.
+  grpc_closure* Steal();
+  // Any thread. Only a hint unless called by the owner.
+  bool Empty() const;
+
+ private:
+  // Stolen from by other threads; kept off the owner's cache line.
+  std::atomic<int64_t> top_{0};
+  char padding_[GPR_CACHELINE_SIZE];
+  std::atomic<int64_t> bottom_{0};
+  std::atomic<grpc_closure*> buffer_[kCapacity];
+};
+
+// A pool of threads running closures, with a work-stealing deque per thread.
+//
+// Closures added from outside the pool go to a shared queue. Short closures
+// added by a closure running on the pool stay on that thread: the newest one
+// waits in a LIFO slot, to be run next while its data is still in cache, and
+// the ones it displaces go to the thread's deque, which the thread runs in
+// FIFO order. Threads with nothing to run take from the shared queue, then
+// steal from the others (deques and LIFO slots), and park only once all of
+// them are empty, so no closure waits behind a long-running one for longer
+// than it takes another thread to steal it.
+//
+// The pool starts one thread, and starts another (up to max_threads) whenever
+// work is added while none are parked.
+class WorkStealingThreadPool {
+ public:
+  WorkStealingThreadPool(const char* name, size_t max_threads);
+  // Runs the closures still queued after Shutdown() on the calling thread,
+  // which must have an ExecCtx.
+  ~WorkStealingThreadPool();
+
+  WorkStealingThreadPool(const WorkStealingThreadPool&) = delete;
+  WorkStealingThreadPool& operator=(const WorkStealingThreadPool&) = delete;
+
+  // Schedules closure to run with error (taking ownership of error). Closures
+  // added once Shutdown() has been called are run by the destructor.
+  void Add(grpc_closure* closure, grpc_error_handle error, bool is_short);
+
+  // Stops the threads once they finish the closures they are running, and
+  // joins them. Closures still queued are left for the destructor.
+  void Shutdown();
+
+  size_t num_threads() const {
+    return num_threads_.load(std::memory_order_acquire);
+  }
+
+ private:
+  struct Worker {
+    WorkStealingThreadPool* pool;
+    uint32_t rng;
+    uint32_t ticks = 0;
+    uint32_t lifo_runs = 0;
+    Thread thd;
+    // The most recent short closure added by this thread.
+    std::atomic<grpc_closure*> lifo{nullptr};
+    WorkStealingDeque deque;
+  };
+
+  static void ThreadMain(void* arg);
+  static void RunClosure(grpc_closure* closure);
+
+  void PushShared(grpc_closure* closure);
+  grpc_closure* PopShared();
+  grpc_closure* FindWork(Worker* worker);
+  grpc_closure* Steal(Worker* worker);
+  bool HasWork();
+  void WakeOrStartThread();
+  void StartThread();
+
+  const char* name_;
+  const size_t max_threads_;
+  Worker* workers_;
+  std::atomic<size_t> num_threads_{0};
+  gpr_spinlock adding_thread_lock_ = GPR_SPINLOCK_STATIC_INITIALIZER;
+
+  Mutex shared_mu_;
+  grpc_closure_list shared_queue_ ABSL_GUARDED_BY(shared_mu_) =
+      GRPC_CLOSURE_LIST_INIT;
+  std::atomic<size_t> shared_size_{0};
+
+  // Parking. A thread increments idle_ under mu_ and rechecks for work before
+  // waiting; Add() makes its closure visible before reading idle_, so one of
+  // the two always sees the other.
+  Mutex mu_;
+  CondVar cv_;
+  std::atomic<size_t> idle_{0};
+  std::atomic<bool> shutdown_{false};
+};
+
+}  // namespace grpc_core
+
+#endif /* GRPC_CORE_LIB_IOMGR_EXECUTOR_WORK_STEALING_POOL_H */
@@ -66,10 +66,11 @@ void grpc_prefork() {
   const char* poll_strategy_name = grpc_get_poll_strategy_name();
   if (poll_strategy_name == nullptr ||
       (strcmp(poll_strategy_name, "epoll1") != 0 &&
+       strcmp(poll_strategy_name, "io_uring") != 0 &&
        strcmp(poll_strategy_name, "poll") != 0)) {
     gpr_log(GPR_INFO,
-            "Fork support is only compatible with the epoll1 and poll polling "
-            "strategies");
+            "Fork support is only compatible with the epoll1, io_uring and "
+            "poll polling strategies");
   }
   if (!grpc_core::Fork::BlockExecCtx()) {
     gpr_log(GPR_INFO,
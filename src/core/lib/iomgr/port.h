@@ -52,6 +52,9 @@
 /* Linux has TCP_INQ support since 4.18, but it is safe to set
    the socket option on older kernels. */
 #define GRPC_HAVE_TCP_INQ 1
+/* Linux has TCP_ZEROCOPY_RECEIVE support since 4.18. On older kernels the
+   getsockopt fails and the endpoint falls back to copying reads. */
+#define GRPC_HAVE_TCP_ZEROCOPY_RECEIVE 1
 #ifdef LINUX_VERSION_CODE
 #if LINUX_VERSION_CODE >= KERNEL_VERSION(4, 0, 0)
 #define GRPC_LINUX_ERRQUEUE 1
@@ -87,6 +90,19 @@
 #define GRPC_LINUX_EVENTFD 1
 #define GRPC_MSG_IOVLEN_TYPE int
 #endif
+/* io_uring is only used if the kernel headers know about it; whether the
+   running kernel supports it is checked when the polling engine starts. */
+#if defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#define GRPC_LINUX_IO_URING 1
+#endif
+/* Kernel TLS is likewise keyed off the headers; a kernel without the tls
+   module rejects the TCP_ULP socket option and the connection keeps
+   encrypting in userspace. */
+#if __has_include(<linux/tls.h>)
+#define GRPC_LINUX_KTLS 1
+#endif
+#endif
 #ifndef GRPC_LINUX_EVENTFD
 #define GRPC_POSIX_NO_SPECIAL_WAKEUP_FD 1
 #endif
@@ -198,6 +214,7 @@
 #define GRPC_POSIX_SOCKET_EV_EPOLLEX 1
 #define GRPC_POSIX_SOCKET_EV_POLL 1
 #define GRPC_POSIX_SOCKET_EV_EPOLL1 1
+#define GRPC_POSIX_SOCKET_EV_IO_URING 1
 #define GRPC_POSIX_SOCKET_IF_NAMETOINDEX 1
 #define GRPC_POSIX_SOCKET_IOMGR 1
 #define GRPC_POSIX_SOCKET_RESOLVE_ADDRESS 1
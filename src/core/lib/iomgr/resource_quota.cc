@@ -35,6 +35,7 @@
 
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/gprpp/arena.h"
 #include "src/core/lib/iomgr/combiner.h"
 #include "src/core/lib/slice/slice_internal.h"
 
@@ -284,6 +285,9 @@ static void rq_step(void* rq, grpc_error_handle /*error*/) {
     if (rq_alloc(resource_quota)) goto done;
   } while (rq_reclaim_from_per_user_free_pool(resource_quota));
 
+  /* The quota is exhausted: give the storage cached for reuse by arenas back to
+     the system before asking users to reclaim memory */
+  grpc_core::Arena::TrimCache();
   if (!rq_reclaim(resource_quota, false)) {
     rq_reclaim(resource_quota, true);
   }
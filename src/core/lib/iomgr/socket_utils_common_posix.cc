@@ -231,6 +231,35 @@ bool grpc_is_socket_reuse_port_supported() {
   return g_support_so_reuseport;
 }
 
+#if GPR_LINUX == 1
+#ifndef SO_BUSY_POLL
+#define SO_BUSY_POLL 46
+#endif
+#ifndef SO_PREFER_BUSY_POLL
+#define SO_PREFER_BUSY_POLL 69
+#endif
+#endif  // GPR_LINUX == 1
+
+/* set SO_BUSY_POLL, and SO_PREFER_BUSY_POLL if supported */
+grpc_error_handle grpc_set_socket_busy_poll(int fd, int usec) {
+#ifdef SO_BUSY_POLL
+  if (0 != setsockopt(fd, SOL_SOCKET, SO_BUSY_POLL, &usec, sizeof(usec))) {
+    return GRPC_OS_ERROR(errno, "setsockopt(SO_BUSY_POLL)");
+  }
+#ifdef SO_PREFER_BUSY_POLL
+  /* Only in Linux 5.11+; busy polling still works without it, it merely lets
+     the interrupts of a busy polled queue be deferred. */
+  const int prefer = 1;
+  setsockopt(fd, SOL_SOCKET, SO_PREFER_BUSY_POLL, &prefer, sizeof(prefer));
+#endif
+  return GRPC_ERROR_NONE;
+#else
+  (void)fd;
+  (void)usec;
+  return GRPC_OS_ERROR(ENOSYS, "setsockopt(SO_BUSY_POLL)");
+#endif
+}
+
 /* disable nagle */
 grpc_error_handle grpc_set_socket_low_latency(int fd, int low_latency) {
   int val = (low_latency != 0);
@@ -65,6 +65,9 @@ grpc_error_handle grpc_set_socket_low_latency(int fd, int low_latency);
 /* set SO_REUSEPORT */
 grpc_error_handle grpc_set_socket_reuse_port(int fd, int reuse);
 
+/* set SO_BUSY_POLL to usec, and SO_PREFER_BUSY_POLL where the kernel has it */
+grpc_error_handle grpc_set_socket_busy_poll(int fd, int usec);
+
 /* Configure the default values for TCP_USER_TIMEOUT */
 void config_default_tcp_user_timeout(bool enable, int timeout, bool is_client);
 
@@ -343,7 +343,8 @@ static grpc_endpoint_vtable vtable = {endpoint_read,
                                       endpoint_get_peer,
                                       endpoint_get_local_address,
                                       endpoint_get_fd,
-                                      endpoint_can_track_err};
+                                      endpoint_can_track_err,
+                                      nullptr};
 
 grpc_endpoint* custom_tcp_endpoint_create(grpc_custom_socket* socket,
                                           grpc_slice_allocator* slice_allocator,
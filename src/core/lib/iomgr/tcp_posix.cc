@@ -30,11 +30,14 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
 #include <sys/socket.h>
 #include <sys/types.h>
 #include <unistd.h>
 
 #include <algorithm>
+#include <limits>
 #include <unordered_map>
 
 #include <grpc/slice.h>
@@ -70,6 +73,13 @@
 #define TCP_CM_INQ TCP_INQ
 #endif
 
+// TCP zero copy receive getsockopt.
+// NB: As with MSG_ZEROCOPY below, this is defined here in case the library
+// headers predate it; the value is part of the kernel ABI.
+#ifndef TCP_ZEROCOPY_RECEIVE
+#define TCP_ZEROCOPY_RECEIVE 35
+#endif
+
 #ifdef GRPC_HAVE_MSG_NOSIGNAL
 #define SENDMSG_FLAGS MSG_NOSIGNAL
 #else
@@ -347,23 +357,188 @@ class TcpZerocopySendCtx {
   bool memory_limited_ = false;
 };
 
+class TcpZerocopyReceiveCtx {
+ public:
+  static constexpr size_t kDefaultRecvBytesThreshold = 256 * 1024;  // 256KB
+
+  explicit TcpZerocopyReceiveCtx(
+      size_t recv_bytes_threshold = kDefaultRecvBytesThreshold)
+      : threshold_bytes_(recv_bytes_threshold),
+        page_size_(static_cast<size_t>(sysconf(_SC_PAGESIZE))) {}
+
+  bool enabled() const { return enabled_; }
+
+  void set_enabled(bool enabled) { enabled_ = enabled; }
+
+  size_t threshold_bytes() const { return threshold_bytes_; }
+
+  // How many calls to Receive() asked the kernel to map data, and how many of
+  // those mapped some rather than falling back.
+  size_t attempts() const { return attempts_; }
+  size_t reads() const { return reads_; }
+
+  // Maps up to max_bytes (rounded down to whole pages) of the data queued on
+  // the socket into a new slice appended to out, so that the bytes are
+  // consumed from the socket without being copied. Returns the number of
+  // bytes received this way; zero means the caller should fall back to
+  // recvmsg(), e.g. because the head of the receive queue is not page aligned
+  // (its length is then reported by the kernel as the skip hint). Disables
+  // itself for good if the socket or kernel does not support it.
+  size_t Receive(int fd, size_t max_bytes, grpc_slice_buffer* out);
+
+ private:
+  // Owns one mapping created by Receive(); unmapped when the last ref to the
+  // slice pointing into it goes away.
+  struct Mapping {
+    void* address;
+    size_t length;
+  };
+
+  // Mirrors the leading fields of the kernel's struct tcp_zerocopy_receive.
+  // The kernel accepts this prefix of the (growing) structure.
+  struct ZerocopyReceive {
+    uint64_t address;
+    uint32_t length;
+    uint32_t recv_skip_hint;
+  };
+
+  static void Unmap(void* mapping);
+
+  bool enabled_ = false;
+  size_t threshold_bytes_;
+  size_t page_size_;
+  size_t attempts_ = 0;
+  size_t reads_ = 0;
+};
+
+#ifdef GRPC_HAVE_TCP_ZEROCOPY_RECEIVE
+size_t TcpZerocopyReceiveCtx::Receive(int fd, size_t max_bytes,
+                                      grpc_slice_buffer* out) {
+  size_t map_length = max_bytes - max_bytes % page_size_;
+  if (map_length == 0) return 0;
+  void* address =
+      mmap(nullptr, map_length, PROT_READ, MAP_SHARED, fd, /*offset=*/0);
+  if (address == MAP_FAILED) {
+    gpr_log(GPR_INFO, "Disabling TCP RX zerocopy: mmap failed: %s",
+            strerror(errno));
+    enabled_ = false;
+    return 0;
+  }
+  ZerocopyReceive zc;
+  memset(&zc, 0, sizeof(zc));
+  zc.address = reinterpret_cast<uint64_t>(address);
+  zc.length = static_cast<uint32_t>(
+      std::min<size_t>(map_length, std::numeric_limits<uint32_t>::max() -
+                                       page_size_ + 1));
+  socklen_t zc_len = sizeof(zc);
+  attempts_++;
+  int err;
+  do {
+    GRPC_STATS_INC_SYSCALL_READ();
+    err = getsockopt(fd, IPPROTO_TCP, TCP_ZEROCOPY_RECEIVE, &zc, &zc_len);
+  } while (err < 0 && errno == EINTR);
+  if (err < 0 || zc.length == 0) {
+    if (err < 0 && errno != EAGAIN) {
+      gpr_log(GPR_INFO, "Disabling TCP RX zerocopy: getsockopt failed: %s",
+              strerror(errno));
+      enabled_ = false;
+    }
+    munmap(address, map_length);
+    return 0;
+  }
+  Mapping* mapping = new Mapping{address, map_length};
+  grpc_slice_buffer_add(out, grpc_slice_new_with_user_data(
+                                 address, zc.length, Unmap, mapping));
+  reads_++;
+  return zc.length;
+}
+#else
+size_t TcpZerocopyReceiveCtx::Receive(int /*fd*/, size_t /*max_bytes*/,
+                                      grpc_slice_buffer* /*out*/) {
+  return 0;
+}
+#endif /* GRPC_HAVE_TCP_ZEROCOPY_RECEIVE */
+
+void TcpZerocopyReceiveCtx::Unmap(void* mapping) {
+  Mapping* m = static_cast<Mapping*>(mapping);
+  munmap(m->address, m->length);
+  delete m;
+}
+
+// Decides how large a buffer to allocate for the next read on a connection.
+// Exact information wins over guesses: the number of bytes the kernel reported
+// as still pending after the previous read (TCP_INQ) is used as is; failing
+// that, the larger of the bytes the reader said it is waiting for and the
+// connection's read history.
+class TcpReadSizer {
+ public:
+  TcpReadSizer() = default;
+  TcpReadSizer(size_t initial_length, size_t min_length)
+      : target_length_(static_cast<double>(initial_length)),
+        min_length_(min_length) {}
+
+  // Returns the number of bytes to allocate for the next read. pending is the
+  // number of bytes known to be queued on the socket, or 0 if unknown.
+  size_t NextReadLength(size_t pending) const {
+    if (pending > 0) return std::max(pending, min_length_);
+    return std::max(static_cast<size_t>(target_length_), read_hint_);
+  }
+
+  void SetReadHint(size_t bytes) { read_hint_ = bytes; }
+
+  void AddRead(size_t bytes) {
+    bytes_read_this_round_ += static_cast<double>(bytes);
+  }
+
+  // Called once the socket has been drained, to fold the bytes read since the
+  // last call into the history.
+  void FinishRound() {
+    // If we read >80% of the target buffer in one read loop, increase the size
+    // of the target buffer to either the amount read, or twice its previous
+    // value
+    if (bytes_read_this_round_ > target_length_ * 0.8) {
+      target_length_ = std::max(2 * target_length_, bytes_read_this_round_);
+    } else {
+      target_length_ = 0.99 * target_length_ + 0.01 * bytes_read_this_round_;
+    }
+    bytes_read_this_round_ = 0;
+  }
+
+  // Whether an unused read buffer of the given size is worth holding on to
+  // while the connection waits for more data. Idle connections otherwise pin
+  // a full-sized buffer each; the next read is sized from fresh information
+  // anyway.
+  bool ShouldRetainIdleBuffer(size_t bytes) const {
+    return bytes <= min_length_;
+  }
+
+ private:
+  double target_length_ = 0;
+  double bytes_read_this_round_ = 0;
+  size_t min_length_ = 0;
+  size_t read_hint_ = 0;
+};
+
 }  // namespace grpc_core
 
+using grpc_core::TcpReadSizer;
+using grpc_core::TcpZerocopyReceiveCtx;
 using grpc_core::TcpZerocopySendCtx;
 using grpc_core::TcpZerocopySendRecord;
 
 namespace {
 struct grpc_tcp {
-  grpc_tcp(int max_sends, size_t send_bytes_threshold)
-      : tcp_zerocopy_send_ctx(max_sends, send_bytes_threshold) {}
+  grpc_tcp(int max_sends, size_t send_bytes_threshold,
+           size_t recv_bytes_threshold)
+      : tcp_zerocopy_send_ctx(max_sends, send_bytes_threshold),
+        tcp_zerocopy_receive_ctx(recv_bytes_threshold) {}
   grpc_endpoint base;
   grpc_fd* em_fd;
   int fd;
   /* Used by the endpoint read function to distinguish the very first read call
    * from the rest */
   bool is_first_read;
-  double target_length;
-  double bytes_read_this_round;
+  TcpReadSizer read_sizer;
   grpc_core::RefCount refcount;
   gpr_atm shutdown_count;
 
@@ -419,6 +594,7 @@ struct grpc_tcp {
                                       on errors anymore */
   TcpZerocopySendCtx tcp_zerocopy_send_ctx;
   TcpZerocopySendRecord* current_zerocopy_send = nullptr;
+  TcpZerocopyReceiveCtx tcp_zerocopy_receive_ctx;
 };
 
 struct backup_poller {
@@ -566,24 +742,6 @@ static void tcp_drop_uncovered_then_handle_write(void* arg,
   tcp_handle_write(arg, error);
 }
 
-static void add_to_estimate(grpc_tcp* tcp, size_t bytes) {
-  tcp->bytes_read_this_round += static_cast<double>(bytes);
-}
-
-static void finish_estimate(grpc_tcp* tcp) {
-  /* If we read >80% of the target buffer in one read loop, increase the size
-     of the target buffer to either the amount read, or twice its previous
-     value */
-  if (tcp->bytes_read_this_round > tcp->target_length * 0.8) {
-    tcp->target_length =
-        std::max(2 * tcp->target_length, tcp->bytes_read_this_round);
-  } else {
-    tcp->target_length =
-        0.99 * tcp->target_length + 0.01 * tcp->bytes_read_this_round;
-  }
-  tcp->bytes_read_this_round = 0;
-}
-
 static grpc_error_handle tcp_annotate_error(grpc_error_handle src_error,
                                             grpc_tcp* tcp) {
   return grpc_error_set_str(
@@ -741,8 +899,13 @@ static void tcp_do_read(grpc_tcp* tcp) {
       /* NB: After calling call_read_cb a parallel call of the read handler may
        * be running. */
       if (errno == EAGAIN) {
-        finish_estimate(tcp);
+        tcp->read_sizer.FinishRound();
         tcp->inq = 0;
+        /* Nothing was read into incoming_buffer: don't pin it while waiting */
+        if (!tcp->read_sizer.ShouldRetainIdleBuffer(
+                tcp->incoming_buffer->length)) {
+          grpc_slice_buffer_reset_and_unref_internal(tcp->incoming_buffer);
+        }
         /* We've consumed the edge, request a new one */
         notify_on_read(tcp);
       } else {
@@ -768,7 +931,7 @@ static void tcp_do_read(grpc_tcp* tcp) {
     }
 
     GRPC_STATS_INC_TCP_READ_SIZE(read_bytes);
-    add_to_estimate(tcp, static_cast<size_t>(read_bytes));
+    tcp->read_sizer.AddRead(static_cast<size_t>(read_bytes));
     GPR_DEBUG_ASSERT((size_t)read_bytes <=
                      tcp->incoming_buffer->length - total_read_bytes);
 
@@ -815,7 +978,7 @@ static void tcp_do_read(grpc_tcp* tcp) {
   } while (true);
 
   if (tcp->inq == 0) {
-    finish_estimate(tcp);
+    tcp->read_sizer.FinishRound();
   }
 
   GPR_DEBUG_ASSERT(total_read_bytes > 0);
@@ -844,15 +1007,64 @@ static void tcp_read_allocation_done(void* tcpp, grpc_error_handle error) {
   }
 }
 
+/* Tries to satisfy the pending read by mapping the data queued on the socket
+   instead of copying it into incoming_buffer. Returns true if the read
+   completed this way. */
+static bool tcp_do_zerocopy_read(grpc_tcp* tcp) {
+  if (!tcp->tcp_zerocopy_receive_ctx.enabled()) return false;
+  /* tcp->inq is only exact right after a recvmsg() on an inq capable socket;
+     anything smaller than the threshold is cheaper to copy. */
+  if (!tcp->inq_capable ||
+      static_cast<size_t>(tcp->inq) <
+          tcp->tcp_zerocopy_receive_ctx.threshold_bytes()) {
+    return false;
+  }
+  /* The slices already sitting in incoming_buffer are unused space from a
+     previous read: give them back for the next copying read. */
+  grpc_slice_buffer_swap(tcp->incoming_buffer, &tcp->last_read_buffer);
+  size_t read_bytes = tcp->tcp_zerocopy_receive_ctx.Receive(
+      tcp->fd, std::min<size_t>(tcp->inq, tcp->max_read_chunk_size),
+      tcp->incoming_buffer);
+  if (read_bytes == 0) {
+    grpc_slice_buffer_swap(tcp->incoming_buffer, &tcp->last_read_buffer);
+    GRPC_STATS_INC_TCP_RX_ZEROCOPY_FALLBACKS();
+    return false;
+  }
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_tcp_trace)) {
+    gpr_log(GPR_INFO, "TCP:%p zerocopy read %" PRIuPTR " bytes", tcp,
+            read_bytes);
+  }
+  GRPC_STATS_INC_TCP_RX_ZEROCOPY_HITS();
+  GRPC_STATS_INC_TCP_READ_SIZE(read_bytes);
+  /* Whatever did not fit in whole pages (and anything that arrived since) is
+     still queued. Ask how much, so that the next read can map it too if it
+     is large enough; 1 means unknown and sends the next read straight to the
+     socket. */
+  int inq;
+  if (ioctl(tcp->fd, FIONREAD, &inq) == 0) {
+    tcp->inq = inq;
+  } else {
+    tcp->inq = 1;
+  }
+  call_read_cb(tcp, GRPC_ERROR_NONE);
+  TCP_UNREF(tcp, "read");
+  return true;
+}
+
 static void tcp_continue_read(grpc_tcp* tcp) {
+  if (tcp_do_zerocopy_read(tcp)) return;
   /* Wait for allocation only when there is no buffer left. */
   if (tcp->incoming_buffer->length == 0 &&
       tcp->incoming_buffer->count < MAX_READ_IOVEC) {
     if (GRPC_TRACE_FLAG_ENABLED(grpc_tcp_trace)) {
       gpr_log(GPR_INFO, "TCP:%p alloc_slices", tcp);
     }
+    /* tcp->inq is only exact after a read on an inq capable socket that
+       left more data queued; 0 and 1 mean we don't know. */
+    size_t pending =
+        tcp->inq_capable && tcp->inq > 1 ? static_cast<size_t>(tcp->inq) : 0;
     if (GPR_UNLIKELY(!grpc_slice_allocator_allocate(
-            tcp->slice_allocator, tcp->target_length, 1,
+            tcp->slice_allocator, tcp->read_sizer.NextReadLength(pending), 1,
             grpc_slice_allocator_intent::kReadBuffer, tcp->incoming_buffer,
             tcp_read_allocation_done, tcp))) {
       // Wait for allocation.
@@ -900,6 +1112,9 @@ static void tcp_read(grpc_endpoint* ep, grpc_slice_buffer* incoming_buffer,
     /* Upper layer asked to read more but we know there is no pending data
      * to read from previous reads. So, wait for POLLIN.
      */
+    if (!tcp->read_sizer.ShouldRetainIdleBuffer(incoming_buffer->length)) {
+      grpc_slice_buffer_reset_and_unref_internal(incoming_buffer);
+    }
     notify_on_read(tcp);
   } else {
     /* Not the first time. We may or may not have more bytes available. In any
@@ -1654,6 +1869,11 @@ static bool tcp_can_track_err(grpc_endpoint* ep) {
   return addr.sa_family == AF_INET || addr.sa_family == AF_INET6;
 }
 
+static void tcp_set_read_hint(grpc_endpoint* ep, size_t bytes) {
+  grpc_tcp* tcp = reinterpret_cast<grpc_tcp*>(ep);
+  tcp->read_sizer.SetReadHint(bytes);
+}
+
 static const grpc_endpoint_vtable vtable = {tcp_read,
                                             tcp_write,
                                             tcp_add_to_pollset,
@@ -1664,7 +1884,8 @@ static const grpc_endpoint_vtable vtable = {tcp_read,
                                             tcp_get_peer,
                                             tcp_get_local_address,
                                             tcp_get_fd,
-                                            tcp_can_track_err};
+                                            tcp_can_track_err,
+                                            tcp_set_read_hint};
 
 #define MAX_CHUNK_SIZE (32 * 1024 * 1024)
 
@@ -1673,6 +1894,7 @@ grpc_endpoint* grpc_tcp_create(grpc_fd* em_fd,
                                const char* peer_string,
                                grpc_slice_allocator* slice_allocator) {
   static constexpr bool kZerocpTxEnabledDefault = false;
+  static constexpr bool kZerocpRxEnabledDefault = false;
   int tcp_read_chunk_size = GRPC_TCP_DEFAULT_READ_SLICE_SIZE;
   int tcp_max_read_chunk_size = 4 * 1024 * 1024;
   int tcp_min_read_chunk_size = 256;
@@ -1681,6 +1903,9 @@ grpc_endpoint* grpc_tcp_create(grpc_fd* em_fd,
       grpc_core::TcpZerocopySendCtx::kDefaultSendBytesThreshold;
   int tcp_tx_zerocopy_max_simult_sends =
       grpc_core::TcpZerocopySendCtx::kDefaultMaxSends;
+  bool tcp_rx_zerocopy_enabled = kZerocpRxEnabledDefault;
+  int tcp_rx_zerocopy_recv_bytes_thresh =
+      grpc_core::TcpZerocopyReceiveCtx::kDefaultRecvBytesThreshold;
   if (channel_args != nullptr) {
     for (size_t i = 0; i < channel_args->num_args; i++) {
       if (0 ==
@@ -1715,6 +1940,17 @@ grpc_endpoint* grpc_tcp_create(grpc_fd* em_fd,
             grpc_core::TcpZerocopySendCtx::kDefaultMaxSends, 0, INT_MAX};
         tcp_tx_zerocopy_max_simult_sends =
             grpc_channel_arg_get_integer(&channel_args->args[i], options);
+      } else if (0 == strcmp(channel_args->args[i].key,
+                             GRPC_ARG_TCP_RX_ZEROCOPY_ENABLED)) {
+        tcp_rx_zerocopy_enabled = grpc_channel_arg_get_bool(
+            &channel_args->args[i], kZerocpRxEnabledDefault);
+      } else if (0 == strcmp(channel_args->args[i].key,
+                             GRPC_ARG_TCP_RX_ZEROCOPY_RECV_BYTES_THRESHOLD)) {
+        grpc_integer_options options = {
+            grpc_core::TcpZerocopyReceiveCtx::kDefaultRecvBytesThreshold, 1,
+            INT_MAX};
+        tcp_rx_zerocopy_recv_bytes_thresh =
+            grpc_channel_arg_get_integer(&channel_args->args[i], options);
       }
     }
   }
@@ -1726,7 +1962,8 @@ grpc_endpoint* grpc_tcp_create(grpc_fd* em_fd,
       tcp_read_chunk_size, tcp_min_read_chunk_size, tcp_max_read_chunk_size);
 
   grpc_tcp* tcp = new grpc_tcp(tcp_tx_zerocopy_max_simult_sends,
-                               tcp_tx_zerocopy_send_bytes_thresh);
+                               tcp_tx_zerocopy_send_bytes_thresh,
+                               tcp_rx_zerocopy_recv_bytes_thresh);
   tcp->base.vtable = &vtable;
   tcp->peer_string = peer_string;
   tcp->fd = grpc_fd_wrapped_fd(em_fd);
@@ -1747,10 +1984,9 @@ grpc_endpoint* grpc_tcp_create(grpc_fd* em_fd,
   tcp->release_fd_cb = nullptr;
   tcp->release_fd = nullptr;
   tcp->incoming_buffer = nullptr;
-  tcp->target_length = static_cast<double>(tcp_read_chunk_size);
+  tcp->read_sizer = TcpReadSizer(tcp_read_chunk_size, tcp_min_read_chunk_size);
   tcp->min_read_chunk_size = tcp_min_read_chunk_size;
   tcp->max_read_chunk_size = tcp_max_read_chunk_size;
-  tcp->bytes_read_this_round = 0;
   /* Will be set to false by the very first endpoint read function */
   tcp->is_first_read = true;
   tcp->bytes_counter = -1;
@@ -1802,6 +2038,9 @@ grpc_endpoint* grpc_tcp_create(grpc_fd* em_fd,
 #else
   tcp->inq_capable = false;
 #endif /* GRPC_HAVE_TCP_INQ */
+  /* Receive zerocopy is driven by the inq value reported with each read. */
+  tcp->tcp_zerocopy_receive_ctx.set_enabled(tcp_rx_zerocopy_enabled &&
+                                            tcp->inq_capable);
   /* Start being notified on errors if event engine can track errors. */
   if (grpc_event_engine_can_track_errors()) {
     /* Grab a ref to tcp so that we can safely access the tcp struct when
@@ -1817,6 +2056,14 @@ grpc_endpoint* grpc_tcp_create(grpc_fd* em_fd,
   return &tcp->base;
 }
 
+void grpc_tcp_zerocopy_reads_for_testing(grpc_endpoint* ep, size_t* attempts,
+                                         size_t* reads) {
+  grpc_tcp* tcp = reinterpret_cast<grpc_tcp*>(ep);
+  GPR_ASSERT(ep->vtable == &vtable);
+  *attempts = tcp->tcp_zerocopy_receive_ctx.attempts();
+  *reads = tcp->tcp_zerocopy_receive_ctx.reads();
+}
+
 int grpc_tcp_fd(grpc_endpoint* ep) {
   grpc_tcp* tcp = reinterpret_cast<grpc_tcp*>(ep);
   GPR_ASSERT(ep->vtable == &vtable);
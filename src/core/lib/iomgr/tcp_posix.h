@@ -50,6 +50,12 @@ grpc_endpoint* grpc_tcp_create(grpc_fd* fd, const grpc_channel_args* args,
 /// release the fd. Requires: \a ep must be a tcp endpoint.
 int grpc_tcp_fd(grpc_endpoint* ep);
 
+/// Set *attempts to how many reads on \a ep tried TCP_ZEROCOPY_RECEIVE, and
+/// *reads to how many of those were served by mapping pages instead of
+/// copying. For tests. Requires: \a ep must be a tcp endpoint.
+void grpc_tcp_zerocopy_reads_for_testing(grpc_endpoint* ep, size_t* attempts,
+                                         size_t* reads);
+
 /// Destroy the tcp endpoint without closing its fd. *fd will be set and done
 /// will be called when the endpoint is destroyed. Requires: \a ep must be a tcp
 /// endpoint and fd must not be NULL.
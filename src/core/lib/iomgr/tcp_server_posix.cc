@@ -51,6 +51,7 @@
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/gpr/string.h"
 #include "src/core/lib/gprpp/memory.h"
+#include "src/core/lib/iomgr/ev_posix.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/iomgr/resolve_address.h"
 #include "src/core/lib/iomgr/sockaddr.h"
@@ -187,6 +188,22 @@ static void tcp_server_destroy(grpc_tcp_server* s) {
   }
 }
 
+/* Applies the process-wide busy polling budget to an accepted socket. Raising
+   SO_BUSY_POLL above net.core.busy_read needs CAP_NET_ADMIN, so failures only
+   mean the kernel won't busy poll the socket's queue for us. */
+static void set_busy_poll_if_enabled(int fd) {
+  int busy_poll_us = grpc_event_engine_busy_poll_us();
+  if (busy_poll_us == 0) return;
+  grpc_error_handle err = grpc_set_socket_busy_poll(fd, busy_poll_us);
+  if (err != GRPC_ERROR_NONE) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_tcp_trace)) {
+      gpr_log(GPR_INFO, "Failed to enable busy polling on fd %d: %s", fd,
+              grpc_error_std_string(err).c_str());
+    }
+    GRPC_ERROR_UNREF(err);
+  }
+}
+
 /* event manager callback when reads are ready */
 static void on_read(void* arg, grpc_error_handle err) {
   grpc_tcp_listener* sp = static_cast<grpc_tcp_listener*>(arg);
@@ -237,6 +254,7 @@ static void on_read(void* arg, grpc_error_handle err) {
     }
 
     grpc_set_socket_no_sigpipe_if_possible(fd);
+    set_busy_poll_if_enabled(fd);
 
     err = grpc_apply_socket_mutator_in_args(fd, GRPC_FD_SERVER_CONNECTION_USAGE,
                                             sp->server->channel_args);
@@ -596,6 +614,7 @@ class ExternalConnectionHandler : public grpc_core::TcpServerFdHandler {
       return;
     }
     grpc_set_socket_no_sigpipe_if_possible(fd);
+    set_busy_poll_if_enabled(fd);
     std::string addr_str = grpc_sockaddr_to_uri(&addr);
     if (grpc_tcp_trace.enabled()) {
       gpr_log(GPR_INFO, "SERVER_CONNECT: incoming external connection: %s",
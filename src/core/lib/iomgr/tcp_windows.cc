@@ -498,7 +498,8 @@ static grpc_endpoint_vtable vtable = {win_read,
                                       win_get_peer,
                                       win_get_local_address,
                                       win_get_fd,
-                                      win_can_track_err};
+                                      win_can_track_err,
+                                      nullptr};
 
 grpc_endpoint* grpc_tcp_create(grpc_winsocket* socket,
                                grpc_channel_args* channel_args,
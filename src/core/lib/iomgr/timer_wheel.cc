@@ -0,0 +1,610 @@
+/*
+ *
+ * Copyright 2021 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* A timer implementation built from hierarchical timing wheels, one per CPU.
+
+   grpc_timer_init() adds the timer to the wheel of the CPU it runs on, under
+   that wheel's mutex, which is rarely contended. Timers are not linked into
+   the wheel directly: each gets a wheel_node, and the timer remembers the node
+   and its generation. grpc_timer_cancel() takes no lock at all. It claims the
+   timer with a compare-and-swap on the node state, and leaves the node in the
+   wheel for its owner to reclaim when it reaches the node's slot (or during a
+   sweep, if cancelled nodes pile up). Nodes are recycled but never freed
+   before shutdown, so a late cancel always reads a valid node; a changed
+   generation tells it the timer has already fired.
+
+   Each wheel has kNumLevels levels of kSlotsPerLevel slots. Level l holds
+   timers due within kSlotsPerLevel^(l+1) ms, in slots kSlotsPerLevel^l ms
+   wide; when time reaches a slot of an upper level, its timers cascade down.
+   Timers further out than the top level wait in an overflow list. */
+
+#include <grpc/support/port_platform.h>
+
+#include <inttypes.h>
+
+#include <algorithm>
+#include <atomic>
+#include <new>
+
+#include <grpc/support/alloc.h>
+#include <grpc/support/cpu.h>
+#include <grpc/support/log.h>
+
+#include "src/core/lib/debug/trace.h"
+#include "src/core/lib/gpr/spinlock.h"
+#include "src/core/lib/gpr/tls.h"
+#include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/iomgr/timer.h"
+
+extern grpc_core::TraceFlag grpc_timer_trace;
+extern grpc_core::TraceFlag grpc_timer_check_trace;
+
+namespace {
+
+constexpr int kBitsPerLevel = 6;
+constexpr int kSlotsPerLevel = 1 << kBitsPerLevel;
+constexpr int kNumLevels = 4;
+// Pseudo level counting the overflow list.
+constexpr int kOverflowLevel = kNumLevels;
+constexpr size_t kNodesPerChunk = 256;
+// Sweep cancelled nodes out of a wheel once there are at least this many, and
+// they make up at least half of the wheel.
+constexpr intptr_t kMinCancelledToSweep = 1024;
+
+// Node states, kept in the low bits of wheel_node::state. The upper bits hold
+// the generation, which changes every time the node is recycled.
+constexpr uint64_t kNodeFree = 0;
+constexpr uint64_t kNodePending = 1;
+constexpr uint64_t kNodeCancelled = 2;
+constexpr int kNodeStateBits = 2;
+
+struct timer_wheel;
+
+struct wheel_node {
+  std::atomic<uint64_t> state;
+  grpc_timer* timer;
+  // Copied from the timer, which may be gone once the node is cancelled.
+  grpc_millis deadline;
+  timer_wheel* wheel;
+  wheel_node* next;
+};
+
+uint64_t make_state(uint32_t generation, uint64_t state) {
+  return (static_cast<uint64_t>(generation) << kNodeStateBits) | state;
+}
+
+uint32_t state_generation(uint64_t state) {
+  return static_cast<uint32_t>(state >> kNodeStateBits);
+}
+
+grpc_millis level_granularity(int level) {
+  return static_cast<grpc_millis>(1) << (kBitsPerLevel * level);
+}
+
+struct timer_wheel {
+  gpr_mu mu;
+  // Lower bound on when the next timer in this wheel needs attention.
+  std::atomic<grpc_millis> min_deadline;
+  // Nodes cancelled but still linked into the wheel. Cancels count themselves
+  // after the fact, so this can briefly go negative.
+  std::atomic<intptr_t> cancelled;
+
+  // Everything below is guarded by mu.
+
+  // The next tick to process: timers due before this have been run.
+  grpc_millis now;
+  wheel_node* slots[kNumLevels][kSlotsPerLevel];
+  // Bit i set iff slots[level][i] is not empty.
+  uint64_t occupied[kNumLevels];
+  wheel_node* overflow;
+  // Number of nodes in each level (and in the overflow list).
+  size_t counts[kNumLevels + 1];
+  size_t total;
+  wheel_node* free_nodes;
+  // Allocated node chunks, the first node of each linking to the next chunk.
+  wheel_node* chunks;
+} GPR_ALIGN_STRUCT(GPR_CACHELINE_SIZE);
+
+size_t g_num_wheels;
+timer_wheel* g_wheels;
+bool g_initialized;
+
+// The earliest min_deadline over all wheels, possibly lower.
+std::atomic<grpc_millis> g_min_timer;
+// Allow only one run_expired_timers at once.
+gpr_spinlock g_checker_mu = GPR_SPINLOCK_STATIC_INITIALIZER;
+
+// Thread local copy of g_min_timer, so that idle checks do not touch the
+// shared cacheline.
+GPR_THREAD_LOCAL(grpc_millis) g_last_seen_min_timer;
+
+// Sequentially consistent, so that either timer_check() sees a wheel minimum
+// lowered here, or the lowering of g_min_timer that follows sees the value
+// timer_check() published.
+void lower_min_deadline(std::atomic<grpc_millis>* min_deadline,
+                        grpc_millis deadline, bool* lowered) {
+  grpc_millis cur = min_deadline->load();
+  while (deadline < cur) {
+    if (min_deadline->compare_exchange_weak(cur, deadline)) {
+      *lowered = true;
+      return;
+    }
+  }
+}
+
+wheel_node* alloc_node(timer_wheel* wheel) {
+  if (wheel->free_nodes == nullptr) {
+    wheel_node* chunk = static_cast<wheel_node*>(
+        gpr_malloc(kNodesPerChunk * sizeof(wheel_node)));
+    for (size_t i = 0; i < kNodesPerChunk; i++) {
+      new (&chunk[i].state) std::atomic<uint64_t>(make_state(0, kNodeFree));
+      chunk[i].wheel = wheel;
+    }
+    chunk[0].next = wheel->chunks;
+    wheel->chunks = chunk;
+    for (size_t i = 1; i < kNodesPerChunk; i++) {
+      chunk[i].next = wheel->free_nodes;
+      wheel->free_nodes = &chunk[i];
+    }
+  }
+  wheel_node* node = wheel->free_nodes;
+  wheel->free_nodes = node->next;
+  return node;
+}
+
+// Bumps the generation of a node that left the wheel, so that late cancels of
+// its previous timer do nothing, and returns it to the free list.
+void release_node(timer_wheel* wheel, wheel_node* node, uint64_t state) {
+  node->state.store(make_state(state_generation(state) + 1, kNodeFree),
+                    std::memory_order_release);
+  node->next = wheel->free_nodes;
+  wheel->free_nodes = node;
+}
+
+// Returns the time at which the wheel next needs to look at a node placed in
+// the given level and slot.
+grpc_millis slot_event_time(const timer_wheel* wheel, int level, int slot) {
+  const int shift = kBitsPerLevel * level;
+  grpc_millis block = wheel->now >> shift;
+  // The slot of the current block is only still ahead if its boundary has not
+  // been processed yet.
+  int first = (wheel->now & (level_granularity(level) - 1)) == 0 ? 0 : 1;
+  int distance = (slot - static_cast<int>((block + first) % kSlotsPerLevel) +
+                  kSlotsPerLevel) %
+                 kSlotsPerLevel;
+  return (block + first + distance) << shift;
+}
+
+grpc_millis overflow_event_time(const timer_wheel* wheel) {
+  const int shift = kBitsPerLevel * kNumLevels;
+  return ((wheel->now + level_granularity(kNumLevels) - 1) >> shift) << shift;
+}
+
+// Links node into the wheel, returning when the wheel will next look at it.
+grpc_millis insert_node(timer_wheel* wheel, wheel_node* node) {
+  grpc_millis deadline = std::max(node->deadline, wheel->now);
+  grpc_millis delta = deadline - wheel->now;
+  wheel->total++;
+  for (int level = 0; level < kNumLevels; level++) {
+    if (delta < level_granularity(level + 1)) {
+      int slot = static_cast<int>((deadline >> (kBitsPerLevel * level)) %
+                                  kSlotsPerLevel);
+      node->next = wheel->slots[level][slot];
+      wheel->slots[level][slot] = node;
+      wheel->occupied[level] |= uint64_t{1} << slot;
+      wheel->counts[level]++;
+      return level == 0 ? deadline : slot_event_time(wheel, level, slot);
+    }
+  }
+  node->next = wheel->overflow;
+  wheel->overflow = node;
+  wheel->counts[kOverflowLevel]++;
+  return overflow_event_time(wheel);
+}
+
+// Takes the timer of a pending node and schedules its closure with error.
+// Returns false if the timer was cancelled meanwhile. Either way the node is
+// released.
+bool fire_node(timer_wheel* wheel, wheel_node* node, grpc_error_handle error) {
+  uint64_t state = node->state.load(std::memory_order_acquire);
+  if ((state & ((1 << kNodeStateBits) - 1)) == kNodePending) {
+    grpc_timer* timer = node->timer;
+    if (node->state.compare_exchange_strong(
+            state, make_state(state_generation(state) + 1, kNodeFree),
+            std::memory_order_acq_rel)) {
+      if (GRPC_TRACE_FLAG_ENABLED(grpc_timer_trace)) {
+        gpr_log(GPR_INFO, "TIMER %p: FIRE %" PRId64 "ms late", timer,
+                wheel->now - node->deadline);
+      }
+      grpc_core::ExecCtx::Run(DEBUG_LOCATION, timer->closure,
+                              GRPC_ERROR_REF(error));
+      node->next = wheel->free_nodes;
+      wheel->free_nodes = node;
+      return true;
+    }
+  }
+  // Cancelled, by now or before we got here.
+  wheel->cancelled.fetch_sub(1, std::memory_order_relaxed);
+  release_node(wheel, node, state);
+  return false;
+}
+
+bool is_cancelled(const wheel_node* node) {
+  return (node->state.load(std::memory_order_acquire) &
+          ((1 << kNodeStateBits) - 1)) == kNodeCancelled;
+}
+
+// Moves the nodes of an upper level slot down to where they now belong,
+// reclaiming cancelled ones.
+void cascade(timer_wheel* wheel, wheel_node** list, int level) {
+  wheel_node* node = *list;
+  *list = nullptr;
+  while (node != nullptr) {
+    wheel_node* next = node->next;
+    wheel->counts[level]--;
+    wheel->total--;
+    if (is_cancelled(node)) {
+      wheel->cancelled.fetch_sub(1, std::memory_order_relaxed);
+      release_node(wheel, node, node->state.load(std::memory_order_relaxed));
+    } else {
+      insert_node(wheel, node);
+    }
+    node = next;
+  }
+}
+
+// Processes tick wheel->now: cascades every level whose boundary it is, then
+// runs the timers due at it.
+bool process_tick(timer_wheel* wheel, grpc_error_handle error) {
+  const grpc_millis t = wheel->now;
+  if (t % level_granularity(kNumLevels) == 0) {
+    cascade(wheel, &wheel->overflow, kOverflowLevel);
+  }
+  for (int level = kNumLevels - 1; level > 0; level--) {
+    if (t % level_granularity(level) != 0) continue;
+    int slot =
+        static_cast<int>((t >> (kBitsPerLevel * level)) % kSlotsPerLevel);
+    wheel->occupied[level] &= ~(uint64_t{1} << slot);
+    cascade(wheel, &wheel->slots[level][slot], level);
+  }
+  int slot = static_cast<int>(t % kSlotsPerLevel);
+  wheel_node* node = wheel->slots[0][slot];
+  wheel->slots[0][slot] = nullptr;
+  wheel->occupied[0] &= ~(uint64_t{1} << slot);
+  bool fired = false;
+  while (node != nullptr) {
+    wheel_node* next = node->next;
+    wheel->counts[0]--;
+    wheel->total--;
+    fired |= fire_node(wheel, node, error);
+    node = next;
+  }
+  wheel->now = t + 1;
+  return fired;
+}
+
+// Runs every timer in the wheel, with error.
+bool fire_all(timer_wheel* wheel, grpc_error_handle error) {
+  bool fired = false;
+  auto fire_list = [wheel, error, &fired](wheel_node** list) {
+    wheel_node* node = *list;
+    *list = nullptr;
+    while (node != nullptr) {
+      wheel_node* next = node->next;
+      fired |= fire_node(wheel, node, error);
+      node = next;
+    }
+  };
+  for (int level = 0; level < kNumLevels; level++) {
+    for (int slot = 0; slot < kSlotsPerLevel; slot++) {
+      fire_list(&wheel->slots[level][slot]);
+    }
+    wheel->occupied[level] = 0;
+  }
+  fire_list(&wheel->overflow);
+  for (size_t& count : wheel->counts) count = 0;
+  wheel->total = 0;
+  return fired;
+}
+
+// Runs every timer due at or before now. Stretches of time with nothing to
+// fire or cascade are skipped.
+bool advance(timer_wheel* wheel, grpc_millis now, grpc_error_handle error) {
+  if (now == GRPC_MILLIS_INF_FUTURE) return fire_all(wheel, error);
+  bool fired = false;
+  while (wheel->now <= now) {
+    if (wheel->total == 0) {
+      wheel->now = now + 1;
+      break;
+    }
+    if (wheel->counts[0] == 0) {
+      // Nothing can happen before the next boundary of the lowest occupied
+      // level.
+      int level = 1;
+      while (wheel->counts[level] == 0) level++;
+      grpc_millis granularity = level_granularity(level);
+      grpc_millis next =
+          (wheel->now + granularity - 1) / granularity * granularity;
+      if (next > now) {
+        wheel->now = now + 1;
+        break;
+      }
+      wheel->now = next;
+    }
+    fired |= process_tick(wheel, error);
+  }
+  return fired;
+}
+
+// Lower bound on when the wheel next needs attention.
+grpc_millis compute_min_deadline(const timer_wheel* wheel) {
+  grpc_millis min_deadline = GRPC_MILLIS_INF_FUTURE;
+  for (int level = 0; level < kNumLevels; level++) {
+    if (wheel->occupied[level] == 0) continue;
+    for (int slot = 0; slot < kSlotsPerLevel; slot++) {
+      if (wheel->occupied[level] & (uint64_t{1} << slot)) {
+        min_deadline =
+            std::min(min_deadline, slot_event_time(wheel, level, slot));
+      }
+    }
+  }
+  if (wheel->overflow != nullptr) {
+    min_deadline = std::min(min_deadline, overflow_event_time(wheel));
+  }
+  return min_deadline;
+}
+
+// Unlinks all cancelled nodes from the wheel.
+void sweep(timer_wheel* wheel) {
+  auto sweep_list = [wheel](wheel_node** list, int level) {
+    wheel_node** link = list;
+    while (*link != nullptr) {
+      wheel_node* node = *link;
+      if (is_cancelled(node)) {
+        *link = node->next;
+        wheel->counts[level]--;
+        wheel->total--;
+        wheel->cancelled.fetch_sub(1, std::memory_order_relaxed);
+        release_node(wheel, node, node->state.load(std::memory_order_relaxed));
+      } else {
+        link = &node->next;
+      }
+    }
+  };
+  for (int level = 0; level < kNumLevels; level++) {
+    for (int slot = 0; slot < kSlotsPerLevel; slot++) {
+      sweep_list(&wheel->slots[level][slot], level);
+      if (wheel->slots[level][slot] == nullptr) {
+        wheel->occupied[level] &= ~(uint64_t{1} << slot);
+      }
+    }
+  }
+  sweep_list(&wheel->overflow, kOverflowLevel);
+}
+
+void timer_list_init() {
+  g_num_wheels = grpc_core::Clamp(gpr_cpu_num_cores(), 1u, 64u);
+  g_wheels = static_cast<timer_wheel*>(
+      gpr_malloc_aligned(g_num_wheels * sizeof(*g_wheels), GPR_CACHELINE_SIZE));
+  grpc_millis now = grpc_core::ExecCtx::Get()->Now();
+  for (size_t i = 0; i < g_num_wheels; i++) {
+    timer_wheel* wheel = new (&g_wheels[i]) timer_wheel();
+    gpr_mu_init(&wheel->mu);
+    wheel->min_deadline.store(GRPC_MILLIS_INF_FUTURE,
+                              std::memory_order_relaxed);
+    wheel->cancelled.store(0, std::memory_order_relaxed);
+    wheel->now = now;
+  }
+  g_min_timer.store(GRPC_MILLIS_INF_FUTURE, std::memory_order_relaxed);
+  g_last_seen_min_timer = 0;
+  g_initialized = true;
+}
+
+void timer_list_shutdown() {
+  grpc_error_handle error =
+      GRPC_ERROR_CREATE_FROM_STATIC_STRING("Timer list shutdown");
+  for (size_t i = 0; i < g_num_wheels; i++) {
+    timer_wheel* wheel = &g_wheels[i];
+    gpr_mu_lock(&wheel->mu);
+    fire_all(wheel, error);
+    gpr_mu_unlock(&wheel->mu);
+    while (wheel->chunks != nullptr) {
+      wheel_node* chunk = wheel->chunks;
+      wheel->chunks = chunk[0].next;
+      gpr_free(chunk);
+    }
+    gpr_mu_destroy(&wheel->mu);
+    wheel->~timer_wheel();
+  }
+  GRPC_ERROR_UNREF(error);
+  gpr_free_aligned(g_wheels);
+  g_wheels = nullptr;
+  g_initialized = false;
+}
+
+void timer_init(grpc_timer* timer, grpc_millis deadline,
+                grpc_closure* closure) {
+  timer->closure = closure;
+  timer->deadline = deadline;
+
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_timer_trace)) {
+    gpr_log(GPR_INFO, "TIMER %p: SET %" PRId64 " now %" PRId64 " call %p[%p]",
+            timer, deadline, grpc_core::ExecCtx::Get()->Now(), closure,
+            closure->cb);
+  }
+
+  if (!g_initialized) {
+    timer->pending = false;
+    grpc_core::ExecCtx::Run(
+        DEBUG_LOCATION, timer->closure,
+        GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+            "Attempt to create timer before initialization"));
+    return;
+  }
+
+  grpc_millis now = grpc_core::ExecCtx::Get()->Now();
+  if (deadline <= now) {
+    timer->pending = false;
+    grpc_core::ExecCtx::Run(DEBUG_LOCATION, timer->closure, GRPC_ERROR_NONE);
+    return;
+  }
+
+  timer_wheel* wheel =
+      &g_wheels[static_cast<size_t>(gpr_cpu_current_cpu()) % g_num_wheels];
+  gpr_mu_lock(&wheel->mu);
+  wheel_node* node = alloc_node(wheel);
+  uint32_t generation =
+      state_generation(node->state.load(std::memory_order_relaxed));
+  node->timer = timer;
+  node->deadline = deadline;
+  timer->pending = true;
+  timer->custom_timer = node;
+  timer->heap_index = generation;
+  node->state.store(make_state(generation, kNodePending),
+                    std::memory_order_release);
+  if (wheel->total == 0) {
+    // Nothing to process in between: catch up with the clock so that the new
+    // timer lands in the right level.
+    wheel->now = std::max(wheel->now, now);
+  }
+  grpc_millis event_time = insert_node(wheel, node);
+  intptr_t cancelled = wheel->cancelled.load(std::memory_order_relaxed);
+  if (cancelled >= kMinCancelledToSweep &&
+      2 * static_cast<size_t>(cancelled) >= wheel->total) {
+    sweep(wheel);
+  }
+  bool lowered = false;
+  lower_min_deadline(&wheel->min_deadline, event_time, &lowered);
+  gpr_mu_unlock(&wheel->mu);
+
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_timer_trace)) {
+    gpr_log(GPR_INFO, "  .. add to wheel %d, next event at %" PRId64,
+            static_cast<int>(wheel - g_wheels), event_time);
+  }
+
+  if (lowered) {
+    bool lowered_global = false;
+    lower_min_deadline(&g_min_timer, event_time, &lowered_global);
+    if (lowered_global) grpc_kick_poller();
+  }
+}
+
+void timer_cancel(grpc_timer* timer) {
+  if (!g_initialized) {
+    /* must have already been cancelled, also the wheel nodes are gone */
+    return;
+  }
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_timer_trace)) {
+    gpr_log(GPR_INFO, "TIMER %p: CANCEL pending=%s", timer,
+            timer->pending ? "true" : "false");
+  }
+  if (!timer->pending) return;
+  wheel_node* node = static_cast<wheel_node*>(timer->custom_timer);
+  uint64_t expected = make_state(timer->heap_index, kNodePending);
+  if (node->state.compare_exchange_strong(
+          expected, make_state(timer->heap_index, kNodeCancelled),
+          std::memory_order_acq_rel)) {
+    timer->pending = false;
+    node->wheel->cancelled.fetch_add(1, std::memory_order_relaxed);
+    grpc_core::ExecCtx::Run(DEBUG_LOCATION, timer->closure,
+                            GRPC_ERROR_CANCELLED);
+  }
+}
+
+void timer_consume_kick(void) {
+  /* Force re-evaluation of last seen min */
+  g_last_seen_min_timer = 0;
+}
+
+grpc_timer_check_result timer_check(grpc_millis* next) {
+  grpc_millis now = grpc_core::ExecCtx::Get()->Now();
+  grpc_millis min_timer = g_last_seen_min_timer;
+  if (now < min_timer) {
+    if (next != nullptr) *next = std::min(*next, min_timer);
+    return GRPC_TIMERS_CHECKED_AND_EMPTY;
+  }
+  min_timer = g_min_timer.load(std::memory_order_relaxed);
+  g_last_seen_min_timer = min_timer;
+  if (now < min_timer) {
+    if (next != nullptr) *next = std::min(*next, min_timer);
+    return GRPC_TIMERS_CHECKED_AND_EMPTY;
+  }
+  if (!gpr_spinlock_trylock(&g_checker_mu)) return GRPC_TIMERS_NOT_CHECKED;
+
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_timer_check_trace)) {
+    gpr_log(GPR_INFO, "TIMER CHECK BEGIN: now=%" PRId64 " min=%" PRId64, now,
+            min_timer);
+  }
+  grpc_error_handle error =
+      now != GRPC_MILLIS_INF_FUTURE
+          ? GRPC_ERROR_NONE
+          : GRPC_ERROR_CREATE_FROM_STATIC_STRING("Shutting down timer system");
+  grpc_timer_check_result result = GRPC_TIMERS_CHECKED_AND_EMPTY;
+  grpc_millis new_min_timer = GRPC_MILLIS_INF_FUTURE;
+  for (size_t i = 0; i < g_num_wheels; i++) {
+    timer_wheel* wheel = &g_wheels[i];
+    if (wheel->min_deadline.load(std::memory_order_relaxed) <= now) {
+      gpr_mu_lock(&wheel->mu);
+      if (advance(wheel, now, error)) result = GRPC_TIMERS_FIRED;
+      wheel->min_deadline.store(compute_min_deadline(wheel),
+                                std::memory_order_relaxed);
+      gpr_mu_unlock(&wheel->mu);
+    }
+    new_min_timer = std::min(
+        new_min_timer, wheel->min_deadline.load(std::memory_order_relaxed));
+  }
+  GRPC_ERROR_UNREF(error);
+  // A concurrent grpc_timer_init() may have lowered g_min_timer after we read
+  // its wheel; keep whichever is lower in that case.
+  grpc_millis cur = min_timer;
+  while (!g_min_timer.compare_exchange_weak(cur, new_min_timer)) {
+    if (cur != min_timer) {
+      new_min_timer = std::min(cur, new_min_timer);
+      min_timer = cur;
+    }
+  }
+  // A grpc_timer_init() may also have lowered a wheel we already read while
+  // g_min_timer was still min_timer, and then left g_min_timer alone. Now that
+  // the new value is published, read the wheels again to catch that.
+  grpc_millis rechecked_min_timer = new_min_timer;
+  for (size_t i = 0; i < g_num_wheels; i++) {
+    rechecked_min_timer =
+        std::min(rechecked_min_timer, g_wheels[i].min_deadline.load());
+  }
+  bool lowered = false;
+  if (rechecked_min_timer < new_min_timer) {
+    new_min_timer = rechecked_min_timer;
+    lower_min_deadline(&g_min_timer, new_min_timer, &lowered);
+  }
+  gpr_spinlock_unlock(&g_checker_mu);
+  if (lowered) grpc_kick_poller();
+
+  if (next != nullptr) *next = std::min(*next, new_min_timer);
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_timer_check_trace)) {
+    gpr_log(GPR_INFO, "TIMER CHECK END: r=%d; min=%" PRId64, result,
+            new_min_timer);
+  }
+  return result;
+}
+
+}  // namespace
+
+grpc_timer_vtable grpc_wheel_timer_vtable = {
+    timer_init,      timer_cancel,        timer_check,
+    timer_list_init, timer_list_shutdown, timer_consume_kick};
@@ -0,0 +1,116 @@
+/*
+ *
+ * Copyright 2021 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPC_CORE_LIB_IOMGR_TURNSTILE_POLLSET_LINUX_H
+#define GRPC_CORE_LIB_IOMGR_TURNSTILE_POLLSET_LINUX_H
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/iomgr/ev_posix.h"
+#include "src/core/lib/iomgr/port.h"
+#include "src/core/lib/iomgr/wakeup_fd_posix.h"
+
+/* The pollsets of the polling engines that watch every fd through a single
+   kernel object (an epoll set for epoll1, an io_uring instance for io_uring).
+   Only one worker at a time, the designated poller, waits on that object;
+   the other workers wait on condition variables and one of them takes over
+   when the designated poller leaves (turnstile polling). Pollsets are grouped
+   in per-CPU neighborhoods so that a new designated poller is looked for close
+   to the one that left. Pollset sets are no-ops since every pollset sees
+   every fd.
+
+   An engine supplies the wait on its kernel object through a
+   grpc_turnstile_poller and takes the pollset and pollset set entries of its
+   vtable from here. */
+
+struct pollset_neighborhood;
+
+struct grpc_pollset {
+  gpr_mu mu;
+  struct pollset_neighborhood* neighborhood;
+  bool reassigning_neighborhood;
+  grpc_pollset_worker* root_worker;
+  bool kicked_without_poller;
+
+  /* Set to true if the pollset is observed to have no workers available to
+     poll */
+  bool seen_inactive;
+  bool shutting_down;             /* Is the pollset shutting down ? */
+  grpc_closure* shutdown_closure; /* Called after shutdown is complete */
+
+  /* Number of workers who are *about-to* attach themselves to the pollset
+   * worker list */
+  int begin_refs;
+
+  grpc_pollset* next;
+  grpc_pollset* prev;
+};
+
+/* The engine side of turnstile polling. All three functions are only called
+   by the designated poller, without the pollset lock held. */
+typedef struct grpc_turnstile_poller {
+  /* Returns true if events found by the last call to wait() are still waiting
+     to be processed, in which case pollset_work() skips the wait */
+  bool (*has_pending_events)(void);
+  /* Waits for events until deadline and keeps them for process_events() */
+  grpc_error_handle (*wait)(grpc_pollset* pollset, grpc_millis deadline);
+  /* Handles some of the events kept by wait(). It should only schedule
+     closures: they are run once another designated poller has been chosen */
+  grpc_error_handle (*process_events)(grpc_pollset* pollset);
+} grpc_turnstile_poller;
+
+/* Sets up the global state of the pollsets, including the wakeup fd used to
+   kick the designated poller, for an engine that waits through poller. Must be
+   called *only* once per engine initialization. */
+grpc_error_handle grpc_turnstile_pollset_global_init(
+    const grpc_turnstile_poller* poller);
+void grpc_turnstile_pollset_global_shutdown(void);
+
+/* The wakeup fd that kicks the designated poller. The engine must watch its
+   read end and consume the wakeup when it becomes readable. */
+grpc_wakeup_fd* grpc_turnstile_wakeup_fd(void);
+
+/* Converts deadline to a timeout in milliseconds: -1 for an infinite
+   deadline, 0 if it has passed */
+int grpc_turnstile_deadline_to_millis_timeout(grpc_millis deadline);
+
+void grpc_turnstile_pollset_init(grpc_pollset* pollset, gpr_mu** mu);
+void grpc_turnstile_pollset_shutdown(grpc_pollset* pollset,
+                                     grpc_closure* closure);
+void grpc_turnstile_pollset_destroy(grpc_pollset* pollset);
+grpc_error_handle grpc_turnstile_pollset_work(grpc_pollset* pollset,
+                                              grpc_pollset_worker** worker_hdl,
+                                              grpc_millis deadline);
+grpc_error_handle grpc_turnstile_pollset_kick(
+    grpc_pollset* pollset, grpc_pollset_worker* specific_worker);
+void grpc_turnstile_pollset_add_fd(grpc_pollset* pollset, grpc_fd* fd);
+
+grpc_pollset_set* grpc_turnstile_pollset_set_create(void);
+void grpc_turnstile_pollset_set_destroy(grpc_pollset_set* pss);
+void grpc_turnstile_pollset_set_add_pollset(grpc_pollset_set* pss,
+                                            grpc_pollset* ps);
+void grpc_turnstile_pollset_set_del_pollset(grpc_pollset_set* pss,
+                                            grpc_pollset* ps);
+void grpc_turnstile_pollset_set_add_pollset_set(grpc_pollset_set* bag,
+                                                grpc_pollset_set* item);
+void grpc_turnstile_pollset_set_del_pollset_set(grpc_pollset_set* bag,
+                                                grpc_pollset_set* item);
+void grpc_turnstile_pollset_set_add_fd(grpc_pollset_set* pss, grpc_fd* fd);
+void grpc_turnstile_pollset_set_del_fd(grpc_pollset_set* pss, grpc_fd* fd);
+
+#endif /* GRPC_CORE_LIB_IOMGR_TURNSTILE_POLLSET_LINUX_H */
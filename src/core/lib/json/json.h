@@ -33,6 +33,28 @@
 
 namespace grpc_core {
 
+// Receives the contents of a JSON text as it is parsed, in document order,
+// without any tree being built.  String arguments point into the parser's
+// input or scratch space and are valid only for the duration of the call.
+class JsonEventHandler {
+ public:
+  virtual ~JsonEventHandler() = default;
+
+  virtual void StartObject() = 0;
+  virtual void EndObject() = 0;
+  virtual void StartArray() = 0;
+  virtual void EndArray() = 0;
+  // Called with the name of each object member, before its value.
+  // Returns false if the enclosing object already has a member named key,
+  // which makes the parse fail.
+  virtual bool Key(absl::string_view key) = 0;
+  virtual void String(absl::string_view value) = 0;
+  // The value is passed exactly as it appears in the input.
+  virtual void Number(absl::string_view value) = 0;
+  virtual void Bool(bool value) = 0;
+  virtual void Null() = 0;
+};
+
 // A JSON value, which can be any one of object, array, string,
 // number, true, false, or null.
 class Json {
@@ -57,6 +79,11 @@ class Json {
 
   // Parses JSON string from json_str.  On error, sets *error.
   static Json Parse(absl::string_view json_str, grpc_error_handle* error);
+  // Parses JSON string from json_str, passing its contents to handler.
+  // Returns an error if json_str is not valid JSON; handler may have seen
+  // part of it by then.
+  static grpc_error_handle Parse(absl::string_view json_str,
+                                 JsonEventHandler* handler);
 
   Json() = default;
 
@@ -245,6 +272,34 @@ class Json {
   Array array_value_;
 };
 
+// A JsonEventHandler that assembles the events into a Json value.
+class JsonTreeBuilder : public JsonEventHandler {
+ public:
+  void StartObject() override;
+  void EndObject() override;
+  void StartArray() override;
+  void EndArray() override;
+  bool Key(absl::string_view key) override;
+  void String(absl::string_view value) override;
+  void Number(absl::string_view value) override;
+  void Bool(bool value) override;
+  void Null() override;
+
+  // Returns the value built so far and resets the builder, so that it can
+  // be fed the events for another value.
+  Json TakeValue();
+
+ private:
+  Json* CreateAndLinkValue();
+  void StartContainer(Json container);
+  void EndContainer();
+
+  Json root_value_;
+  std::vector<Json*> stack_;
+  // The object member added by the last call to Key().
+  Json* member_ = nullptr;
+};
+
 }  // namespace grpc_core
 
 #endif /* GRPC_CORE_LIB_JSON_JSON_H */
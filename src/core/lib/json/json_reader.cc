@@ -38,7 +38,8 @@ namespace {
 
 class JsonReader {
  public:
-  static grpc_error_handle Parse(absl::string_view input, Json* output);
+  static grpc_error_handle Parse(absl::string_view input,
+                                 JsonEventHandler* handler);
 
  private:
   enum class Status {
@@ -84,10 +85,11 @@ class JsonReader {
    */
   static constexpr uint32_t GRPC_JSON_READ_CHAR_EOF = 0x7ffffff0;
 
-  explicit JsonReader(absl::string_view input)
+  JsonReader(absl::string_view input, JsonEventHandler* handler)
       : original_input_(reinterpret_cast<const uint8_t*>(input.data())),
         input_(original_input_),
-        remaining_input_(input.size()) {}
+        remaining_input_(input.size()),
+        handler_(handler) {}
 
   Status Run();
   uint32_t ReadChar();
@@ -95,10 +97,17 @@ class JsonReader {
 
   size_t CurrentIndex() const { return input_ - original_input_ - 1; }
 
+  void AddError(std::string error);
+
+  void StartString(const uint8_t* start);
+  void StringAddPlainChar(uint32_t c);
+  void StringAddPlainChars();
+  void StringStartEscape();
   void StringAddChar(uint32_t c);
   void StringAddUtf32(uint32_t c);
+  absl::string_view CurrentString() const;
 
-  Json* CreateAndLinkValue();
+  void StartValue();
   bool StartContainer(Json::Type type);
   void EndContainer();
   void SetKey();
@@ -111,6 +120,7 @@ class JsonReader {
   const uint8_t* original_input_;
   const uint8_t* input_;
   size_t remaining_input_;
+  JsonEventHandler* handler_;
 
   State state_ = State::GRPC_JSON_STATE_VALUE_BEGIN;
   bool escaped_string_was_key_ = false;
@@ -119,14 +129,69 @@ class JsonReader {
   uint16_t unicode_high_surrogate_ = 0;
   std::vector<grpc_error_handle> errors_;
   bool truncated_errors_ = false;
+  // Set when the handler rejects a key, which is reported once its value
+  // starts.
+  bool duplicate_key_ = false;
+  std::string key_;
 
-  Json root_value_;
-  std::vector<Json*> stack_;
+  // The type of each open container.
+  std::vector<Json::Type> stack_;
 
-  std::string key_;
+  // Strings and numbers are handed to handler_ as views of the input.  Only
+  // strings that contain escape sequences are copied, into string_, as they
+  // are unescaped.
+  const uint8_t* string_start_ = nullptr;
+  bool string_escaped_ = false;
   std::string string_;
 };
 
+void JsonReader::AddError(std::string error) {
+  if (errors_.size() == GRPC_JSON_MAX_ERRORS) {
+    truncated_errors_ = true;
+  } else {
+    errors_.push_back(GRPC_ERROR_CREATE_FROM_CPP_STRING(std::move(error)));
+  }
+}
+
+void JsonReader::StartString(const uint8_t* start) {
+  string_start_ = start;
+  string_escaped_ = false;
+}
+
+void JsonReader::StringAddPlainChar(uint32_t c) {
+  if (string_escaped_) StringAddChar(c);
+}
+
+// Consumes the run of characters following a plain string character that
+// need neither unescaping nor any other attention from the state machine.
+void JsonReader::StringAddPlainChars() {
+  const uint8_t* end = input_;
+  const uint8_t* input_end = input_ + remaining_input_;
+  while (end != input_end && *end >= 32 && *end != '"' && *end != '\\') {
+    ++end;
+  }
+  if (string_escaped_) {
+    string_.append(reinterpret_cast<const char*>(input_), end - input_);
+  }
+  remaining_input_ -= end - input_;
+  input_ = end;
+}
+
+// Called on the backslash that starts an escape sequence.
+void JsonReader::StringStartEscape() {
+  if (string_escaped_) return;
+  string_.assign(reinterpret_cast<const char*>(string_start_),
+                 input_ - 1 - string_start_);
+  string_escaped_ = true;
+}
+
+// Returns the string or number that ended with the character just read.
+absl::string_view JsonReader::CurrentString() const {
+  if (string_escaped_) return string_;
+  return absl::string_view(reinterpret_cast<const char*>(string_start_),
+                           input_ - 1 - string_start_);
+}
+
 void JsonReader::StringAddChar(uint32_t c) {
   string_.push_back(static_cast<uint8_t>(c));
 }
@@ -169,90 +234,73 @@ uint32_t JsonReader::ReadChar() {
   return r;
 }
 
-Json* JsonReader::CreateAndLinkValue() {
-  Json* value;
-  if (stack_.empty()) {
-    value = &root_value_;
-  } else {
-    Json* parent = stack_.back();
-    if (parent->type() == Json::Type::OBJECT) {
-      if (parent->object_value().find(key_) != parent->object_value().end()) {
-        if (errors_.size() == GRPC_JSON_MAX_ERRORS) {
-          truncated_errors_ = true;
-        } else {
-          errors_.push_back(GRPC_ERROR_CREATE_FROM_CPP_STRING(
-              absl::StrFormat("duplicate key \"%s\" at index %" PRIuPTR, key_,
-                              CurrentIndex())));
-        }
-      }
-      value = &(*parent->mutable_object())[std::move(key_)];
-    } else {
-      GPR_ASSERT(parent->type() == Json::Type::ARRAY);
-      parent->mutable_array()->emplace_back();
-      value = &parent->mutable_array()->back();
-    }
-  }
-  return value;
+void JsonReader::StartValue() {
+  if (!duplicate_key_) return;
+  AddError(absl::StrFormat("duplicate key \"%s\" at index %" PRIuPTR, key_,
+                           CurrentIndex()));
+  duplicate_key_ = false;
 }
 
 bool JsonReader::StartContainer(Json::Type type) {
   if (stack_.size() == GRPC_JSON_MAX_DEPTH) {
-    if (errors_.size() == GRPC_JSON_MAX_ERRORS) {
-      truncated_errors_ = true;
-    } else {
-      errors_.push_back(GRPC_ERROR_CREATE_FROM_CPP_STRING(
-          absl::StrFormat("exceeded max stack depth (%d) at index %" PRIuPTR,
-                          GRPC_JSON_MAX_DEPTH, CurrentIndex())));
-    }
+    AddError(absl::StrFormat("exceeded max stack depth (%d) at index %" PRIuPTR,
+                             GRPC_JSON_MAX_DEPTH, CurrentIndex()));
     return false;
   }
-  Json* value = CreateAndLinkValue();
+  StartValue();
   if (type == Json::Type::OBJECT) {
-    *value = Json::Object();
+    handler_->StartObject();
   } else {
     GPR_ASSERT(type == Json::Type::ARRAY);
-    *value = Json::Array();
+    handler_->StartArray();
   }
-  stack_.push_back(value);
+  stack_.push_back(type);
   return true;
 }
 
 void JsonReader::EndContainer() {
   GPR_ASSERT(!stack_.empty());
+  if (stack_.back() == Json::Type::OBJECT) {
+    handler_->EndObject();
+  } else {
+    handler_->EndArray();
+  }
   stack_.pop_back();
 }
 
 void JsonReader::SetKey() {
-  key_ = std::move(string_);
-  string_.clear();
+  absl::string_view key = CurrentString();
+  if (!handler_->Key(key)) {
+    duplicate_key_ = true;
+    key_ = std::string(key);
+  }
 }
 
 void JsonReader::SetString() {
-  Json* value = CreateAndLinkValue();
-  *value = std::move(string_);
-  string_.clear();
+  StartValue();
+  handler_->String(CurrentString());
 }
 
 bool JsonReader::SetNumber() {
-  Json* value = CreateAndLinkValue();
-  *value = Json(string_, /*is_number=*/true);
-  string_.clear();
+  StartValue();
+  handler_->Number(CurrentString());
   return true;
 }
 
 void JsonReader::SetTrue() {
-  Json* value = CreateAndLinkValue();
-  *value = true;
-  string_.clear();
+  StartValue();
+  handler_->Bool(true);
 }
 
 void JsonReader::SetFalse() {
-  Json* value = CreateAndLinkValue();
-  *value = false;
-  string_.clear();
+  StartValue();
+  handler_->Bool(false);
 }
 
-void JsonReader::SetNull() { CreateAndLinkValue(); }
+void JsonReader::SetNull() {
+  StartValue();
+  handler_->Null();
+}
 
 bool JsonReader::IsComplete() {
   return (stack_.empty() && (state_ == State::GRPC_JSON_STATE_END ||
@@ -299,7 +347,7 @@ JsonReader::Status JsonReader::Run() {
             if (unicode_high_surrogate_ != 0) {
               return Status::GRPC_JSON_PARSE_ERROR;
             }
-            StringAddChar(c);
+            StringAddPlainChar(c);
             break;
 
           case State::GRPC_JSON_STATE_VALUE_NUMBER:
@@ -325,7 +373,7 @@ JsonReader::Status JsonReader::Run() {
             if (unicode_high_surrogate_ != 0) {
               return Status::GRPC_JSON_PARSE_ERROR;
             }
-            StringAddChar(c);
+            StringAddPlainChar(c);
             break;
 
           case State::GRPC_JSON_STATE_VALUE_NUMBER:
@@ -335,9 +383,9 @@ JsonReader::Status JsonReader::Run() {
             if (stack_.empty()) {
               return Status::GRPC_JSON_PARSE_ERROR;
             } else if (c == '}' &&
-                       stack_.back()->type() != Json::Type::OBJECT) {
+                       stack_.back() != Json::Type::OBJECT) {
               return Status::GRPC_JSON_PARSE_ERROR;
-            } else if (c == ']' && stack_.back()->type() != Json::Type::ARRAY) {
+            } else if (c == ']' && stack_.back() != Json::Type::ARRAY) {
               return Status::GRPC_JSON_PARSE_ERROR;
             }
             if (!SetNumber()) return Status::GRPC_JSON_PARSE_ERROR;
@@ -352,10 +400,10 @@ JsonReader::Status JsonReader::Run() {
                 return Status::GRPC_JSON_PARSE_ERROR;
               }
               if (!stack_.empty() &&
-                  stack_.back()->type() == Json::Type::OBJECT) {
+                  stack_.back() == Json::Type::OBJECT) {
                 state_ = State::GRPC_JSON_STATE_OBJECT_KEY_BEGIN;
               } else if (!stack_.empty() &&
-                         stack_.back()->type() == Json::Type::ARRAY) {
+                         stack_.back() == Json::Type::ARRAY) {
                 state_ = State::GRPC_JSON_STATE_VALUE_BEGIN;
               } else {
                 return Status::GRPC_JSON_PARSE_ERROR;
@@ -364,7 +412,7 @@ JsonReader::Status JsonReader::Run() {
               if (stack_.empty()) {
                 return Status::GRPC_JSON_PARSE_ERROR;
               }
-              if (c == '}' && stack_.back()->type() != Json::Type::OBJECT) {
+              if (c == '}' && stack_.back() != Json::Type::OBJECT) {
                 return Status::GRPC_JSON_PARSE_ERROR;
               }
               if (c == '}' &&
@@ -372,7 +420,7 @@ JsonReader::Status JsonReader::Run() {
                   !container_just_begun_) {
                 return Status::GRPC_JSON_PARSE_ERROR;
               }
-              if (c == ']' && stack_.back()->type() != Json::Type::ARRAY) {
+              if (c == ']' && stack_.back() != Json::Type::ARRAY) {
                 return Status::GRPC_JSON_PARSE_ERROR;
               }
               if (c == ']' && state_ == State::GRPC_JSON_STATE_VALUE_BEGIN &&
@@ -396,11 +444,13 @@ JsonReader::Status JsonReader::Run() {
       case '\\':
         switch (state_) {
           case State::GRPC_JSON_STATE_OBJECT_KEY_STRING:
+            StringStartEscape();
             escaped_string_was_key_ = true;
             state_ = State::GRPC_JSON_STATE_STRING_ESCAPE;
             break;
 
           case State::GRPC_JSON_STATE_VALUE_STRING:
+            StringStartEscape();
             escaped_string_was_key_ = false;
             state_ = State::GRPC_JSON_STATE_STRING_ESCAPE;
             break;
@@ -428,6 +478,7 @@ JsonReader::Status JsonReader::Run() {
         switch (state_) {
           case State::GRPC_JSON_STATE_OBJECT_KEY_BEGIN:
             if (c != '"') return Status::GRPC_JSON_PARSE_ERROR;
+            StartString(input_);
             state_ = State::GRPC_JSON_STATE_OBJECT_KEY_STRING;
             break;
 
@@ -440,7 +491,8 @@ JsonReader::Status JsonReader::Run() {
               SetKey();
             } else {
               if (c < 32) return Status::GRPC_JSON_PARSE_ERROR;
-              StringAddChar(c);
+              StringAddPlainChar(c);
+              StringAddPlainChars();
             }
             break;
 
@@ -453,7 +505,8 @@ JsonReader::Status JsonReader::Run() {
               SetString();
             } else {
               if (c < 32) return Status::GRPC_JSON_PARSE_ERROR;
-              StringAddChar(c);
+              StringAddPlainChar(c);
+              StringAddPlainChars();
             }
             break;
 
@@ -477,11 +530,12 @@ JsonReader::Status JsonReader::Run() {
                 break;
 
               case '"':
+                StartString(input_);
                 state_ = State::GRPC_JSON_STATE_VALUE_STRING;
                 break;
 
               case '0':
-                StringAddChar(c);
+                StartString(input_ - 1);
                 state_ = State::GRPC_JSON_STATE_VALUE_NUMBER_ZERO;
                 break;
 
@@ -495,7 +549,7 @@ JsonReader::Status JsonReader::Run() {
               case '8':
               case '9':
               case '-':
-                StringAddChar(c);
+                StartString(input_ - 1);
                 state_ = State::GRPC_JSON_STATE_VALUE_NUMBER;
                 break;
 
@@ -623,7 +677,6 @@ JsonReader::Status JsonReader::Run() {
             break;
 
           case State::GRPC_JSON_STATE_VALUE_NUMBER:
-            StringAddChar(c);
             switch (c) {
               case '0':
               case '1':
@@ -649,7 +702,6 @@ JsonReader::Status JsonReader::Run() {
             break;
 
           case State::GRPC_JSON_STATE_VALUE_NUMBER_WITH_DECIMAL:
-            StringAddChar(c);
             switch (c) {
               case '0':
               case '1':
@@ -673,12 +725,10 @@ JsonReader::Status JsonReader::Run() {
 
           case State::GRPC_JSON_STATE_VALUE_NUMBER_ZERO:
             if (c != '.') return Status::GRPC_JSON_PARSE_ERROR;
-            StringAddChar(c);
             state_ = State::GRPC_JSON_STATE_VALUE_NUMBER_DOT;
             break;
 
           case State::GRPC_JSON_STATE_VALUE_NUMBER_DOT:
-            StringAddChar(c);
             switch (c) {
               case '0':
               case '1':
@@ -698,7 +748,6 @@ JsonReader::Status JsonReader::Run() {
             break;
 
           case State::GRPC_JSON_STATE_VALUE_NUMBER_E:
-            StringAddChar(c);
             switch (c) {
               case '0':
               case '1':
@@ -720,7 +769,6 @@ JsonReader::Status JsonReader::Run() {
             break;
 
           case State::GRPC_JSON_STATE_VALUE_NUMBER_EPM:
-            StringAddChar(c);
             switch (c) {
               case '0':
               case '1':
@@ -815,8 +863,9 @@ JsonReader::Status JsonReader::Run() {
   GPR_UNREACHABLE_CODE(return Status::GRPC_JSON_INTERNAL_ERROR);
 }
 
-grpc_error_handle JsonReader::Parse(absl::string_view input, Json* output) {
-  JsonReader reader(input);
+grpc_error_handle JsonReader::Parse(absl::string_view input,
+                                    JsonEventHandler* handler) {
+  JsonReader reader(input, handler);
   Status status = reader.Run();
   if (reader.truncated_errors_) {
     reader.errors_.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
@@ -830,20 +879,82 @@ grpc_error_handle JsonReader::Parse(absl::string_view input, Json* output) {
     reader.errors_.push_back(GRPC_ERROR_CREATE_FROM_CPP_STRING(
         absl::StrCat("JSON parse error at index ", reader.CurrentIndex())));
   }
-  if (!reader.errors_.empty()) {
-    return GRPC_ERROR_CREATE_FROM_VECTOR("JSON parsing failed",
-                                         &reader.errors_);
-  }
-  *output = std::move(reader.root_value_);
-  return GRPC_ERROR_NONE;
+  return GRPC_ERROR_CREATE_FROM_VECTOR("JSON parsing failed", &reader.errors_);
 }
 
 }  // namespace
 
+//
+// JsonTreeBuilder
+//
+
+Json* JsonTreeBuilder::CreateAndLinkValue() {
+  if (stack_.empty()) return &root_value_;
+  Json* parent = stack_.back();
+  if (parent->type() == Json::Type::OBJECT) return member_;
+  GPR_ASSERT(parent->type() == Json::Type::ARRAY);
+  parent->mutable_array()->emplace_back();
+  return &parent->mutable_array()->back();
+}
+
+void JsonTreeBuilder::StartContainer(Json container) {
+  Json* value = CreateAndLinkValue();
+  *value = std::move(container);
+  stack_.push_back(value);
+}
+
+void JsonTreeBuilder::EndContainer() {
+  GPR_ASSERT(!stack_.empty());
+  stack_.pop_back();
+}
+
+void JsonTreeBuilder::StartObject() { StartContainer(Json::Object()); }
+
+void JsonTreeBuilder::EndObject() { EndContainer(); }
+
+void JsonTreeBuilder::StartArray() { StartContainer(Json::Array()); }
+
+void JsonTreeBuilder::EndArray() { EndContainer(); }
+
+bool JsonTreeBuilder::Key(absl::string_view key) {
+  auto result =
+      stack_.back()->mutable_object()->emplace(std::string(key), Json());
+  member_ = &result.first->second;
+  return result.second;
+}
+
+void JsonTreeBuilder::String(absl::string_view value) {
+  *CreateAndLinkValue() = std::string(value);
+}
+
+void JsonTreeBuilder::Number(absl::string_view value) {
+  *CreateAndLinkValue() = Json(std::string(value), /*is_number=*/true);
+}
+
+void JsonTreeBuilder::Bool(bool value) { *CreateAndLinkValue() = value; }
+
+void JsonTreeBuilder::Null() { CreateAndLinkValue(); }
+
+Json JsonTreeBuilder::TakeValue() {
+  stack_.clear();
+  member_ = nullptr;
+  return std::move(root_value_);
+}
+
+//
+// Json
+//
+
+grpc_error_handle Json::Parse(absl::string_view json_str,
+                              JsonEventHandler* handler) {
+  return JsonReader::Parse(json_str, handler);
+}
+
 Json Json::Parse(absl::string_view json_str, grpc_error_handle* error) {
-  Json value;
-  *error = JsonReader::Parse(json_str, &value);
-  return value;
+  JsonTreeBuilder builder;
+  *error = Parse(json_str, &builder);
+  if (*error != GRPC_ERROR_NONE) return Json();
+  return builder.TakeValue();
 }
 
 }  // namespace grpc_core
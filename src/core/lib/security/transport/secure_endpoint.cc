@@ -20,6 +20,16 @@
 
 #include "src/core/lib/security/transport/secure_endpoint.h"
 
+#include "src/core/lib/iomgr/port.h"
+
+#ifdef GRPC_LINUX_KTLS
+#include <errno.h>
+#include <linux/tls.h>
+#include <netinet/tcp.h>
+#include <string.h>
+#include <sys/socket.h>
+#endif
+
 #include <new>
 
 #include <grpc/slice.h>
@@ -36,8 +46,13 @@
 #include "src/core/lib/security/transport/tsi_error.h"
 #include "src/core/lib/slice/slice_internal.h"
 #include "src/core/lib/slice/slice_string_helpers.h"
+#include "src/core/tsi/ssl_transport_security.h"
 #include "src/core/tsi/transport_security_grpc.h"
 
+extern "C" {
+#include <openssl/crypto.h>
+}
+
 #define STAGING_BUFFER_SIZE 8192
 
 static void on_read(void* user_data, grpc_error_handle error);
@@ -94,6 +109,8 @@ struct secure_endpoint {
   grpc_slice read_staging_buffer = GRPC_SLICE_MALLOC(STAGING_BUFFER_SIZE);
   grpc_slice write_staging_buffer = GRPC_SLICE_MALLOC(STAGING_BUFFER_SIZE);
   grpc_slice_buffer output_buffer;
+  /* set once the kernel encrypts what is written to wrapped_ep's socket. */
+  bool kernel_tls_tx = false;
 
   gpr_refcount ref;
 };
@@ -298,6 +315,11 @@ static void endpoint_write(grpc_endpoint* secure_ep, grpc_slice_buffer* slices,
     }
   }
 
+  if (ep->kernel_tls_tx) {
+    grpc_endpoint_write(ep->wrapped_ep, slices, cb, arg);
+    return;
+  }
+
   if (ep->zero_copy_protector != nullptr) {
     // Use zero-copy grpc protector to protect.
     result = tsi_zero_copy_grpc_protector_protect(ep->zero_copy_protector,
@@ -418,6 +440,13 @@ static bool endpoint_can_track_err(grpc_endpoint* secure_ep) {
   return grpc_endpoint_can_track_err(ep->wrapped_ep);
 }
 
+static void endpoint_set_read_hint(grpc_endpoint* secure_ep, size_t bytes) {
+  secure_endpoint* ep = reinterpret_cast<secure_endpoint*>(secure_ep);
+  // The protected frames are only slightly larger than the plaintext the
+  // reader is waiting for, so the hint carries over as is.
+  grpc_endpoint_set_read_hint(ep->wrapped_ep, bytes);
+}
+
 static const grpc_endpoint_vtable vtable = {endpoint_read,
                                             endpoint_write,
                                             endpoint_add_to_pollset,
@@ -428,7 +457,8 @@ static const grpc_endpoint_vtable vtable = {endpoint_read,
                                             endpoint_get_peer,
                                             endpoint_get_local_address,
                                             endpoint_get_fd,
-                                            endpoint_can_track_err};
+                                            endpoint_can_track_err,
+                                            endpoint_set_read_hint};
 
 grpc_endpoint* grpc_secure_endpoint_create(
     struct tsi_frame_protector* protector,
@@ -440,3 +470,71 @@ grpc_endpoint* grpc_secure_endpoint_create(
                           leftover_slices, leftover_nslices);
   return &ep->base;
 }
+
+bool grpc_secure_endpoint_enable_kernel_tls_tx(
+    grpc_endpoint* secure_ep, const tsi_ssl_write_traffic_keys& keys) {
+#ifdef GRPC_LINUX_KTLS
+  secure_endpoint* ep = reinterpret_cast<secure_endpoint*>(secure_ep);
+  int fd = grpc_endpoint_get_fd(ep->wrapped_ep);
+  if (fd < 0) return false;
+  union {
+    tls12_crypto_info_aes_gcm_128 aes_gcm_128;
+#ifdef TLS_CIPHER_AES_GCM_256
+    tls12_crypto_info_aes_gcm_256 aes_gcm_256;
+#endif
+  } crypto_info;
+  memset(&crypto_info, 0, sizeof(crypto_info));
+  socklen_t crypto_info_size;
+  switch (keys.key_size) {
+    case TLS_CIPHER_AES_GCM_128_KEY_SIZE:
+      crypto_info.aes_gcm_128.info.cipher_type = TLS_CIPHER_AES_GCM_128;
+      memcpy(crypto_info.aes_gcm_128.key, keys.key, keys.key_size);
+      memcpy(crypto_info.aes_gcm_128.salt, keys.salt, sizeof(keys.salt));
+      memcpy(crypto_info.aes_gcm_128.iv, keys.iv, sizeof(keys.iv));
+      memcpy(crypto_info.aes_gcm_128.rec_seq, keys.record_sequence,
+             sizeof(keys.record_sequence));
+      crypto_info_size = sizeof(crypto_info.aes_gcm_128);
+      break;
+#ifdef TLS_CIPHER_AES_GCM_256
+    case TLS_CIPHER_AES_GCM_256_KEY_SIZE:
+      crypto_info.aes_gcm_256.info.cipher_type = TLS_CIPHER_AES_GCM_256;
+      memcpy(crypto_info.aes_gcm_256.key, keys.key, keys.key_size);
+      memcpy(crypto_info.aes_gcm_256.salt, keys.salt, sizeof(keys.salt));
+      memcpy(crypto_info.aes_gcm_256.iv, keys.iv, sizeof(keys.iv));
+      memcpy(crypto_info.aes_gcm_256.rec_seq, keys.record_sequence,
+             sizeof(keys.record_sequence));
+      crypto_info_size = sizeof(crypto_info.aes_gcm_256);
+      break;
+#endif
+    default:
+      return false;
+  }
+  /* Both crypto_info layouts start with the same header. */
+  crypto_info.aes_gcm_128.info.version =
+      static_cast<__u16>(keys.tls_version);
+  /* Attaching the tls ULP alone doesn't change what goes over the socket, so
+     the connection is still usable if either step fails, e.g. because the
+     tls module isn't loaded or doesn't know the TLS version or cipher. */
+  bool ok = setsockopt(fd, SOL_TCP, TCP_ULP, "tls", sizeof("tls")) == 0 &&
+            setsockopt(fd, SOL_TLS, TLS_TX, &crypto_info, crypto_info_size) ==
+                0;
+  OPENSSL_cleanse(&crypto_info, sizeof(crypto_info));
+  if (!ok) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_trace_secure_endpoint)) {
+      gpr_log(GPR_INFO, "SECENDP %p: kernel TLS unavailable: %s", ep,
+              strerror(errno));
+    }
+    return false;
+  }
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_trace_secure_endpoint)) {
+    gpr_log(GPR_INFO, "SECENDP %p: kernel TLS encrypts writes on fd %d", ep,
+            fd);
+  }
+  ep->kernel_tls_tx = true;
+  return true;
+#else
+  (void)secure_ep;
+  (void)keys;
+  return false;
+#endif
+}
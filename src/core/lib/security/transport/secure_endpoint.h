@@ -26,6 +26,7 @@
 #include "src/core/lib/iomgr/endpoint.h"
 
 struct tsi_frame_protector;
+struct tsi_ssl_write_traffic_keys;
 struct tsi_zero_copy_grpc_protector;
 
 extern grpc_core::TraceFlag grpc_trace_secure_endpoint;
@@ -39,4 +40,13 @@ grpc_endpoint* grpc_secure_endpoint_create(
     grpc_endpoint* to_wrap, grpc_slice* leftover_slices,
     size_t leftover_nslices);
 
+/* Hands encryption of everything written to secure_ep from now on to the
+   Linux kernel TLS module, using the write traffic keys exported from the TLS
+   session behind secure_ep's protector. Writes then go to the wrapped endpoint
+   as is; reads are still unprotected in userspace. Must be called before
+   anything is written. Returns false, leaving secure_ep unchanged, if the
+   wrapped endpoint has no socket or the kernel can't take the keys. */
+bool grpc_secure_endpoint_enable_kernel_tls_tx(
+    grpc_endpoint* secure_ep, const tsi_ssl_write_traffic_keys& keys);
+
 #endif /* GRPC_CORE_LIB_SECURITY_TRANSPORT_SECURE_ENDPOINT_H */
@@ -38,8 +38,13 @@
 #include "src/core/lib/security/transport/secure_endpoint.h"
 #include "src/core/lib/security/transport/tsi_error.h"
 #include "src/core/lib/slice/slice_internal.h"
+#include "src/core/tsi/ssl_transport_security.h"
 #include "src/core/tsi/transport_security_grpc.h"
 
+extern "C" {
+#include <openssl/crypto.h>
+}
+
 #define GRPC_INITIAL_HANDSHAKE_BUFFER_SIZE 256
 
 namespace grpc_core {
@@ -107,6 +112,7 @@ class SecurityHandshaker : public Handshaker {
   RefCountedPtr<grpc_auth_context> auth_context_;
   tsi_handshaker_result* handshaker_result_ = nullptr;
   size_t max_frame_size_ = 0;
+  bool kernel_tls_offload_enabled_ = false;
 };
 
 SecurityHandshaker::SecurityHandshaker(tsi_handshaker* handshaker,
@@ -123,6 +129,18 @@ SecurityHandshaker::SecurityHandshaker(tsi_handshaker* handshaker,
     max_frame_size_ = grpc_channel_arg_get_integer(
         arg, {0, 0, std::numeric_limits<int>::max()});
   }
+  // The kernel rejects MSG_ZEROCOPY sends on sockets it encrypts for.
+  kernel_tls_offload_enabled_ =
+      grpc_channel_args_find_bool(args, GRPC_ARG_TLS_KERNEL_OFFLOAD_ENABLED,
+                                  false) &&
+      !grpc_channel_args_find_bool(args, GRPC_ARG_TCP_TX_ZEROCOPY_ENABLED,
+                                   false);
+  // Only SSL handshakers can export their keys, and only when asked to before
+  // the handshake.
+  if (kernel_tls_offload_enabled_ &&
+      tsi_ssl_handshaker_track_write_traffic(handshaker) != TSI_OK) {
+    kernel_tls_offload_enabled_ = false;
+  }
   grpc_slice_buffer_init(&outgoing_);
   GRPC_CLOSURE_INIT(&on_peer_checked_, &SecurityHandshaker::OnPeerCheckedFn,
                     this, grpc_schedule_on_exec_ctx);
@@ -232,6 +250,13 @@ void SecurityHandshaker::OnPeerCheckedInner(grpc_error_handle error) {
     HandshakeFailedLocked(error);
     return;
   }
+  // Export the write traffic keys for the kernel before the frame protector
+  // takes over the TLS session.
+  tsi_ssl_write_traffic_keys write_traffic_keys;
+  bool offload_writes =
+      kernel_tls_offload_enabled_ &&
+      tsi_ssl_handshaker_result_get_write_traffic_keys(
+          handshaker_result_, &write_traffic_keys) == TSI_OK;
   // Create zero-copy frame protector, if implemented.
   tsi_zero_copy_grpc_protector* zero_copy_protector = nullptr;
   tsi_result result = tsi_handshaker_result_create_zero_copy_grpc_protector(
@@ -275,6 +300,11 @@ void SecurityHandshaker::OnPeerCheckedInner(grpc_error_handle error) {
     args_->endpoint = grpc_secure_endpoint_create(
         protector, zero_copy_protector, args_->endpoint, nullptr, 0);
   }
+  if (offload_writes) {
+    grpc_secure_endpoint_enable_kernel_tls_tx(args_->endpoint,
+                                              write_traffic_keys);
+    OPENSSL_cleanse(&write_traffic_keys, sizeof(write_traffic_keys));
+  }
   tsi_handshaker_result_destroy(handshaker_result_);
   handshaker_result_ = nullptr;
   // Add auth context to channel args.
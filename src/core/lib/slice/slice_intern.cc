@@ -21,6 +21,10 @@
 #include <inttypes.h>
 #include <string.h>
 
+#include <atomic>
+#include <type_traits>
+#include <vector>
+
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 
@@ -42,15 +46,76 @@
 
 using grpc_core::InternedSliceRefcount;
 
+// A bucket array. Lookups may still be reading a table after it has been
+// replaced, so tables are retired like the slices themselves.
+struct slice_table {
+  size_t capacity;
+  std::atomic<InternedSliceRefcount*> buckets[1];
+};
+
+// Interned slices are looked up without taking the shard lock: lookups only
+// count themselves in readers while they walk the buckets. Inserting,
+// unlinking and growing take the lock, and memory unlinked from the table is
+// retired rather than freed until readers is seen to be zero, at which point
+// no lookup can still reach it. Whichever of the writer and the last lookup
+// out sees readers at zero frees the retired memory, so it is reclaimed as
+// soon as the shard has no lookups in flight.
 typedef struct slice_shard {
+  std::atomic<size_t> readers;
+  // Whether retired is non-empty; lets lookups check without the lock.
+  std::atomic<bool> has_retired;
+  std::atomic<slice_table*> table;
   grpc_core::Mutex mu;
-  InternedSliceRefcount** strs;
   size_t count;
-  size_t capacity;
+  // Unlinked slices and replaced tables, to be freed.
+  std::vector<void*> retired;
+  char padding[GPR_CACHELINE_SIZE];
 } slice_shard;
 
 static slice_shard* g_shards;
 
+static slice_table* new_table(size_t capacity) {
+  slice_table* table = static_cast<slice_table*>(
+      gpr_malloc(sizeof(slice_table) +
+                 sizeof(std::atomic<InternedSliceRefcount*>) * (capacity - 1)));
+  table->capacity = capacity;
+  for (size_t i = 0; i < capacity; i++) {
+    new (&table->buckets[i]) std::atomic<InternedSliceRefcount*>(nullptr);
+  }
+  return table;
+}
+
+static void free_retired(slice_shard* shard) {
+  for (void* p : shard->retired) gpr_free(p);
+  shard->retired.clear();
+  shard->has_retired.store(false, std::memory_order_relaxed);
+}
+
+// Retires p, and frees everything retired so far if no lookup is running.
+// The loads and stores of the table links and readers are all sequentially
+// consistent: if this sees no readers after unlinking p, any lookup starting
+// later sees the unlinked table. If it does see readers, the last of them to
+// leave sees has_retired set (see end_lookup()).
+static void retire_locked(slice_shard* shard, void* p) {
+  shard->retired.push_back(p);
+  shard->has_retired.store(true);
+  if (shard->readers.load() == 0) free_retired(shard);
+}
+
+// Counts a lock-free lookup in the shard's readers.
+static void begin_lookup(slice_shard* shard) { shard->readers.fetch_add(1); }
+
+// Ends a lookup started by begin_lookup(). The last lookup out frees what was
+// retired while lookups were running; otherwise the retired list would grow
+// without bound on a shard that always has a lookup in flight when a slice
+// is unlinked.
+static void end_lookup(slice_shard* shard) {
+  if (shard->readers.fetch_sub(1) == 1 && shard->has_retired.load()) {
+    grpc_core::MutexLock lock(&shard->mu);
+    if (shard->readers.load() == 0) free_retired(shard);
+  }
+}
+
 struct static_metadata_hash_ent {
   uint32_t hash;
   uint32_t idx;
@@ -66,43 +131,50 @@ namespace grpc_core {
 uint32_t g_hash_seed;
 static bool g_forced_hash_seed = false;
 
-InternedSliceRefcount::~InternedSliceRefcount() {
-  slice_shard* shard = &g_shards[SHARD_IDX(this->hash)];
+void InternedSliceRefcount::Destroy(void* arg) {
+  InternedSliceRefcount* s = static_cast<InternedSliceRefcount*>(arg);
+  slice_shard* shard = &g_shards[SHARD_IDX(s->hash)];
   MutexLock lock(&shard->mu);
-  InternedSliceRefcount** prev_next;
+  slice_table* table = shard->table.load(std::memory_order_relaxed);
+  std::atomic<InternedSliceRefcount*>* prev_next;
   InternedSliceRefcount* cur;
-  for (prev_next = &shard->strs[TABLE_IDX(this->hash, shard->capacity)],
-      cur = *prev_next;
-       cur != this; prev_next = &cur->bucket_next, cur = cur->bucket_next) {
+  for (prev_next = &table->buckets[TABLE_IDX(s->hash, table->capacity)],
+      cur = prev_next->load(std::memory_order_relaxed);
+       cur != s; prev_next = &cur->bucket_next,
+      cur = prev_next->load(std::memory_order_relaxed)) {
   }
-  *prev_next = cur->bucket_next;
+  prev_next->store(s->bucket_next.load(std::memory_order_relaxed));
   shard->count--;
+  // Lookups may still read s, so it is not destroyed before being freed.
+  static_assert(std::is_trivially_destructible<InternedSliceRefcount>::value,
+                "InternedSliceRefcount is freed without being destroyed");
+  retire_locked(shard, s);
 }
 
 }  // namespace grpc_core
 
+// Rehashes the shard into a table twice the size. Each slice is relinked
+// onto a chain of the new table, so a concurrent lookup walking the old table
+// may miss a slice (and retry under the lock), but always reaches the end of
+// a chain.
 static void grow_shard(slice_shard* shard) {
   GPR_TIMER_SCOPE("grow_strtab", 0);
 
-  size_t capacity = shard->capacity * 2;
-  size_t i;
-  InternedSliceRefcount** strtab;
+  slice_table* old_table = shard->table.load(std::memory_order_relaxed);
+  slice_table* table = new_table(old_table->capacity * 2);
   InternedSliceRefcount *s, *next;
 
-  strtab = static_cast<InternedSliceRefcount**>(
-      gpr_zalloc(sizeof(InternedSliceRefcount*) * capacity));
-
-  for (i = 0; i < shard->capacity; i++) {
-    for (s = shard->strs[i]; s; s = next) {
-      size_t idx = TABLE_IDX(s->hash, capacity);
-      next = s->bucket_next;
-      s->bucket_next = strtab[idx];
-      strtab[idx] = s;
+  for (size_t i = 0; i < old_table->capacity; i++) {
+    for (s = old_table->buckets[i].load(std::memory_order_relaxed); s;
+         s = next) {
+      size_t idx = TABLE_IDX(s->hash, table->capacity);
+      next = s->bucket_next.load(std::memory_order_relaxed);
+      s->bucket_next.store(table->buckets[idx].load(std::memory_order_relaxed));
+      table->buckets[idx].store(s, std::memory_order_relaxed);
     }
   }
-  gpr_free(shard->strs);
-  shard->strs = strtab;
-  shard->capacity = capacity;
+  shard->table.store(table);
+  retire_locked(shard, old_table);
 }
 
 grpc_core::InternedSlice::InternedSlice(InternedSliceRefcount* s) {
@@ -198,42 +270,44 @@ static size_t GetLength(const grpc_slice& slice) {
 // Returns: a newly interned slice.
 template <typename SliceArgs>
 static InternedSliceRefcount* InternNewStringLocked(slice_shard* shard,
-                                                    size_t shard_idx,
-                                                    uint32_t hash,
+                                                    slice_table* table,
+                                                    size_t idx, uint32_t hash,
                                                     const SliceArgs& args) {
   /* string data goes after the internal_string header */
   size_t len = GetLength(args);
   const void* buffer = GetBuffer(args);
   InternedSliceRefcount* s =
       static_cast<InternedSliceRefcount*>(gpr_malloc(sizeof(*s) + len));
-  new (s) grpc_core::InternedSliceRefcount(len, hash, shard->strs[shard_idx]);
+  new (s) grpc_core::InternedSliceRefcount(
+      len, hash, table->buckets[idx].load(std::memory_order_relaxed));
   // TODO(arjunroy): Investigate why hpack tried to intern the nullptr string.
   // https://github.com/grpc/grpc/pull/20110#issuecomment-526729282
   if (len > 0) {
     memcpy(reinterpret_cast<char*>(s + 1), buffer, len);
   }
-  shard->strs[shard_idx] = s;
+  table->buckets[idx].store(s);
   shard->count++;
-  if (shard->count > shard->capacity * 2) {
+  if (shard->count > table->capacity * 2) {
     grow_shard(shard);
   }
   return s;
 }
 
 // Attempt to see if the provided slice or string matches an existing interned
-// slice. SliceArgs... is either a const grpc_slice& or a string and length. In
-// either case, hash is the pre-computed hash value.  We must already hold the
-// shard lock. Helper for FindOrCreateInternedSlice().
+// slice. SliceArgs is either a const grpc_slice& or a const
+// pair<const char*, size_t>&. In either case, hash is the pre-computed hash
+// value. The caller must either hold the shard lock or be counted in the
+// shard's readers. Helper for FindOrCreateInternedSlice().
 //
-// Returns: a pre-existing matching static slice, or null.
+// Returns: a pre-existing matching interned slice, or null.
 template <typename SliceArgs>
-static InternedSliceRefcount* MatchInternedSliceLocked(uint32_t hash,
-                                                       size_t idx,
-                                                       const SliceArgs& args) {
-  InternedSliceRefcount* s;
-  slice_shard* shard = &g_shards[SHARD_IDX(hash)];
+static InternedSliceRefcount* MatchInternedSlice(slice_table* table,
+                                                 uint32_t hash,
+                                                 const SliceArgs& args) {
   /* search for an existing string */
-  for (s = shard->strs[idx]; s; s = s->bucket_next) {
+  for (InternedSliceRefcount* s =
+           table->buckets[TABLE_IDX(hash, table->capacity)].load();
+       s; s = s->bucket_next.load()) {
     if (s->hash == hash && grpc_core::InternedSlice(s) == args) {
       if (s->refcnt.RefIfNonZero()) {
         return s;
@@ -247,19 +321,25 @@ static InternedSliceRefcount* MatchInternedSliceLocked(uint32_t hash,
 // slice, and failing that, create an interned slice with its contents. Returns
 // either the existing matching interned slice or the newly created one.
 // SliceArgs is either a const grpc_slice& or const pair<const char*, size_t>&.
-// In either case, hash is the pre-computed hash value. We do not hold the
-// shard lock here, but do take it.
+// In either case, hash is the pre-computed hash value. The lookup is first done
+// without the shard lock; only if that fails is the lock taken.
 //
 // Returns: an interned slice, either pre-existing/matched or newly created.
 template <typename SliceArgs>
 static InternedSliceRefcount* FindOrCreateInternedSlice(uint32_t hash,
                                                         const SliceArgs& args) {
   slice_shard* shard = &g_shards[SHARD_IDX(hash)];
+  begin_lookup(shard);
+  InternedSliceRefcount* s =
+      MatchInternedSlice(shard->table.load(), hash, args);
+  end_lookup(shard);
+  if (s != nullptr) return s;
   grpc_core::MutexLock lock(&shard->mu);
-  const size_t idx = TABLE_IDX(hash, shard->capacity);
-  InternedSliceRefcount* s = MatchInternedSliceLocked(hash, idx, args);
+  slice_table* table = shard->table.load(std::memory_order_relaxed);
+  s = MatchInternedSlice(table, hash, args);
   if (s == nullptr) {
-    s = InternNewStringLocked(shard, idx, hash, args);
+    s = InternNewStringLocked(shard, table, TABLE_IDX(hash, table->capacity),
+                              hash, args);
   }
   return s;
 }
@@ -310,10 +390,11 @@ void grpc_slice_intern_init(void) {
   g_shards = new slice_shard[SHARD_COUNT];
   for (size_t i = 0; i < SHARD_COUNT; i++) {
     slice_shard* shard = &g_shards[i];
+    shard->readers.store(0, std::memory_order_relaxed);
+    shard->has_retired.store(false, std::memory_order_relaxed);
+    shard->table.store(new_table(INITIAL_SHARD_CAPACITY),
+                       std::memory_order_relaxed);
     shard->count = 0;
-    shard->capacity = INITIAL_SHARD_CAPACITY;
-    shard->strs = static_cast<InternedSliceRefcount**>(
-        gpr_zalloc(sizeof(*shard->strs) * shard->capacity));
   }
   for (size_t i = 0; i < GPR_ARRAY_SIZE(static_metadata_hash); i++) {
     static_metadata_hash[i].hash = 0;
@@ -345,12 +426,14 @@ void grpc_slice_intern_init(void) {
 void grpc_slice_intern_shutdown(void) {
   for (size_t i = 0; i < SHARD_COUNT; i++) {
     slice_shard* shard = &g_shards[i];
+    slice_table* table = shard->table.load(std::memory_order_relaxed);
     /* TODO(ctiller): GPR_ASSERT(shard->count == 0); */
     if (shard->count != 0) {
       gpr_log(GPR_DEBUG, "WARNING: %" PRIuPTR " metadata strings were leaked",
               shard->count);
-      for (size_t j = 0; j < shard->capacity; j++) {
-        for (InternedSliceRefcount* s = shard->strs[j]; s; s = s->bucket_next) {
+      for (size_t j = 0; j < table->capacity; j++) {
+        for (InternedSliceRefcount* s = table->buckets[j].load(); s;
+             s = s->bucket_next.load()) {
           char* text = grpc_dump_slice(grpc_core::InternedSlice(s),
                                        GPR_DUMP_HEX | GPR_DUMP_ASCII);
           gpr_log(GPR_DEBUG, "LEAKED: %s", text);
@@ -361,7 +444,8 @@ void grpc_slice_intern_shutdown(void) {
         abort();
       }
     }
-    gpr_free(shard->strs);
+    free_retired(shard);
+    gpr_free(table);
   }
   delete[] g_shards;
 }
@@ -17,6 +17,8 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <atomic>
+
 #include "src/core/lib/slice/slice_refcount_base.h"
 #include "src/core/lib/slice/static_slice.h"
 
@@ -29,11 +31,9 @@ namespace grpc_core {
 extern grpc_slice_refcount kNoopRefcount;
 
 struct InternedSliceRefcount {
-  static void Destroy(void* arg) {
-    auto* rc = static_cast<InternedSliceRefcount*>(arg);
-    rc->~InternedSliceRefcount();
-    gpr_free(rc);
-  }
+  // Unlinks the slice from the intern table. Its memory is freed once no
+  // lookup can still be reading it.
+  static void Destroy(void* arg);
 
   InternedSliceRefcount(size_t length, uint32_t hash,
                         InternedSliceRefcount* bucket_next)
@@ -43,14 +43,13 @@ struct InternedSliceRefcount {
         hash(hash),
         bucket_next(bucket_next) {}
 
-  ~InternedSliceRefcount();
-
   grpc_slice_refcount base;
   grpc_slice_refcount sub;
   const size_t length;
   RefCount refcnt;
   const uint32_t hash;
-  InternedSliceRefcount* bucket_next;
+  // Intern table lookups follow this without holding the shard lock.
+  std::atomic<InternedSliceRefcount*> bucket_next;
 };
 
 }  // namespace grpc_core
@@ -31,6 +31,7 @@
 
 #include <grpc/support/alloc.h>
 #include <grpc/support/atm.h>
+#include <grpc/support/cpu.h>
 #include <grpc/support/log.h>
 #include <grpc/support/string_util.h>
 #include <grpc/support/time.h>
@@ -39,6 +40,8 @@
 #include "src/core/lib/gpr/spinlock.h"
 #include "src/core/lib/gpr/string.h"
 #include "src/core/lib/gpr/tls.h"
+#include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/gprpp/global_config.h"
 #include "src/core/lib/iomgr/executor.h"
 #include "src/core/lib/iomgr/pollset.h"
 #include "src/core/lib/iomgr/timer.h"
@@ -51,8 +54,24 @@ grpc_core::TraceFlag grpc_trace_operation_failures(false, "op_failure");
 grpc_core::DebugOnlyTraceFlag grpc_trace_pending_tags(false, "pending_tags");
 grpc_core::DebugOnlyTraceFlag grpc_trace_cq_refcount(false, "cq_refcount");
 
+GPR_GLOBAL_CONFIG_DEFINE_INT32(
+    grpc_cq_next_shards, 1,
+    "Number of sub-queues holding the completed events of each GRPC_CQ_NEXT "
+    "completion queue, so that many threads calling "
+    "grpc_completion_queue_next() on one queue do not contend on a single "
+    "one. 0 means one per core.")
+
 namespace {
 
+// Upper bound on the number of sub-queues of a GRPC_CQ_NEXT completion queue.
+const int kMaxCqNextShards = 64;
+// The number of sub-queues of GRPC_CQ_NEXT completion queues created from now
+// on.
+std::atomic<int> g_cq_next_shards{1};
+// Numbers threads from 1 to pick their sub-queue; 0 if not numbered yet.
+std::atomic<size_t> g_cq_next_thread_count{0};
+static GPR_THREAD_LOCAL(size_t) g_cq_next_thread_index;
+
 // Specifies a cq thread local cache.
 // The first event that occurs on a thread
 // with a cq cache will go into that cache, and
@@ -215,11 +234,16 @@ namespace {
 /* Queue that holds the cq_completion_events. Internally uses
  * MultiProducerSingleConsumerQueue (a lockfree multiproducer single consumer
  * queue). It uses a queue_lock to support multiple consumers.
+ * The queue can be split into several shards, each with its own
+ * MultiProducerSingleConsumerQueue and lock: a thread pushes to and first pops
+ * from the shard picked by its thread index, and steals from the other shards
+ * when its own is empty or locked by another consumer. Events pushed by one
+ * thread stay in order.
  * Only used in completion queues whose completion_type is GRPC_CQ_NEXT */
 class CqEventQueue {
  public:
-  CqEventQueue() = default;
-  ~CqEventQueue() = default;
+  explicit CqEventQueue(int num_shards);
+  ~CqEventQueue();
 
   /* Note: The counter is not incremented/decremented atomically with push/pop.
    * The count is only eventually consistent */
@@ -231,10 +255,27 @@ class CqEventQueue {
   grpc_cq_completion* Pop();
 
  private:
-  /* Spinlock to serialize consumers i.e pop() operations */
-  gpr_spinlock queue_lock_ = GPR_SPINLOCK_INITIALIZER;
+  struct Shard {
+    /* Spinlock to serialize consumers i.e pop() operations */
+    gpr_spinlock queue_lock = GPR_SPINLOCK_INITIALIZER;
+
+    /* Lazy count of the items in this shard, incremented before the push so
+       that Pop() does not skip a shard that has items */
+    std::atomic<intptr_t> num_items{0};
+
+    grpc_core::MultiProducerSingleConsumerQueue queue;
+
+    char padding[GPR_CACHELINE_SIZE];
+  };
+
+  /* The shard the calling thread pushes to and first pops from */
+  size_t HomeShard() const;
+  grpc_cq_completion* PopFromShard(Shard* shard);
 
-  grpc_core::MultiProducerSingleConsumerQueue queue_;
+  Shard first_shard_;
+  /* &first_shard_ if there is a single shard, allocated otherwise */
+  Shard* shards_;
+  size_t num_shards_;
 
   /* A lazy counter of number of items in the queue. This is NOT atomically
      incremented/decremented along with push/pop operations and hence is only
@@ -243,6 +284,7 @@ class CqEventQueue {
 };
 
 struct cq_next_data {
+  cq_next_data() : queue(g_cq_next_shards.load(std::memory_order_relaxed)) {}
   ~cq_next_data() {
     GPR_ASSERT(queue.num_items() == 0);
 #ifndef NDEBUG
@@ -439,7 +481,15 @@ grpc_core::TraceFlag grpc_cq_pluck_trace(false, "queue_pluck");
 
 static void on_pollset_shutdown_done(void* arg, grpc_error_handle error);
 
-void grpc_cq_global_init() {}
+void grpc_cq_global_init() {
+  grpc_cq_set_next_shards(GPR_GLOBAL_CONFIG_GET(grpc_cq_next_shards));
+}
+
+void grpc_cq_set_next_shards(int num_shards) {
+  if (num_shards <= 0) num_shards = gpr_cpu_num_cores();
+  num_shards = grpc_core::Clamp(num_shards, 1, kMaxCqNextShards);
+  g_cq_next_shards.store(num_shards, std::memory_order_relaxed);
+}
 
 void grpc_completion_queue_thread_local_cache_init(grpc_completion_queue* cq) {
   if (g_cached_cq == nullptr) {
@@ -473,21 +523,42 @@ int grpc_completion_queue_thread_local_cache_flush(grpc_completion_queue* cq,
   return ret;
 }
 
+CqEventQueue::CqEventQueue(int num_shards)
+    : shards_(num_shards == 1 ? &first_shard_ : new Shard[num_shards]),
+      num_shards_(num_shards) {}
+
+CqEventQueue::~CqEventQueue() {
+  if (shards_ != &first_shard_) delete[] shards_;
+}
+
+size_t CqEventQueue::HomeShard() const {
+  if (num_shards_ == 1) return 0;
+  size_t index = g_cq_next_thread_index;
+  if (index == 0) {
+    index = g_cq_next_thread_count.fetch_add(1, std::memory_order_relaxed) + 1;
+    g_cq_next_thread_index = index;
+  }
+  return index % num_shards_;
+}
+
 bool CqEventQueue::Push(grpc_cq_completion* c) {
-  queue_.Push(
+  Shard* shard = &shards_[HomeShard()];
+  shard->num_items.fetch_add(1, std::memory_order_relaxed);
+  shard->queue.Push(
       reinterpret_cast<grpc_core::MultiProducerSingleConsumerQueue::Node*>(c));
   return num_queue_items_.fetch_add(1, std::memory_order_relaxed) == 0;
 }
 
-grpc_cq_completion* CqEventQueue::Pop() {
+grpc_cq_completion* CqEventQueue::PopFromShard(Shard* shard) {
   grpc_cq_completion* c = nullptr;
 
-  if (gpr_spinlock_trylock(&queue_lock_)) {
+  if (gpr_spinlock_trylock(&shard->queue_lock)) {
     GRPC_STATS_INC_CQ_EV_QUEUE_TRYLOCK_SUCCESSES();
 
     bool is_empty = false;
-    c = reinterpret_cast<grpc_cq_completion*>(queue_.PopAndCheckEnd(&is_empty));
-    gpr_spinlock_unlock(&queue_lock_);
+    c = reinterpret_cast<grpc_cq_completion*>(
+        shard->queue.PopAndCheckEnd(&is_empty));
+    gpr_spinlock_unlock(&shard->queue_lock);
 
     if (c == nullptr && !is_empty) {
       GRPC_STATS_INC_CQ_EV_QUEUE_TRANSIENT_POP_FAILURES();
@@ -497,12 +568,27 @@ grpc_cq_completion* CqEventQueue::Pop() {
   }
 
   if (c) {
-    num_queue_items_.fetch_sub(1, std::memory_order_relaxed);
+    shard->num_items.fetch_sub(1, std::memory_order_relaxed);
   }
 
   return c;
 }
 
+grpc_cq_completion* CqEventQueue::Pop() {
+  size_t i = HomeShard();
+  for (size_t n = 0; n < num_shards_; n++) {
+    Shard* shard = &shards_[i];
+    if (++i == num_shards_) i = 0;
+    if (shard->num_items.load(std::memory_order_relaxed) == 0) continue;
+    grpc_cq_completion* c = PopFromShard(shard);
+    if (c) {
+      num_queue_items_.fetch_sub(1, std::memory_order_relaxed);
+      return c;
+    }
+  }
+  return nullptr;
+}
+
 grpc_completion_queue* grpc_completion_queue_create_internal(
     grpc_cq_completion_type completion_type, grpc_cq_polling_type polling_type,
     grpc_completion_queue_functor* shutdown_callback) {
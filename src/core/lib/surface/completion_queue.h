@@ -69,6 +69,11 @@ void grpc_cq_internal_unref(grpc_completion_queue* cq);
 /* Initializes global variables used by completion queues */
 void grpc_cq_global_init();
 
+/* Sets the number of sub-queues of GRPC_CQ_NEXT completion queues created from
+   now on (0 means one per core). grpc_cq_global_init() sets it from
+   GRPC_CQ_NEXT_SHARDS. */
+void grpc_cq_set_next_shards(int num_shards);
+
 /* Flag that an operation is beginning: the completion channel will not finish
    shutdown until a corrensponding grpc_cq_end_* call is made.
    \a tag is currently used only in debug builds. Return true on success, and
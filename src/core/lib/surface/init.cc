@@ -34,6 +34,7 @@
 #include "src/core/lib/channel/connected_channel.h"
 #include "src/core/lib/debug/stats.h"
 #include "src/core/lib/debug/trace.h"
+#include "src/core/lib/gprpp/arena.h"
 #include "src/core/lib/gprpp/fork.h"
 #include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/http/parser.h"
@@ -146,6 +147,7 @@ void grpc_shutdown_internal_locked(void)
     grpc_slice_intern_shutdown();
     grpc_core::channelz::ChannelzRegistry::Shutdown();
     grpc_stats_shutdown();
+    grpc_core::Arena::TrimCache();
     grpc_core::Fork::GlobalShutdown();
   }
   grpc_core::ExecCtx::GlobalShutdown();
@@ -191,10 +191,16 @@ class Server::RequestMatcherInterface {
 // application to explicitly request RPCs and then matching those to incoming
 // RPCs, along with a slow path by which incoming RPCs are put on a locked
 // pending list if they aren't able to be matched to an application request.
+// There is a pending list per request queue, each with its own lock: an RPC
+// waits on the list of the request queue it started matching at, and a new
+// request drains its own queue's list before stealing from the others, so that
+// RPCs and requests of different CQs do not contend on a server-wide lock.
 class Server::RealRequestMatcher : public RequestMatcherInterface {
  public:
   explicit RealRequestMatcher(Server* server)
-      : server_(server), requests_per_cq_(server->cqs_.size()) {}
+      : server_(server),
+        requests_per_cq_(server->cqs_.size()),
+        pending_per_cq_(server->cqs_.size()) {}
 
   ~RealRequestMatcher() override {
     for (LockedMultiProducerSingleConsumerQueue& queue : requests_per_cq_) {
@@ -203,11 +209,14 @@ class Server::RealRequestMatcher : public RequestMatcherInterface {
   }
 
   void ZombifyPending() override {
-    while (!pending_.empty()) {
-      CallData* calld = pending_.front();
-      calld->SetState(CallData::CallState::ZOMBIED);
-      calld->KillZombie();
-      pending_.pop();
+    for (PendingList& list : pending_per_cq_) {
+      MutexLock lock(&list.mu);
+      while (!list.calls.empty()) {
+        CallData* calld = list.calls.front();
+        calld->SetState(CallData::CallState::ZOMBIED);
+        calld->KillZombie();
+        list.calls.pop();
+      }
     }
   }
 
@@ -230,34 +239,43 @@ class Server::RealRequestMatcher : public RequestMatcherInterface {
                                       RequestedCall* call) override {
     if (requests_per_cq_[request_queue_index].Push(&call->mpscq_node)) {
       /* this was the first queued request: we need to lock and start
-         matching calls */
+         matching calls, from this queue's pending list first */
       struct PendingCall {
         RequestedCall* rc = nullptr;
         CallData* calld;
       };
-      auto pop_next_pending = [this, request_queue_index] {
+      auto pop_next_pending = [this, request_queue_index](PendingList* list,
+                                                          bool* no_requests) {
         PendingCall pending_call;
         {
-          MutexLock lock(&server_->mu_call_);
-          if (!pending_.empty()) {
+          MutexLock lock(&list->mu);
+          if (!list->calls.empty()) {
             pending_call.rc = reinterpret_cast<RequestedCall*>(
                 requests_per_cq_[request_queue_index].Pop());
             if (pending_call.rc != nullptr) {
-              pending_call.calld = pending_.front();
-              pending_.pop();
+              pending_call.calld = list->calls.front();
+              list->calls.pop();
+            } else {
+              *no_requests = true;
             }
           }
         }
         return pending_call;
       };
-      while (true) {
-        PendingCall next_pending = pop_next_pending();
-        if (next_pending.rc == nullptr) break;
-        if (!next_pending.calld->MaybeActivate()) {
-          // Zombied Call
-          next_pending.calld->KillZombie();
-        } else {
-          next_pending.calld->Publish(request_queue_index, next_pending.rc);
+      bool no_requests = false;
+      const size_t num_cqs = pending_per_cq_.size();
+      for (size_t i = 0; i < num_cqs && !no_requests; i++) {
+        PendingList* list =
+            &pending_per_cq_[(request_queue_index + i) % num_cqs];
+        while (true) {
+          PendingCall next_pending = pop_next_pending(list, &no_requests);
+          if (next_pending.rc == nullptr) break;
+          if (!next_pending.calld->MaybeActivate()) {
+            // Zombied Call
+            next_pending.calld->KillZombie();
+          } else {
+            next_pending.calld->Publish(request_queue_index, next_pending.rc);
+          }
         }
       }
     }
@@ -279,14 +297,16 @@ class Server::RealRequestMatcher : public RequestMatcherInterface {
     // No cq to take the request found; queue it on the slow list.
     GRPC_STATS_INC_SERVER_SLOWPATH_REQUESTS_QUEUED();
     // We need to ensure that all the queues are empty.  We do this under
-    // the server mu_call_ lock to ensure that if something is added to
+    // the pending list's lock to ensure that if something is added to
     // an empty request queue, it will block until the call is actually
-    // added to the pending list.
+    // added to the pending list (a request that finds its queue empty locks
+    // every pending list in turn).
     RequestedCall* rc = nullptr;
     size_t cq_idx = 0;
     size_t loop_count;
     {
-      MutexLock lock(&server_->mu_call_);
+      PendingList* list = &pending_per_cq_[start_request_queue_index];
+      MutexLock lock(&list->mu);
       for (loop_count = 0; loop_count < requests_per_cq_.size(); loop_count++) {
         cq_idx =
             (start_request_queue_index + loop_count) % requests_per_cq_.size();
@@ -297,7 +317,7 @@ class Server::RealRequestMatcher : public RequestMatcherInterface {
       }
       if (rc == nullptr) {
         calld->SetState(CallData::CallState::PENDING);
-        pending_.push(calld);
+        list->calls.push(calld);
         return;
       }
     }
@@ -309,9 +329,14 @@ class Server::RealRequestMatcher : public RequestMatcherInterface {
   Server* server() const override { return server_; }
 
  private:
+  struct PendingList {
+    Mutex mu;
+    std::queue<CallData*> calls ABSL_GUARDED_BY(mu);
+  };
+
   Server* const server_;
-  std::queue<CallData*> pending_;
   std::vector<LockedMultiProducerSingleConsumerQueue> requests_per_cq_;
+  std::vector<PendingList> pending_per_cq_;
 };
 
 // AllocatingRequestMatchers don't allow the application to request an RPC in
@@ -32,6 +32,38 @@
 #include "src/core/lib/slice/slice_internal.h"
 #include "src/core/lib/slice/slice_string_helpers.h"
 
+namespace grpc_core {
+
+TeMetadata::ValueType TeMetadata::Parse(const grpc_slice& value) {
+  return grpc_slice_eq_static_interned(value, GRPC_MDSTR_TRAILERS) ? kTrailers
+                                                                   : kInvalid;
+}
+
+ContentTypeMetadata::ValueType ContentTypeMetadata::Parse(
+    const grpc_slice& value) {
+  static const char kExpected[] = "application/grpc";
+  static const size_t kExpectedLength = sizeof(kExpected) - 1;
+  if (grpc_slice_eq_static_interned(
+          value, GRPC_MDSTR_APPLICATION_SLASH_GRPC)) {
+    return kApplicationGrpc;
+  }
+  if (GRPC_SLICE_LENGTH(value) == 0) return kEmpty;
+  if (GRPC_SLICE_LENGTH(value) > kExpectedLength &&
+      grpc_slice_buf_start_eq(value, kExpected, kExpectedLength) &&
+      (GRPC_SLICE_START_PTR(value)[kExpectedLength] == '+' ||
+       GRPC_SLICE_START_PTR(value)[kExpectedLength] == ';')) {
+    // Although the C implementation doesn't (currently) generate them, any
+    // custom +-suffix is explicitly valid.
+    return kApplicationGrpc;
+  }
+  char* val = grpc_dump_slice(value, GPR_DUMP_ASCII);
+  gpr_log(GPR_INFO, "Unexpected content-type '%s'", val);
+  gpr_free(val);
+  return kInvalid;
+}
+
+}  // namespace grpc_core
+
 void grpc_metadata_batch_set_value(grpc_linked_mdelem* storage,
                                    const grpc_slice& value) {
   grpc_mdelem old_mdelem = storage->md;
@@ -45,9 +77,7 @@ void grpc_metadata_batch_copy(grpc_metadata_batch* src,
                               grpc_metadata_batch* dst,
                               grpc_linked_mdelem* storage) {
   dst->Clear();
-  if (auto* p = src->get_pointer(grpc_core::GrpcTimeoutMetadata())) {
-    dst->Set(grpc_core::GrpcTimeoutMetadata(), *p);
-  }
+  dst->CopyKnownMetadataFrom(*src);
   size_t i = 0;
   src->ForEach([&](grpc_mdelem md) {
     // If the mdelem is not external, take a ref.
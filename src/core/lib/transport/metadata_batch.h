@@ -79,6 +79,25 @@ struct GrpcTimeoutMetadata {
   static const char* key() { return "grpc-timeout"; }
 };
 
+// te metadata trait.
+// gRPC only ever sends "trailers"; kInvalid records that some other value was
+// received.
+struct TeMetadata {
+  enum ValueType { kTrailers, kInvalid };
+  static const char* key() { return "te"; }
+  static ValueType Parse(const grpc_slice& value);
+};
+
+// content-type metadata trait.
+// gRPC requires application/grpc, optionally followed by '+' or ';' and a
+// suffix. Core has only ever verified that prefix, so that is all ValueType
+// remembers.
+struct ContentTypeMetadata {
+  enum ValueType { kApplicationGrpc, kEmpty, kInvalid };
+  static const char* key() { return "content-type"; }
+  static ValueType Parse(const grpc_slice& value);
+};
+
 // MetadataMap encodes the mapping of metadata keys to metadata values.
 // Right now the API presented is the minimal one that will allow us to
 // substitute this type for grpc_metadata_batch in a relatively easy fashion. At
@@ -249,6 +268,9 @@ class MetadataMap {
 
   void CopyFrom(MetadataMap* src, grpc_linked_mdelem* storage);
 
+  // Replaces the known metadata of this map with that of \a src.
+  void CopyKnownMetadataFrom(const MetadataMap& src) { table_ = src.table_; }
+
 #ifndef NDEBUG
   void AssertOk();
 #else
@@ -667,7 +689,9 @@ bool MetadataMap<Traits...>::ReplaceIfExists(grpc_slice key, grpc_slice value) {
 }  // namespace grpc_core
 
 using grpc_metadata_batch =
-    grpc_core::MetadataMap<grpc_core::GrpcTimeoutMetadata>;
+    grpc_core::MetadataMap<grpc_core::GrpcTimeoutMetadata,
+                           grpc_core::TeMetadata,
+                           grpc_core::ContentTypeMetadata>;
 
 inline void grpc_metadata_batch_clear(grpc_metadata_batch* batch) {
   batch->Clear();
@@ -232,6 +232,10 @@ struct grpc_transport_stream_op_batch_payload {
     /** Iff send_initial_metadata != NULL, flags associated with
         send_initial_metadata: a bitfield of GRPC_INITIAL_METADATA_xxx */
     uint32_t send_initial_metadata_flags = 0;
+    // The stream's share of the transport's outgoing bandwidth relative to
+    // other streams that have data to send, from 1 to 256. 0 means the
+    // transport's default.
+    uint32_t stream_weight = 0;
     // If non-NULL, will be set by the transport to the peer string (a char*).
     // The transport retains ownership of the string.
     // Note: This pointer may be used by the transport after the
@@ -63,6 +63,22 @@ static void put_metadata_list(const grpc_metadata_batch& md,
       out_->push_back(absl::StrFormat("deadline=%" PRId64, deadline));
     }
 
+    void Encode(grpc_core::TeMetadata, grpc_core::TeMetadata::ValueType te) {
+      MaybeAddComma();
+      out_->push_back(absl::StrCat(
+          "te=", te == grpc_core::TeMetadata::kTrailers ? "trailers" : "?"));
+    }
+
+    void Encode(grpc_core::ContentTypeMetadata,
+                grpc_core::ContentTypeMetadata::ValueType content_type) {
+      MaybeAddComma();
+      out_->push_back(absl::StrCat(
+          "content-type=",
+          content_type == grpc_core::ContentTypeMetadata::kApplicationGrpc
+              ? "application/grpc"
+              : "?"));
+    }
+
    private:
     void MaybeAddComma() {
       if (out_->size() != initial_size_) out_->push_back(", ");
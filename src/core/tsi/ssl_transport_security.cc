@@ -33,6 +33,7 @@
 #include <sys/socket.h>
 #endif
 
+#include <algorithm>
 #include <string>
 
 #include "absl/strings/match.h"
@@ -50,6 +51,8 @@ extern "C" {
 #include <openssl/crypto.h> /* For OPENSSL_free */
 #include <openssl/engine.h>
 #include <openssl/err.h>
+#include <openssl/evp.h>
+#include <openssl/hmac.h>
 #include <openssl/ssl.h>
 #include <openssl/tls1.h>
 #include <openssl/x509.h>
@@ -57,15 +60,21 @@ extern "C" {
 }
 
 #include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/slice/slice_internal.h"
 #include "src/core/tsi/ssl/session_cache/ssl_session_cache.h"
 #include "src/core/tsi/ssl_types.h"
 #include "src/core/tsi/transport_security.h"
+#include "src/core/tsi/transport_security_grpc.h"
 
 /* --- Constants. ---*/
 
 #define TSI_SSL_MAX_PROTECTED_FRAME_SIZE_UPPER_BOUND 16384
 #define TSI_SSL_MAX_PROTECTED_FRAME_SIZE_LOWER_BOUND 1024
 #define TSI_SSL_HANDSHAKER_OUTGOING_BUFFER_INITIAL_SIZE 1024
+/* Output slices of the zero-copy protector stay below the malloc mmap
+   threshold; larger ones cost more in page faults than they save in slices. */
+#define TSI_SSL_ZERO_COPY_MAX_OUTPUT_SLICE_SIZE \
+  (4 * TSI_SSL_MAX_PROTECTED_FRAME_SIZE_UPPER_BOUND)
 
 /* Putting a macro like this and littering the source file with #if is really
    bad practice.
@@ -74,6 +83,15 @@ extern "C" {
 #define TSI_OPENSSL_ALPN_SUPPORT 1
 #endif
 
+/* Exporting the write traffic keys needs the master secret and client and
+   server randoms (OpenSSL 1.1.0). OpenSSL has no accessor for the write
+   sequence number, so it is counted from the message callback instead. */
+#if defined(OPENSSL_IS_BORINGSSL) ||      \
+    (OPENSSL_VERSION_NUMBER >= 0x10100000 && \
+     !defined(LIBRESSL_VERSION_NUMBER))
+#define TSI_OPENSSL_WRITE_TRAFFIC_KEYS_SUPPORT 1
+#endif
+
 /* TODO(jboeuf): I have not found a way to get this number dynamically from the
    SSL structure. This is what we would ultimately want though... */
 #define TSI_SSL_MAX_PROTECTION_OVERHEAD 100
@@ -133,10 +151,28 @@ struct tsi_ssl_frame_protector {
   size_t buffer_size;
   size_t buffer_offset;
 };
+struct tsi_ssl_zero_copy_grpc_protector {
+  tsi_zero_copy_grpc_protector base;
+  SSL* ssl;
+  BIO* network_io;
+  /* The secure endpoint protects and unprotects concurrently, and both go
+     through the same SSL object. */
+  gpr_mu mu;
+  size_t max_protected_frame_size;
+  size_t max_unprotected_data_size;
+  /* Gathers the payload of a record that spans several slices. */
+  unsigned char* record_buffer;
+};
 /* --- Library Initialization. ---*/
 
 static gpr_once g_init_openssl_once = GPR_ONCE_INIT;
 static int g_ssl_ctx_ex_factory_index = -1;
+#ifdef TSI_OPENSSL_WRITE_TRAFFIC_KEYS_SUPPORT
+static int g_ssl_ex_write_traffic_state_index = -1;
+static void ssl_write_traffic_state_free(void* parent, void* ptr,
+                                         CRYPTO_EX_DATA* ad, int index,
+                                         long argl, void* argp);
+#endif
 static const unsigned char kSslSessionIdContext[] = {'g', 'r', 'p', 'c'};
 #if !defined(OPENSSL_IS_BORINGSSL) && !defined(OPENSSL_NO_ENGINE)
 static const char kSslEnginePrefix[] = "engine:";
@@ -187,6 +223,11 @@ static void init_openssl(void) {
   g_ssl_ctx_ex_factory_index =
       SSL_CTX_get_ex_new_index(0, nullptr, nullptr, nullptr, nullptr);
   GPR_ASSERT(g_ssl_ctx_ex_factory_index != -1);
+#ifdef TSI_OPENSSL_WRITE_TRAFFIC_KEYS_SUPPORT
+  g_ssl_ex_write_traffic_state_index = SSL_get_ex_new_index(
+      0, nullptr, nullptr, nullptr, ssl_write_traffic_state_free);
+  GPR_ASSERT(g_ssl_ex_write_traffic_state_index != -1);
+#endif
 }
 
 /* --- Ssl utils. ---*/
@@ -237,6 +278,180 @@ static void ssl_info_callback(const SSL* ssl, int where, int ret) {
   ssl_log_where_info(ssl, where, SSL_CB_HANDSHAKE_DONE, "HANDSHAKE DONE");
 }
 
+/* --- Write traffic key tracking. ---*/
+
+#ifdef TSI_OPENSSL_WRITE_TRAFFIC_KEYS_SUPPORT
+
+/* What tsi_ssl_handshaker_result_get_write_traffic_keys needs beyond what the
+   SSL object exposes, collected while the handshake runs: how many records
+   have been written under the current write keys. Its presence also marks the
+   handshakers that were asked to export their keys. */
+struct tsi_ssl_write_traffic_state {
+  bool counting_records;
+  uint64_t records_written;
+};
+
+static void ssl_write_traffic_state_free(void* /*parent*/, void* ptr,
+                                         CRYPTO_EX_DATA* /*ad*/, int /*index*/,
+                                         long /*argl*/, void* /*argp*/) {
+  if (ptr == nullptr) return;
+  OPENSSL_cleanse(ptr, sizeof(tsi_ssl_write_traffic_state));
+  gpr_free(ptr);
+}
+
+static tsi_ssl_write_traffic_state* ssl_get_write_traffic_state(
+    const SSL* ssl) {
+  return static_cast<tsi_ssl_write_traffic_state*>(
+      SSL_get_ex_data(ssl, g_ssl_ex_write_traffic_state_index));
+}
+
+/* Stops tracking the write traffic keys of ssl and wipes what was collected. */
+static void ssl_untrack_write_traffic(SSL* ssl) {
+  tsi_ssl_write_traffic_state* state = ssl_get_write_traffic_state(ssl);
+  SSL_set_ex_data(ssl, g_ssl_ex_write_traffic_state_index, nullptr);
+  ssl_write_traffic_state_free(nullptr, state, nullptr, 0, 0, nullptr);
+#ifndef OPENSSL_IS_BORINGSSL
+  SSL_set_msg_callback(ssl, nullptr);
+#endif
+}
+
+#ifndef OPENSSL_IS_BORINGSSL
+/* Counts the records written under the current write keys. The message
+   callback reports each record header as it is written, and each handshake
+   or ChangeCipherSpec message after the record carrying it. TLS 1.2 switches
+   keys with ChangeCipherSpec. */
+static void ssl_msg_callback(int write_p, int /*version*/, int content_type,
+                             const void* /*buf*/, size_t /*len*/, SSL* ssl,
+                             void* /*arg*/) {
+  if (!write_p) return;
+  tsi_ssl_write_traffic_state* state = ssl_get_write_traffic_state(ssl);
+  if (state == nullptr) return;
+  switch (content_type) {
+    case SSL3_RT_HEADER:
+      if (state->counting_records) state->records_written++;
+      break;
+    case SSL3_RT_CHANGE_CIPHER_SPEC:
+      state->counting_records = true;
+      state->records_written = 0;
+      break;
+    default:
+      break;
+  }
+}
+#endif
+
+/* Starts tracking the write traffic keys of ssl. */
+static void ssl_track_write_traffic(SSL* ssl) {
+  SSL_set_ex_data(ssl, g_ssl_ex_write_traffic_state_index,
+                  gpr_zalloc(sizeof(tsi_ssl_write_traffic_state)));
+#ifndef OPENSSL_IS_BORINGSSL
+  SSL_set_msg_callback(ssl, ssl_msg_callback);
+#endif
+}
+
+/* The TLS 1.2 PRF from RFC 5246 section 5. */
+static bool tls12_prf(const EVP_MD* md, const unsigned char* secret,
+                      size_t secret_size, const char* label,
+                      const unsigned char* seed, size_t seed_size,
+                      unsigned char* out, size_t out_size) {
+  unsigned char label_seed[64 + 2 * SSL3_RANDOM_SIZE];
+  size_t label_size = strlen(label);
+  if (label_size + seed_size > sizeof(label_seed)) return false;
+  memcpy(label_seed, label, label_size);
+  memcpy(label_seed + label_size, seed, seed_size);
+  size_t label_seed_size = label_size + seed_size;
+  size_t md_size = static_cast<size_t>(EVP_MD_size(md));
+  /* a holds A(i) followed by label + seed. */
+  unsigned char a[EVP_MAX_MD_SIZE + sizeof(label_seed)];
+  unsigned char block[EVP_MAX_MD_SIZE];
+  bool ok = HMAC(md, secret, static_cast<int>(secret_size), label_seed,
+                 label_seed_size, a, nullptr) != nullptr;
+  memcpy(a + md_size, label_seed, label_seed_size);
+  while (ok && out_size > 0) {
+    ok = HMAC(md, secret, static_cast<int>(secret_size), a,
+              md_size + label_seed_size, block, nullptr) != nullptr &&
+         HMAC(md, secret, static_cast<int>(secret_size), a, md_size, a,
+              nullptr) != nullptr;
+    size_t n = out_size < md_size ? out_size : md_size;
+    memcpy(out, block, n);
+    out += n;
+    out_size -= n;
+  }
+  OPENSSL_cleanse(a, sizeof(a));
+  OPENSSL_cleanse(block, sizeof(block));
+  return ok;
+}
+
+static void store_big_endian_uint64(uint64_t value, unsigned char* out) {
+  for (int i = 7; i >= 0; --i) {
+    out[i] = static_cast<unsigned char>(value);
+    value >>= 8;
+  }
+}
+
+static tsi_result ssl_get_write_traffic_keys(SSL* ssl,
+                                             tsi_ssl_write_traffic_keys* keys) {
+  tsi_ssl_write_traffic_state* state = ssl_get_write_traffic_state(ssl);
+  if (state == nullptr) return TSI_UNIMPLEMENTED;
+  /* Only TLS 1.2 sessions are exported: in TLS 1.3 either side may update the
+     traffic keys at any time with a KeyUpdate message, which the frame
+     protector would handle but the owner of the exported keys would not. */
+  if (SSL_version(ssl) != TLS1_2_VERSION) return TSI_UNIMPLEMENTED;
+  const SSL_CIPHER* cipher = SSL_get_current_cipher(ssl);
+  if (cipher == nullptr) return TSI_UNIMPLEMENTED;
+  /* All AES-GCM cipher suites of TLS 1.2 pair AES-128 with SHA-256 and
+     AES-256 with SHA-384. */
+  const EVP_MD* md;
+  switch (SSL_CIPHER_get_cipher_nid(cipher)) {
+    case NID_aes_128_gcm:
+      keys->key_size = 16;
+      md = EVP_sha256();
+      break;
+    case NID_aes_256_gcm:
+      keys->key_size = 32;
+      md = EVP_sha384();
+      break;
+    default:
+      return TSI_UNIMPLEMENTED;
+  }
+#ifdef OPENSSL_IS_BORINGSSL
+  uint64_t sequence = SSL_get_write_sequence(ssl);
+#else
+  if (!state->counting_records) return TSI_UNIMPLEMENTED;
+  uint64_t sequence = state->records_written;
+#endif
+  keys->tls_version = TLS1_2_VERSION;
+  /* The key block holds the client and server write keys, then the client
+     and server implicit nonces (RFC 5288 section 3). */
+  unsigned char master_key[SSL_MAX_MASTER_KEY_LENGTH];
+  unsigned char randoms[2 * SSL3_RANDOM_SIZE];
+  unsigned char key_block[2 * 32 + 2 * 4];
+  size_t master_key_size = SSL_SESSION_get_master_key(
+      SSL_get_session(ssl), master_key, sizeof(master_key));
+  SSL_get_server_random(ssl, randoms, SSL3_RANDOM_SIZE);
+  SSL_get_client_random(ssl, randoms + SSL3_RANDOM_SIZE, SSL3_RANDOM_SIZE);
+  size_t key_block_size = 2 * keys->key_size + 2 * sizeof(keys->salt);
+  bool ok = tls12_prf(md, master_key, master_key_size, "key expansion",
+                      randoms, sizeof(randoms), key_block, key_block_size);
+  if (ok) {
+    size_t is_server = SSL_is_server(ssl) ? 1 : 0;
+    memcpy(keys->key, key_block + is_server * keys->key_size, keys->key_size);
+    memcpy(keys->salt,
+           key_block + 2 * keys->key_size + is_server * sizeof(keys->salt),
+           sizeof(keys->salt));
+    /* The explicit part of the nonce travels with each record; it only has to
+       be unique, and the sequence number is. */
+    store_big_endian_uint64(sequence, keys->iv);
+  }
+  OPENSSL_cleanse(master_key, sizeof(master_key));
+  OPENSSL_cleanse(key_block, sizeof(key_block));
+  if (!ok) return TSI_INTERNAL_ERROR;
+  store_big_endian_uint64(sequence, keys->record_sequence);
+  return TSI_OK;
+}
+
+#endif /* TSI_OPENSSL_WRITE_TRAFFIC_KEYS_SUPPORT */
+
 /* Returns 1 if name looks like an IP address, 0 otherwise.
    This is a very rough heuristic, and only handles IPv6 in hexadecimal form. */
 static int looks_like_ip_address(absl::string_view name) {
@@ -1168,6 +1383,189 @@ static const tsi_frame_protector_vtable frame_protector_vtable = {
     ssl_protector_destroy,
 };
 
+/* --- tsi_zero_copy_grpc_protector methods implementation. ---*/
+
+/* Makes room for at least size more bytes after the first *used bytes of
+   *output. When *output is full, it is handed to dst and replaced by a new
+   slice sized for capacity bytes, within the output slice size cap. */
+static unsigned char* ssl_reserve_output(grpc_slice* output, size_t* used,
+                                         size_t size, size_t capacity,
+                                         grpc_slice_buffer* dst) {
+  if (GRPC_SLICE_LENGTH(*output) - *used < size) {
+    if (*used > 0) {
+      grpc_slice_buffer_add(dst, grpc_slice_sub_no_ref(*output, 0, *used));
+    } else {
+      grpc_slice_unref_internal(*output);
+    }
+    *output = GRPC_SLICE_MALLOC(std::max(
+        size, std::min<size_t>(capacity,
+                               TSI_SSL_ZERO_COPY_MAX_OUTPUT_SLICE_SIZE)));
+    *used = 0;
+  }
+  return GRPC_SLICE_START_PTR(*output) + *used;
+}
+
+/* Hands the bytes written to output to dst. */
+static void ssl_flush_output(grpc_slice output, size_t used,
+                             grpc_slice_buffer* dst) {
+  if (used > 0) {
+    grpc_slice_buffer_add(dst, grpc_slice_sub_no_ref(output, 0, used));
+  } else {
+    grpc_slice_unref_internal(output);
+  }
+}
+
+static tsi_result ssl_zero_copy_grpc_protector_protect(
+    tsi_zero_copy_grpc_protector* self, grpc_slice_buffer* unprotected_slices,
+    grpc_slice_buffer* protected_slices) {
+  if (self == nullptr || unprotected_slices == nullptr ||
+      protected_slices == nullptr) {
+    gpr_log(GPR_ERROR, "Invalid nullptr arguments to zero-copy grpc protect.");
+    return TSI_INVALID_ARGUMENT;
+  }
+  tsi_ssl_zero_copy_grpc_protector* impl =
+      reinterpret_cast<tsi_ssl_zero_copy_grpc_protector*>(self);
+  grpc_slice output = grpc_empty_slice();
+  size_t used = 0;
+  tsi_result result = TSI_OK;
+  gpr_mu_lock(&impl->mu);
+  while (unprotected_slices->length > 0) {
+    size_t record_size = std::min(unprotected_slices->length,
+                                  impl->max_unprotected_data_size);
+    grpc_slice first = unprotected_slices->slices[0];
+    size_t first_size = GRPC_SLICE_LENGTH(first);
+    if (first_size >= record_size) {
+      /* Seal straight from the caller's slice. */
+      result =
+          do_ssl_write(impl->ssl, GRPC_SLICE_START_PTR(first), record_size);
+      if (first_size == record_size) {
+        grpc_slice_buffer_remove_first(unprotected_slices);
+      } else {
+        grpc_slice_buffer_sub_first(unprotected_slices, record_size,
+                                    first_size);
+      }
+    } else {
+      grpc_slice_buffer_move_first_into_buffer(unprotected_slices, record_size,
+                                               impl->record_buffer);
+      result = do_ssl_write(impl->ssl, impl->record_buffer, record_size);
+    }
+    if (result != TSI_OK) break;
+    /* The network BIO can hold one record at most, so drain it each time. */
+    int pending = static_cast<int>(BIO_pending(impl->network_io));
+    GPR_ASSERT(pending >= 0);
+    /* The first record allocates one slice for all of them, sized for the
+       worst case. */
+    size_t num_records =
+        (unprotected_slices->length + impl->max_unprotected_data_size - 1) /
+        impl->max_unprotected_data_size;
+    unsigned char* dst = ssl_reserve_output(
+        &output, &used, static_cast<size_t>(pending),
+        static_cast<size_t>(pending) + unprotected_slices->length +
+            num_records * TSI_SSL_MAX_PROTECTION_OVERHEAD,
+        protected_slices);
+    int read_from_ssl = BIO_read(impl->network_io, dst, pending);
+    if (read_from_ssl != pending) {
+      gpr_log(GPR_ERROR, "Could not read from BIO after SSL_write.");
+      result = TSI_INTERNAL_ERROR;
+      break;
+    }
+    used += static_cast<size_t>(read_from_ssl);
+  }
+  gpr_mu_unlock(&impl->mu);
+  ssl_flush_output(output, used, protected_slices);
+  if (result != TSI_OK) {
+    grpc_slice_buffer_reset_and_unref_internal(unprotected_slices);
+  }
+  return result;
+}
+
+static tsi_result ssl_zero_copy_grpc_protector_unprotect(
+    tsi_zero_copy_grpc_protector* self, grpc_slice_buffer* protected_slices,
+    grpc_slice_buffer* unprotected_slices) {
+  if (self == nullptr || unprotected_slices == nullptr ||
+      protected_slices == nullptr) {
+    gpr_log(GPR_ERROR,
+            "Invalid nullptr arguments to zero-copy grpc unprotect.");
+    return TSI_INVALID_ARGUMENT;
+  }
+  tsi_ssl_zero_copy_grpc_protector* impl =
+      reinterpret_cast<tsi_ssl_zero_copy_grpc_protector*>(self);
+  /* Records decrypt to fewer bytes than they take on the wire, so a slice the
+     size of the input holds what it unprotects to, save for the rest of a
+     record it completes. */
+  size_t remaining = protected_slices->length;
+  grpc_slice output = grpc_empty_slice();
+  size_t used = 0;
+  tsi_result result = TSI_OK;
+  gpr_mu_lock(&impl->mu);
+  for (size_t i = 0; i < protected_slices->count && result == TSI_OK; i++) {
+    const unsigned char* bytes =
+        GRPC_SLICE_START_PTR(protected_slices->slices[i]);
+    size_t size = GRPC_SLICE_LENGTH(protected_slices->slices[i]);
+    while (size > 0 && result == TSI_OK) {
+      /* The network BIO only takes what fits next to the bytes of a record
+         the SSL object still waits on. */
+      int written_into_ssl = BIO_write(
+          impl->network_io, bytes,
+          static_cast<int>(std::min(size, static_cast<size_t>(INT_MAX))));
+      if (written_into_ssl <= 0) {
+        gpr_log(GPR_ERROR, "Sending protected frame to ssl failed with %d",
+                written_into_ssl);
+        result = TSI_INTERNAL_ERROR;
+        break;
+      }
+      bytes += written_into_ssl;
+      size -= static_cast<size_t>(written_into_ssl);
+      remaining -= static_cast<size_t>(written_into_ssl);
+      for (;;) {
+        unsigned char* dst = ssl_reserve_output(
+            &output, &used, 1,
+            std::max(remaining + static_cast<size_t>(written_into_ssl),
+                     static_cast<size_t>(
+                         TSI_SSL_MAX_PROTECTED_FRAME_SIZE_LOWER_BOUND)),
+            unprotected_slices);
+        size_t read_from_ssl = GRPC_SLICE_LENGTH(output) - used;
+        result = do_ssl_read(impl->ssl, dst, &read_from_ssl);
+        if (result != TSI_OK || read_from_ssl == 0) break;
+        used += read_from_ssl;
+      }
+    }
+  }
+  gpr_mu_unlock(&impl->mu);
+  ssl_flush_output(output, used, unprotected_slices);
+  grpc_slice_buffer_reset_and_unref_internal(protected_slices);
+  return result;
+}
+
+static void ssl_zero_copy_grpc_protector_destroy(
+    tsi_zero_copy_grpc_protector* self) {
+  if (self == nullptr) return;
+  tsi_ssl_zero_copy_grpc_protector* impl =
+      reinterpret_cast<tsi_ssl_zero_copy_grpc_protector*>(self);
+  gpr_free(impl->record_buffer);
+  if (impl->ssl != nullptr) SSL_free(impl->ssl);
+  if (impl->network_io != nullptr) BIO_free(impl->network_io);
+  gpr_mu_destroy(&impl->mu);
+  gpr_free(self);
+}
+
+static tsi_result ssl_zero_copy_grpc_protector_max_frame_size(
+    tsi_zero_copy_grpc_protector* self, size_t* max_frame_size) {
+  if (self == nullptr || max_frame_size == nullptr) return TSI_INVALID_ARGUMENT;
+  *max_frame_size =
+      reinterpret_cast<tsi_ssl_zero_copy_grpc_protector*>(self)
+          ->max_protected_frame_size;
+  return TSI_OK;
+}
+
+static const tsi_zero_copy_grpc_protector_vtable
+    zero_copy_grpc_protector_vtable = {
+        ssl_zero_copy_grpc_protector_protect,
+        ssl_zero_copy_grpc_protector_unprotect,
+        ssl_zero_copy_grpc_protector_destroy,
+        ssl_zero_copy_grpc_protector_max_frame_size,
+};
+
 /* --- tsi_server_handshaker_factory methods implementation. --- */
 
 static void tsi_ssl_handshaker_factory_destroy(
@@ -1302,11 +1700,30 @@ static tsi_result ssl_handshaker_result_extract_peer(
   return result;
 }
 
+/* Clamps the requested maximum protected frame size, if any, to what the SSL
+   protectors support and returns the size to use. */
+static size_t ssl_get_max_output_protected_frame_size(
+    size_t* max_output_protected_frame_size) {
+  if (max_output_protected_frame_size == nullptr) {
+    return TSI_SSL_MAX_PROTECTED_FRAME_SIZE_UPPER_BOUND;
+  }
+  if (*max_output_protected_frame_size >
+      TSI_SSL_MAX_PROTECTED_FRAME_SIZE_UPPER_BOUND) {
+    *max_output_protected_frame_size =
+        TSI_SSL_MAX_PROTECTED_FRAME_SIZE_UPPER_BOUND;
+  } else if (*max_output_protected_frame_size <
+             TSI_SSL_MAX_PROTECTED_FRAME_SIZE_LOWER_BOUND) {
+    *max_output_protected_frame_size =
+        TSI_SSL_MAX_PROTECTED_FRAME_SIZE_LOWER_BOUND;
+  }
+  return *max_output_protected_frame_size;
+}
+
 static tsi_result ssl_handshaker_result_create_frame_protector(
     const tsi_handshaker_result* self, size_t* max_output_protected_frame_size,
     tsi_frame_protector** protector) {
   size_t actual_max_output_protected_frame_size =
-      TSI_SSL_MAX_PROTECTED_FRAME_SIZE_UPPER_BOUND;
+      ssl_get_max_output_protected_frame_size(max_output_protected_frame_size);
   tsi_ssl_handshaker_result* impl =
       reinterpret_cast<tsi_ssl_handshaker_result*>(
           const_cast<tsi_handshaker_result*>(self));
@@ -1314,18 +1731,6 @@ static tsi_result ssl_handshaker_result_create_frame_protector(
       static_cast<tsi_ssl_frame_protector*>(
           gpr_zalloc(sizeof(*protector_impl)));
 
-  if (max_output_protected_frame_size != nullptr) {
-    if (*max_output_protected_frame_size >
-        TSI_SSL_MAX_PROTECTED_FRAME_SIZE_UPPER_BOUND) {
-      *max_output_protected_frame_size =
-          TSI_SSL_MAX_PROTECTED_FRAME_SIZE_UPPER_BOUND;
-    } else if (*max_output_protected_frame_size <
-               TSI_SSL_MAX_PROTECTED_FRAME_SIZE_LOWER_BOUND) {
-      *max_output_protected_frame_size =
-          TSI_SSL_MAX_PROTECTED_FRAME_SIZE_LOWER_BOUND;
-    }
-    actual_max_output_protected_frame_size = *max_output_protected_frame_size;
-  }
   protector_impl->buffer_size =
       actual_max_output_protected_frame_size - TSI_SSL_MAX_PROTECTION_OVERHEAD;
   protector_impl->buffer =
@@ -1337,6 +1742,10 @@ static tsi_result ssl_handshaker_result_create_frame_protector(
     return TSI_INTERNAL_ERROR;
   }
 
+#ifdef TSI_OPENSSL_WRITE_TRAFFIC_KEYS_SUPPORT
+  /* The write traffic keys can't be exported anymore. */
+  ssl_untrack_write_traffic(impl->ssl);
+#endif
   /* Transfer ownership of ssl and network_io to the frame protector. */
   protector_impl->ssl = impl->ssl;
   impl->ssl = nullptr;
@@ -1347,6 +1756,38 @@ static tsi_result ssl_handshaker_result_create_frame_protector(
   return TSI_OK;
 }
 
+static tsi_result ssl_handshaker_result_create_zero_copy_grpc_protector(
+    const tsi_handshaker_result* self, size_t* max_output_protected_frame_size,
+    tsi_zero_copy_grpc_protector** protector) {
+  tsi_ssl_handshaker_result* impl =
+      reinterpret_cast<tsi_ssl_handshaker_result*>(
+          const_cast<tsi_handshaker_result*>(self));
+  tsi_ssl_zero_copy_grpc_protector* protector_impl =
+      static_cast<tsi_ssl_zero_copy_grpc_protector*>(
+          gpr_zalloc(sizeof(*protector_impl)));
+  protector_impl->max_protected_frame_size =
+      ssl_get_max_output_protected_frame_size(max_output_protected_frame_size);
+  protector_impl->max_unprotected_data_size =
+      protector_impl->max_protected_frame_size -
+      TSI_SSL_MAX_PROTECTION_OVERHEAD;
+  protector_impl->record_buffer = static_cast<unsigned char*>(
+      gpr_malloc(protector_impl->max_unprotected_data_size));
+  gpr_mu_init(&protector_impl->mu);
+
+#ifdef TSI_OPENSSL_WRITE_TRAFFIC_KEYS_SUPPORT
+  /* The write traffic keys can't be exported anymore. */
+  ssl_untrack_write_traffic(impl->ssl);
+#endif
+  /* Transfer ownership of ssl and network_io to the frame protector. */
+  protector_impl->ssl = impl->ssl;
+  impl->ssl = nullptr;
+  protector_impl->network_io = impl->network_io;
+  impl->network_io = nullptr;
+  protector_impl->base.vtable = &zero_copy_grpc_protector_vtable;
+  *protector = &protector_impl->base;
+  return TSI_OK;
+}
+
 static tsi_result ssl_handshaker_result_get_unused_bytes(
     const tsi_handshaker_result* self, const unsigned char** bytes,
     size_t* bytes_size) {
@@ -1368,12 +1809,31 @@ static void ssl_handshaker_result_destroy(tsi_handshaker_result* self) {
 
 static const tsi_handshaker_result_vtable handshaker_result_vtable = {
     ssl_handshaker_result_extract_peer,
-    nullptr, /* create_zero_copy_grpc_protector */
+    ssl_handshaker_result_create_zero_copy_grpc_protector,
     ssl_handshaker_result_create_frame_protector,
     ssl_handshaker_result_get_unused_bytes,
     ssl_handshaker_result_destroy,
 };
 
+tsi_result tsi_ssl_handshaker_result_get_write_traffic_keys(
+    const tsi_handshaker_result* handshaker_result,
+    tsi_ssl_write_traffic_keys* keys) {
+  if (handshaker_result == nullptr || keys == nullptr) {
+    return TSI_INVALID_ARGUMENT;
+  }
+  if (handshaker_result->vtable != &handshaker_result_vtable) {
+    return TSI_UNIMPLEMENTED;
+  }
+  const tsi_ssl_handshaker_result* impl =
+      reinterpret_cast<const tsi_ssl_handshaker_result*>(handshaker_result);
+  if (impl->ssl == nullptr) return TSI_FAILED_PRECONDITION;
+#ifdef TSI_OPENSSL_WRITE_TRAFFIC_KEYS_SUPPORT
+  return ssl_get_write_traffic_keys(impl->ssl, keys);
+#else
+  return TSI_UNIMPLEMENTED;
+#endif
+}
+
 static tsi_result ssl_handshaker_result_create(
     tsi_ssl_handshaker* handshaker, unsigned char* unused_bytes,
     size_t unused_bytes_size, tsi_handshaker_result** handshaker_result) {
@@ -1589,6 +2049,20 @@ static const tsi_handshaker_vtable handshaker_vtable = {
     nullptr, /* shutdown */
 };
 
+tsi_result tsi_ssl_handshaker_track_write_traffic(tsi_handshaker* handshaker) {
+  if (handshaker == nullptr) return TSI_INVALID_ARGUMENT;
+  if (handshaker->vtable != &handshaker_vtable) return TSI_UNIMPLEMENTED;
+#ifdef TSI_OPENSSL_WRITE_TRAFFIC_KEYS_SUPPORT
+  tsi_ssl_handshaker* impl = reinterpret_cast<tsi_ssl_handshaker*>(handshaker);
+  if (ssl_get_write_traffic_state(impl->ssl) == nullptr) {
+    ssl_track_write_traffic(impl->ssl);
+  }
+  return TSI_OK;
+#else
+  return TSI_UNIMPLEMENTED;
+#endif
+}
+
 /* --- tsi_ssl_handshaker_factory common methods. --- */
 
 static void tsi_ssl_handshaker_resume_session(
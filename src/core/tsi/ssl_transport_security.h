@@ -333,6 +333,50 @@ void tsi_ssl_server_handshaker_factory_unref(
    - handle public suffix wildchar more strictly (e.g. *.co.uk) */
 int tsi_ssl_peer_matches_name(const tsi_peer* peer, absl::string_view name);
 
+/* --- Record encryption offload. ---
+
+   Traffic keys protecting the records one side of an established TLS session
+   writes next, laid out the way the Linux kernel TLS module takes them for
+   AES-GCM: the 4 byte implicit part of the nonce (salt), the 8 byte explicit
+   part (iv) and the big endian sequence number of the next record. */
+typedef struct tsi_ssl_write_traffic_keys {
+  /* TLS1_2_VERSION. */
+  int tls_version;
+  /* 16 for AES-128-GCM, 32 for AES-256-GCM. */
+  size_t key_size;
+  unsigned char key[32];
+  unsigned char salt[4];
+  unsigned char iv[8];
+  unsigned char record_sequence[8];
+} tsi_ssl_write_traffic_keys;
+
+/* Makes an SSL handshaker collect what is needed to export the write traffic
+   keys of the session it negotiates. Handshakers don't by default, since it
+   costs a callback per record written during the handshake.
+   - handshaker must be an SSL handshaker that has not processed any bytes
+     from the peer yet.
+
+   - This method returns TSI_OK on success, or TSI_UNIMPLEMENTED if handshaker
+     is not an SSL handshaker or the SSL library can't report the keys. */
+tsi_result tsi_ssl_handshaker_track_write_traffic(tsi_handshaker* handshaker);
+
+/* Exports the write traffic keys of the session negotiated by an SSL
+   handshaker, so that the records this side sends can be encrypted outside of
+   the frame protector. Once the keys are in use, nothing may be written
+   through a frame protector created from the same result.
+   - handshaker_result must come from an SSL handshaker passed to
+     tsi_ssl_handshaker_track_write_traffic, and must not have created a frame
+     protector yet.
+   - keys is filled in on success; the caller should cleanse it when done.
+
+   - This method returns TSI_OK on success, or TSI_UNIMPLEMENTED if the result
+     does not come from such a handshaker, the SSL library can't report the
+     keys, the session is not TLS 1.2 or the negotiated cipher is not
+     AES-GCM. */
+tsi_result tsi_ssl_handshaker_result_get_write_traffic_keys(
+    const tsi_handshaker_result* handshaker_result,
+    tsi_ssl_write_traffic_keys* keys);
+
 /* --- Testing support. ---
 
    These functions and typedefs are not intended to be used outside of testing.
@@ -20,13 +20,39 @@
 
 #include <climits>
 
+#include "absl/time/time.h"
+
 #include <grpc/support/log.h>
+#include <grpc/support/time.h>
 
+#include "src/core/lib/debug/trace.h"
 #include "src/core/lib/gprpp/thd.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
 
 namespace grpc {
 
+grpc_core::TraceFlag grpc_thread_manager_trace(false, "thread_manager");
+
+namespace {
+
+// How often target_pollers_ is reconsidered.
+const int64_t kAdjustIntervalNanos = 100 * GPR_NS_PER_MS;
+// Grow target_pollers_ if there was no poller for more than this fraction of
+// an interval.
+const double kStarvedFraction = 0.01;
+// Shrink target_pollers_ if there was always a poller and the threads spent
+// less than this fraction of an interval in DoWork().
+const double kIdleUtilization = 0.5;
+// How long a parked thread waits to be reused before it exits.
+const int64_t kParkedThreadLingerMs = 1000;
+
+int64_t NowNanos() {
+  gpr_timespec now = gpr_now(GPR_CLOCK_MONOTONIC);
+  return static_cast<int64_t>(now.tv_sec) * GPR_NS_PER_SEC + now.tv_nsec;
+}
+
+}  // namespace
+
 ThreadManager::WorkerThread::WorkerThread(ThreadManager* thd_mgr)
     : thd_mgr_(thd_mgr) {
   // Make thread creation exclusive with respect to its join happening in
@@ -57,6 +83,19 @@ ThreadManager::ThreadManager(const char* name,
       num_pollers_(0),
       min_pollers_(min_pollers),
       max_pollers_(max_pollers == -1 ? INT_MAX : max_pollers),
+      num_polling_(0),
+      target_pollers_(min_pollers),
+      window_start_(0),
+      starved_since_(0),
+      starved_nanos_(0),
+      busy_nanos_(0),
+      num_parked_(0),
+      num_wakeups_(0),
+      threads_created_(0),
+      threads_reused_(0),
+      threads_exited_(0),
+      target_increases_(0),
+      target_decreases_(0),
       num_threads_(0),
       max_active_threads_sofar_(0) {
   resource_user_ =
@@ -84,6 +123,7 @@ void ThreadManager::Wait() {
 void ThreadManager::Shutdown() {
   grpc_core::MutexLock lock(&mu_);
   shutdown_ = true;
+  park_cv_.SignalAll();
 }
 
 bool ThreadManager::IsShutdown() {
@@ -96,6 +136,21 @@ int ThreadManager::GetMaxActiveThreadsSoFar() {
   return max_active_threads_sofar_;
 }
 
+ThreadManager::Stats ThreadManager::GetStats() {
+  grpc_core::MutexLock lock(&mu_);
+  Stats stats;
+  stats.target_pollers = target_pollers_;
+  stats.num_pollers = num_pollers_;
+  stats.num_threads = num_threads_;
+  stats.num_parked = num_parked_;
+  stats.threads_created = threads_created_;
+  stats.threads_reused = threads_reused_;
+  stats.threads_exited = threads_exited_;
+  stats.target_increases = target_increases_;
+  stats.target_decreases = target_decreases_;
+  return stats;
+}
+
 void ThreadManager::MarkAsCompleted(WorkerThread* thd) {
   {
     grpc_core::MutexLock list_lock(&list_mu_);
@@ -105,6 +160,7 @@ void ThreadManager::MarkAsCompleted(WorkerThread* thd) {
   {
     grpc_core::MutexLock lock(&mu_);
     num_threads_--;
+    threads_exited_++;
     if (num_threads_ == 0) {
       shutdown_cv_.Signal();
     }
@@ -139,6 +195,9 @@ void ThreadManager::Initialize() {
     num_pollers_ = min_pollers_;
     num_threads_ = min_pollers_;
     max_active_threads_sofar_ = min_pollers_;
+    threads_created_ += min_pollers_;
+    window_start_ = NowNanos();
+    starved_since_ = window_start_;
   }
 
   for (int i = 0; i < min_pollers_; i++) {
@@ -149,6 +208,10 @@ void ThreadManager::Initialize() {
 }
 
 void ThreadManager::MainWorkLoop() {
+  {
+    grpc_core::MutexLock lock(&mu_);
+    StartPollingLocked(NowNanos());
+  }
   while (true) {
     void* tag;
     bool ok;
@@ -156,7 +219,9 @@ void ThreadManager::MainWorkLoop() {
 
     grpc_core::LockableAndReleasableMutexLock lock(&mu_);
     // Reduce the number of pollers by 1 and check what happened with the poll
+    int64_t now = NowNanos();
     num_pollers_--;
+    StopPollingLocked(now);
     bool done = false;
     switch (work_status) {
       case TIMEOUT:
@@ -169,14 +234,23 @@ void ThreadManager::MainWorkLoop() {
         done = true;
         break;
       case WORK_FOUND:
-        // If we got work and there are now insufficient pollers and there is
-        // quota available to create a new thread, start a new poller thread
+        // If we got work and there are now insufficient pollers, wake up a
+        // parked thread to poll or, if there is none and there is quota
+        // available to create a new thread, start a new poller thread
         bool resource_exhausted = false;
-        if (!shutdown_ && num_pollers_ < min_pollers_) {
-          if (grpc_resource_user_allocate_threads(resource_user_, 1)) {
+        if (!shutdown_ && num_pollers_ < target_pollers_) {
+          if (num_parked_ > num_wakeups_) {
+            // The parked thread already holds its thread quota
+            num_pollers_++;
+            num_wakeups_++;
+            threads_reused_++;
+            park_cv_.Signal();
+            lock.Release();
+          } else if (grpc_resource_user_allocate_threads(resource_user_, 1)) {
             // We can allocate a new poller thread
             num_pollers_++;
             num_threads_++;
+            threads_created_++;
             if (num_threads_ > max_active_threads_sofar_) {
               max_active_threads_sofar_ = num_threads_;
             }
@@ -190,6 +264,7 @@ void ThreadManager::MainWorkLoop() {
               grpc_core::MutexLock failure_lock(&mu_);
               num_pollers_--;
               num_threads_--;
+              threads_created_--;
               resource_exhausted = true;
               delete worker;
             }
@@ -209,16 +284,20 @@ void ThreadManager::MainWorkLoop() {
           // the work and continue polling with our existing poller threads
           lock.Release();
         }
+        int64_t start = NowNanos();
         // Lock is always released at this point - do the application work
         // or return resource exhausted if there is new work but we couldn't
         // get a thread in which to do it.
         DoWork(tag, ok, !resource_exhausted);
         // Take the lock again to check post conditions
         lock.Lock();
+        now = NowNanos();
+        busy_nanos_ += now - start;
         // If we're shutdown, we should finish at this point.
         if (shutdown_) done = true;
         break;
     }
+    MaybeAdjustTargetPollersLocked(now);
     // If we decided to finish the thread, break out of the while loop
     if (done) break;
 
@@ -249,11 +328,16 @@ void ThreadManager::MainWorkLoop() {
     // pollset mutex) that makes DoWork() take longer to finish thereby causing
     // new poller threads to be created even faster. This results in a thread
     // avalanche.
+    //
+    // A thread that is not needed for polling parks instead of exiting right
+    // away, so that the next burst of work reuses it rather than creating a
+    // new thread.
     if (num_pollers_ < max_pollers_) {
       num_pollers_++;
-    } else {
+    } else if (!ParkLocked()) {
       break;
     }
+    StartPollingLocked(NowNanos());
   };
 
   // This thread is exiting. Do some cleanup work i.e delete already completed
@@ -264,4 +348,60 @@ void ThreadManager::MainWorkLoop() {
   // enough threads.
 }
 
+void ThreadManager::StartPollingLocked(int64_t now) {
+  if (num_polling_++ == 0) starved_nanos_ += now - starved_since_;
+}
+
+void ThreadManager::StopPollingLocked(int64_t now) {
+  if (--num_polling_ == 0) starved_since_ = now;
+}
+
+void ThreadManager::MaybeAdjustTargetPollersLocked(int64_t now) {
+  int64_t window = now - window_start_;
+  if (window < kAdjustIntervalNanos) return;
+  if (num_polling_ == 0) {
+    starved_nanos_ += now - starved_since_;
+    starved_since_ = now;
+  }
+  double starved = static_cast<double>(starved_nanos_) / window;
+  double utilization = static_cast<double>(busy_nanos_) /
+                       (static_cast<double>(window) * num_threads_);
+  int old_target = target_pollers_;
+  if (starved > kStarvedFraction && target_pollers_ < max_pollers_) {
+    target_pollers_++;
+    target_increases_++;
+  } else if (starved_nanos_ == 0 && utilization < kIdleUtilization &&
+             target_pollers_ > min_pollers_) {
+    target_pollers_--;
+    target_decreases_++;
+  }
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_thread_manager_trace) &&
+      target_pollers_ != old_target) {
+    gpr_log(GPR_INFO,
+            "ThreadManager %p: starved %.1f%%, utilization %.1f%%, %d threads "
+            "(%d parked): target pollers %d -> %d",
+            this, starved * 100, utilization * 100, num_threads_, num_parked_,
+            old_target, target_pollers_);
+  }
+  window_start_ = now;
+  starved_nanos_ = 0;
+  busy_nanos_ = 0;
+}
+
+bool ThreadManager::ParkLocked() {
+  num_parked_++;
+  absl::Time deadline =
+      absl::Now() + absl::Milliseconds(kParkedThreadLingerMs);
+  while (num_wakeups_ == 0 && !shutdown_) {
+    if (park_cv_.WaitWithDeadline(&mu_, deadline)) break;
+  }
+  num_parked_--;
+  // A thread that found work counted this thread as a poller already.
+  if (num_wakeups_ > 0) {
+    num_wakeups_--;
+    return true;
+  }
+  return false;
+}
+
 }  // namespace grpc
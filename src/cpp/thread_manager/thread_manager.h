@@ -19,6 +19,8 @@
 #ifndef GRPC_INTERNAL_CPP_THREAD_MANAGER_H
 #define GRPC_INTERNAL_CPP_THREAD_MANAGER_H
 
+#include <stdint.h>
+
 #include <list>
 #include <memory>
 
@@ -92,6 +94,26 @@ class ThreadManager {
   // to check if resource_quota is properly being enforced.
   int GetMaxActiveThreadsSoFar();
 
+  // A snapshot of the thread manager's sizing decisions, for debugging and
+  // for tests. The same decisions are logged with GRPC_TRACE=thread_manager.
+  struct Stats {
+    // The number of pollers the thread manager currently tries to keep (see
+    // target_pollers_ below)
+    int target_pollers;
+    int num_pollers;
+    int num_threads;
+    // Threads that finished their work while enough threads were polling and
+    // are waiting to be reused
+    int num_parked;
+    int64_t threads_created;
+    // Times a parked thread was woken up to poll instead of creating a thread
+    int64_t threads_reused;
+    int64_t threads_exited;
+    int64_t target_increases;
+    int64_t target_decreases;
+  };
+  Stats GetStats();
+
  private:
   // Helper wrapper class around grpc_core::Thread. Takes a ThreadManager object
   // and starts a new grpc_core::Thread to calls the Run() function.
@@ -141,8 +163,23 @@ class ThreadManager {
   void MarkAsCompleted(WorkerThread* thd);
   void CleanupCompletedThreads();
 
-  // Protects shutdown_, num_pollers_, num_threads_ and
-  // max_active_threads_sofar_
+  // Update num_polling_, keeping track of how long no thread was polling.
+  void StartPollingLocked(int64_t now) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  void StopPollingLocked(int64_t now) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+  // Once per adjustment interval, moves target_pollers_ by one based on how
+  // long the thread manager went without a poller and how busy its threads
+  // were during the interval.
+  void MaybeAdjustTargetPollersLocked(int64_t now)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+  // Parks a thread that is not needed for polling. Returns true if the thread
+  // was handed a poller slot by a thread that found work, false if it should
+  // exit (nobody reused it for a while, or the thread manager is shut down).
+  bool ParkLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+  // Protects shutdown_, num_pollers_, num_threads_, the parked threads and the
+  // adaptive sizing state
   grpc_core::Mutex mu_;
 
   bool shutdown_;
@@ -163,6 +200,37 @@ class ThreadManager {
   int min_pollers_;
   int max_pollers_;
 
+  // Number of threads actually in PollForWork(). This lags num_pollers_ while
+  // a thread counted as a poller is being created or woken up, and incoming
+  // work waits in the meantime if it is zero.
+  int num_polling_;
+
+  // The number of pollers below which a thread that found work wakes up or
+  // creates another poller before doing its work. It stays within
+  // [min_pollers_, max_pollers_]: it grows when work had to wait because no
+  // thread was polling, and shrinks when the threads are mostly idle.
+  int target_pollers_;
+
+  // Adaptive sizing state for the current adjustment interval: when it
+  // started, how long no thread was polling (since starved_since_ if none is
+  // now) and the total time threads spent in DoWork().
+  int64_t window_start_;
+  int64_t starved_since_;
+  int64_t starved_nanos_;
+  int64_t busy_nanos_;
+
+  // Parked threads (see ParkLocked()), and the number of them that were handed
+  // a poller slot but have not woken up yet
+  int num_parked_;
+  int num_wakeups_;
+  grpc_core::CondVar park_cv_;
+
+  int64_t threads_created_;
+  int64_t threads_reused_;
+  int64_t threads_exited_;
+  int64_t target_increases_;
+  int64_t target_decreases_;
+
   // The total number of threads currently active (includes threads includes the
   // threads that are currently polling i.e num_pollers_)
   int num_threads_;
@@ -79,6 +79,68 @@ static int fake_pointer_cmp(void* a, void* b) {
 static const grpc_arg_pointer_vtable fake_pointer_arg_vtable = {
     fake_pointer_arg_copy, fake_pointer_arg_destroy, fake_pointer_cmp};
 
+static void* shared_pointer_arg_copy(void* arg) { return arg; }
+
+static void shared_pointer_arg_destroy(void* /*arg*/) {}
+
+// Copies of args with this vtable compare equal.
+static const grpc_arg_pointer_vtable shared_pointer_arg_vtable = {
+    shared_pointer_arg_copy, shared_pointer_arg_destroy, fake_pointer_cmp};
+
+static void test_persistent_args(void) {
+  fake_class fc = {42};
+  grpc_arg a[4];
+  a[0] = grpc_channel_arg_integer_create(const_cast<char*>("b_int"), 1);
+  a[1] = grpc_channel_arg_string_create(const_cast<char*>("a_str"),
+                                        const_cast<char*>("str value"));
+  a[2] = grpc_channel_arg_pointer_create(const_cast<char*>("c_ptr"), &fc,
+                                         &shared_pointer_arg_vtable);
+  // Ignored: "b_int" is already set.
+  a[3] = grpc_channel_arg_integer_create(const_cast<char*>("b_int"), 2);
+  grpc_channel_args c_args = {GPR_ARRAY_SIZE(a), a};
+
+  grpc_core::ChannelArgs args(&c_args);
+  GPR_ASSERT(args.size() == 3);
+  GPR_ASSERT(args.Get("b_int")->value.integer == 1);
+  GPR_ASSERT(strcmp(args.Get("a_str")->value.string, "str value") == 0);
+  GPR_ASSERT(args.Get("c_ptr")->value.pointer.p == &fc);
+  GPR_ASSERT(args.Get("missing") == nullptr);
+
+  // The C view is sorted by key.
+  const grpc_channel_args* view = args.ToC();
+  GPR_ASSERT(view->num_args == 3);
+  GPR_ASSERT(strcmp(view->args[0].key, "a_str") == 0);
+  GPR_ASSERT(strcmp(view->args[1].key, "b_int") == 0);
+  GPR_ASSERT(strcmp(view->args[2].key, "c_ptr") == 0);
+  GPR_ASSERT(args.ToC() == view);
+
+  // Set and Remove leave the original set unchanged.
+  grpc_core::ChannelArgs replaced = args.Set(a[3]);
+  GPR_ASSERT(replaced.size() == 3);
+  GPR_ASSERT(replaced.Get("b_int")->value.integer == 2);
+  GPR_ASSERT(args.Get("b_int")->value.integer == 1);
+  GPR_ASSERT(replaced != args);
+  grpc_core::ChannelArgs removed = args.Remove("a_str");
+  GPR_ASSERT(removed.size() == 2);
+  GPR_ASSERT(removed.Get("a_str") == nullptr);
+  GPR_ASSERT(args.Get("a_str") != nullptr);
+  GPR_ASSERT(removed.Remove("missing") == removed);
+
+  // Sets with the same args are equal however they were built.
+  grpc_core::ChannelArgs rebuilt =
+      grpc_core::ChannelArgs().Set(a[2]).Set(a[0]).Set(a[1]);
+  GPR_ASSERT(rebuilt == args);
+  GPR_ASSERT(rebuilt.Hash() == args.Hash());
+  GPR_ASSERT(replaced.Set(a[0]) == args);
+  GPR_ASSERT(removed.Set(a[1]) == args);
+  GPR_ASSERT((removed < args) != (args < removed));
+
+  grpc_core::ChannelArgs empty = removed.Remove("b_int").Remove("c_ptr");
+  GPR_ASSERT(empty.size() == 0);
+  GPR_ASSERT(empty == grpc_core::ChannelArgs());
+  GPR_ASSERT(empty.ToC()->num_args == 0);
+}
+
 static void test_channel_create_with_args(void) {
   grpc_arg client_a[3];
 
@@ -206,6 +268,7 @@ int main(int argc, char** argv) {
   grpc::testing::TestEnvironment env(argc, argv);
   grpc_init();
   test_create();
+  test_persistent_args();
   test_channel_create_with_args();
   test_server_create_with_args();
   // This has to be the last test.
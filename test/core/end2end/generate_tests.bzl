@@ -91,6 +91,7 @@ END2END_FIXTURES = {
     ),
     "h2_ssl": _fixture_options(secure = True),
     "h2_ssl_cred_reload": _fixture_options(secure = True),
+    "h2_ssl_kernel_tls": _fixture_options(secure = True, _platforms = ["linux"]),
     "h2_tls": _fixture_options(secure = True),
     "h2_local_uds": _fixture_options(
         secure = True,
@@ -159,6 +160,7 @@ END2END_NOSEC_FIXTURES = {
     ),
     "h2_ssl": _fixture_options(secure = False),
     "h2_ssl_cred_reload": _fixture_options(secure = False),
+    "h2_ssl_kernel_tls": _fixture_options(secure = False, _platforms = ["linux"]),
     "h2_ssl_proxy": _fixture_options(includes_proxy = True, secure = False),
     "h2_uds": _fixture_options(
         dns_resolver = False,
@@ -115,6 +115,43 @@ static void concurrent_test(void) {
   args.arena->Destroy();
 }
 
+static void cache_test_body(void* arg) {
+  gpr_event_wait(static_cast<gpr_event*>(arg),
+                 gpr_inf_future(GPR_CLOCK_REALTIME));
+  for (size_t i = 0; i < concurrent_test_iterations() / 100; i++) {
+    // Cover storage in and beyond the cached size classes, for both the
+    // initial zone and the zones added to it.
+    size_t size = size_t(1) << (i % 18);
+    Arena* a = Arena::Create(size);
+    memset(a->Alloc(size), 1, size);
+    memset(a->Alloc(2 * size), 2, 2 * size);
+    a->Destroy();
+    if (i % 1000 == 0) Arena::TrimCache();
+  }
+}
+
+static void cache_test(void) {
+  gpr_log(GPR_DEBUG, "cache_test");
+
+  gpr_event ev_start;
+  gpr_event_init(&ev_start);
+
+  grpc_core::Thread thds[CONCURRENT_TEST_THREADS];
+
+  for (int i = 0; i < CONCURRENT_TEST_THREADS; i++) {
+    thds[i] = grpc_core::Thread("grpc_cache_test", cache_test_body, &ev_start);
+    thds[i].Start();
+  }
+
+  gpr_event_set(&ev_start, reinterpret_cast<void*>(1));
+
+  for (auto& th : thds) {
+    th.Join();
+  }
+
+  Arena::TrimCache();
+}
+
 int main(int argc, char* argv[]) {
   grpc::testing::TestEnvironment env(argc, argv);
 
@@ -126,6 +163,7 @@ int main(int argc, char* argv[]) {
   TEST(1_inc, 1, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11);
   TEST(6_123, 6, 1, 2, 3);
   concurrent_test();
+  cache_test();
 
   return 0;
 }
@@ -24,6 +24,7 @@
 #include <errno.h>
 #include <fcntl.h>
 #include <string.h>
+#include <sys/mman.h>
 #include <sys/socket.h>
 #include <sys/types.h>
 #include <unistd.h>
@@ -249,9 +250,26 @@ static void read_test(size_t num_bytes, size_t slice_size) {
   grpc_endpoint_destroy(ep);
 }
 
+/* Whether TCP_ZEROCOPY_RECEIVE can be used on fd, a connected TCP socket: it
+   needs build support and a kernel that lets TCP sockets be mapped. */
+static bool rx_zerocopy_supported(int fd) {
+#ifdef GRPC_HAVE_TCP_ZEROCOPY_RECEIVE
+  size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  void* address = mmap(nullptr, page_size, PROT_READ, MAP_SHARED, fd, 0);
+  if (address == MAP_FAILED) return false;
+  munmap(address, page_size);
+  return true;
+#else
+  (void)fd;
+  return false;
+#endif
+}
+
 /* Write to a socket until it fills up, then read from it using the grpc_tcp
-   API. */
-static void large_read_test(size_t slice_size) {
+   API. With rx_zerocopy, the socket is a loopback TCP connection with receive
+   zerocopy enabled: reads may be served either from mapped pages or by
+   copying, and the data must be identical in both cases. */
+static void large_read_test(size_t slice_size, bool rx_zerocopy) {
   int sv[2];
   grpc_endpoint* ep;
   struct read_socket_state state;
@@ -260,14 +278,26 @@ static void large_read_test(size_t slice_size) {
       grpc_timespec_to_millis_round_up(grpc_timeout_seconds_to_deadline(20));
   grpc_core::ExecCtx exec_ctx;
 
-  gpr_log(GPR_INFO, "Start large read test, slice size %" PRIuPTR, slice_size);
+  gpr_log(GPR_INFO, "Start large read test, slice size %" PRIuPTR
+          ", rx zerocopy %d",
+          slice_size, rx_zerocopy);
 
-  create_sockets(sv);
+  if (rx_zerocopy) {
+    create_inet_sockets(sv);
+  } else {
+    create_sockets(sv);
+  }
 
-  grpc_arg a[1];
+  grpc_arg a[3];
   a[0].key = const_cast<char*>(GRPC_ARG_TCP_READ_CHUNK_SIZE);
   a[0].type = GRPC_ARG_INTEGER;
   a[0].value.integer = static_cast<int>(slice_size);
+  a[1].key = const_cast<char*>(GRPC_ARG_TCP_RX_ZEROCOPY_ENABLED);
+  a[1].type = GRPC_ARG_INTEGER;
+  a[1].value.integer = rx_zerocopy;
+  a[2].key = const_cast<char*>(GRPC_ARG_TCP_RX_ZEROCOPY_RECV_BYTES_THRESHOLD);
+  a[2].type = GRPC_ARG_INTEGER;
+  a[2].value.integer = 4096;
   grpc_channel_args args = {GPR_ARRAY_SIZE(a), a};
   ep = grpc_tcp_create(grpc_fd_create(sv[1], "large_read_test", false), &args,
                        "test", grpc_slice_allocator_create_unlimited());
@@ -296,6 +326,25 @@ static void large_read_test(size_t slice_size) {
   GPR_ASSERT(state.read_bytes == state.target_read_bytes);
   gpr_mu_unlock(g_mu);
 
+  if (rx_zerocopy) {
+    /* Whether a read can actually be mapped depends on how the kernel laid
+       out the received data (loopback rarely produces page aligned payload),
+       but with the socket full every read is over the threshold, so the
+       zerocopy path must at least have been tried. */
+    if (rx_zerocopy_supported(sv[1])) {
+      size_t attempts;
+      size_t reads;
+      grpc_tcp_zerocopy_reads_for_testing(ep, &attempts, &reads);
+      gpr_log(GPR_INFO,
+              "%" PRIuPTR " rx zerocopy attempts, %" PRIuPTR " mapped reads",
+              attempts, reads);
+      GPR_ASSERT(attempts > 0);
+    } else {
+      gpr_log(GPR_INFO,
+              "TCP rx zerocopy is not supported here, skipping its checks");
+    }
+  }
+
   grpc_slice_buffer_destroy_internal(&state.incoming);
   grpc_endpoint_destroy(ep);
 }
@@ -565,8 +614,10 @@ void run_tests(void) {
   read_test(10000, 8192);
   read_test(10000, 137);
   read_test(10000, 1);
-  large_read_test(8192);
-  large_read_test(1);
+  large_read_test(8192, false);
+  large_read_test(1, false);
+  large_read_test(256 * 1024, true);
+  large_read_test(8192, true);
 
   write_test(100, 8192, false);
   write_test(100, 1, false);
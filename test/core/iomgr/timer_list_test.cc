@@ -23,10 +23,13 @@
 
 #include <string.h>
 
+#include <atomic>
+
 #include <grpc/grpc.h>
 #include <grpc/support/log.h>
 
 #include "src/core/lib/debug/trace.h"
+#include "src/core/lib/gprpp/thd.h"
 #include "src/core/lib/iomgr/iomgr_internal.h"
 #include "src/core/lib/iomgr/timer.h"
 #include "test/core/util/test_config.h"
@@ -36,6 +39,7 @@
 
 extern grpc_core::TraceFlag grpc_timer_trace;
 extern grpc_core::TraceFlag grpc_timer_check_trace;
+extern grpc_timer_vtable grpc_wheel_timer_vtable;
 
 static int cb_called[MAX_CB][2];
 static const int64_t kMillisIn25Days = 2160000000;
@@ -153,6 +157,132 @@ void destruction_test(void) {
   GPR_ASSERT(1 == cb_called[2][0]);
 }
 
+/* Timers spread from milliseconds to hours out, so that with the timer wheel
+   they land on every level and cascade down as time advances. Every other
+   timer is cancelled; the rest must fire exactly when their deadline is
+   reached, and cancelling a fired timer must be a no-op. */
+static void cascade_test(void) {
+  grpc_timer timers[MAX_CB];
+  grpc_millis deadlines[MAX_CB];
+  grpc_core::ExecCtx exec_ctx;
+
+  gpr_log(GPR_INFO, "cascade_test");
+
+  grpc_core::ExecCtx::Get()->TestOnlySetNow(0);
+  grpc_timer_list_init();
+  memset(cb_called, 0, sizeof(cb_called));
+
+  for (int i = 0; i < MAX_CB; i++) {
+    deadlines[i] = 1 + static_cast<grpc_millis>(i) * i * i * 700;
+    grpc_timer_init(
+        &timers[i], deadlines[i],
+        GRPC_CLOSURE_CREATE(cb, (void*)(intptr_t)i, grpc_schedule_on_exec_ctx));
+  }
+  for (int i = 1; i < MAX_CB; i += 2) {
+    grpc_timer_cancel(&timers[i]);
+  }
+  grpc_core::ExecCtx::Get()->Flush();
+
+  for (int i = 0; i < MAX_CB; i += 2) {
+    grpc_core::ExecCtx::Get()->TestOnlySetNow(deadlines[i] - 1);
+    grpc_timer_check(nullptr);
+    grpc_core::ExecCtx::Get()->Flush();
+    GPR_ASSERT(0 == cb_called[i][1]);
+    grpc_core::ExecCtx::Get()->TestOnlySetNow(deadlines[i]);
+    GPR_ASSERT(grpc_timer_check(nullptr) == GRPC_TIMERS_FIRED);
+    grpc_core::ExecCtx::Get()->Flush();
+    GPR_ASSERT(1 == cb_called[i][1]);
+    grpc_timer_cancel(&timers[i]);
+    grpc_core::ExecCtx::Get()->Flush();
+    GPR_ASSERT(0 == cb_called[i][0]);
+  }
+  for (int i = 1; i < MAX_CB; i += 2) {
+    GPR_ASSERT(1 == cb_called[i][0]);
+    GPR_ASSERT(0 == cb_called[i][1]);
+  }
+
+  grpc_timer_list_shutdown();
+  grpc_core::ExecCtx::Get()->Flush();
+  for (int i = 0; i < MAX_CB; i++) {
+    GPR_ASSERT(1 == cb_called[i][0] + cb_called[i][1]);
+  }
+}
+
+/* Races grpc_timer_init() against grpc_timer_check(). Every timer is due by
+   the time the checker runs, so each must fire once the last check after the
+   inits have finished is done; a check that publishes a stale minimum would
+   leave some of them pending. */
+#define STRESS_THREADS 4
+#define STRESS_TIMERS_PER_THREAD 5000
+#define STRESS_NOW 1000
+
+static grpc_timer stress_timers[STRESS_THREADS][STRESS_TIMERS_PER_THREAD];
+static grpc_closure stress_closures[STRESS_THREADS][STRESS_TIMERS_PER_THREAD];
+static std::atomic<int> stress_fired;
+static std::atomic<bool> stress_done;
+
+static void stress_cb(void* /*arg*/, grpc_error_handle error) {
+  if (error == GRPC_ERROR_NONE) stress_fired.fetch_add(1);
+}
+
+static void stress_init_loop(void* arg) {
+  intptr_t thread = reinterpret_cast<intptr_t>(arg);
+  grpc_core::ExecCtx exec_ctx;
+  grpc_core::ExecCtx::Get()->TestOnlySetNow(0);
+  for (int i = 0; i < STRESS_TIMERS_PER_THREAD; i++) {
+    grpc_timer_init(
+        &stress_timers[thread][i], 1 + i % STRESS_NOW,
+        GRPC_CLOSURE_INIT(&stress_closures[thread][i], stress_cb, nullptr,
+                          grpc_schedule_on_exec_ctx));
+  }
+}
+
+static void stress_check_loop(void* /*arg*/) {
+  grpc_core::ExecCtx exec_ctx;
+  grpc_core::ExecCtx::Get()->TestOnlySetNow(STRESS_NOW);
+  while (!stress_done.load()) {
+    grpc_timer_check(nullptr);
+    grpc_core::ExecCtx::Get()->Flush();
+  }
+}
+
+static void concurrent_init_check_test(void) {
+  grpc_core::ExecCtx exec_ctx;
+
+  gpr_log(GPR_INFO, "concurrent_init_check_test");
+
+  grpc_tracer_set_enabled("timer", 0);
+  grpc_tracer_set_enabled("timer_check", 0);
+  grpc_core::ExecCtx::Get()->TestOnlySetNow(0);
+  grpc_timer_list_init();
+  stress_fired.store(0);
+  stress_done.store(false);
+
+  grpc_core::Thread checker("grpc_timer_stress_check", stress_check_loop,
+                            nullptr);
+  checker.Start();
+  grpc_core::Thread initers[STRESS_THREADS];
+  for (intptr_t i = 0; i < STRESS_THREADS; i++) {
+    initers[i] = grpc_core::Thread("grpc_timer_stress_init", stress_init_loop,
+                                   reinterpret_cast<void*>(i));
+    initers[i].Start();
+  }
+  for (int i = 0; i < STRESS_THREADS; i++) {
+    initers[i].Join();
+  }
+  stress_done.store(true);
+  checker.Join();
+
+  grpc_core::ExecCtx::Get()->TestOnlySetNow(STRESS_NOW);
+  grpc_timer_consume_kick();
+  grpc_timer_check(nullptr);
+  grpc_core::ExecCtx::Get()->Flush();
+  GPR_ASSERT(stress_fired.load() == STRESS_THREADS * STRESS_TIMERS_PER_THREAD);
+
+  grpc_timer_list_shutdown();
+  grpc_core::ExecCtx::Get()->Flush();
+}
+
 /* Cleans up a list with pending timers that simulate long-running-services.
    This test does the following:
     1) Simulates grpc server start time to 25 days in the past (completed in
@@ -229,6 +359,25 @@ int main(int argc, char** argv) {
     gpr_set_log_verbosity(GPR_LOG_SEVERITY_DEBUG);
     add_test();
     destruction_test();
+    cascade_test();
+    concurrent_init_check_test();
+    grpc_iomgr_platform_shutdown();
+  }
+  grpc_core::ExecCtx::GlobalShutdown();
+
+  /* Same tests against the timer wheel */
+  {
+    grpc::testing::TestEnvironment env(argc, argv);
+    grpc_core::ExecCtx::GlobalInit();
+    grpc_core::ExecCtx exec_ctx;
+    grpc_set_default_iomgr_platform();
+    grpc_set_timer_impl(&grpc_wheel_timer_vtable);
+    grpc_iomgr_platform_init();
+    gpr_set_log_verbosity(GPR_LOG_SEVERITY_DEBUG);
+    add_test();
+    destruction_test();
+    cascade_test();
+    concurrent_init_check_test();
     grpc_iomgr_platform_shutdown();
   }
   grpc_core::ExecCtx::GlobalShutdown();
@@ -255,6 +404,26 @@ int main(int argc, char** argv) {
   }
   grpc_core::ExecCtx::GlobalShutdown();
 
+  /* Long running service tests against the timer wheel */
+  {
+    grpc::testing::TestEnvironment env(argc, argv);
+    gpr_timespec new_start =
+        gpr_time_sub(gpr_now(gpr_clock_type::GPR_CLOCK_MONOTONIC),
+                     gpr_time_from_hours(kHoursIn25Days,
+                                         gpr_clock_type::GPR_CLOCK_MONOTONIC));
+    grpc_core::ExecCtx::TestOnlyGlobalInit(new_start);
+    grpc_core::ExecCtx exec_ctx;
+    grpc_set_default_iomgr_platform();
+    grpc_set_timer_impl(&grpc_wheel_timer_vtable);
+    grpc_iomgr_platform_init();
+    gpr_set_log_verbosity(GPR_LOG_SEVERITY_DEBUG);
+    long_running_service_cleanup_test();
+    add_test();
+    destruction_test();
+    grpc_iomgr_platform_shutdown();
+  }
+  grpc_core::ExecCtx::GlobalShutdown();
+
   return 0;
 }
 
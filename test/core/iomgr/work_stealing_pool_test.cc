@@ -0,0 +1,247 @@
+/*
+ *
+ * Copyright 2021 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "src/core/lib/iomgr/executor/work_stealing_pool.h"
+
+#include <atomic>
+#include <vector>
+
+#include <grpc/grpc.h>
+#include <grpc/support/log.h>
+#include <grpc/support/sync.h>
+
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "test/core/util/test_config.h"
+
+static const int kStealers = 4;
+static const int kDequeIter = 100000;
+static const int kPoolThreads = 8;
+static const int kPoolIter = 10000;
+
+static void test_deque_order(void) {
+  gpr_log(GPR_INFO, "test_deque_order");
+  grpc_core::WorkStealingDeque deque;
+  std::vector<grpc_closure> closures(grpc_core::WorkStealingDeque::kCapacity);
+  GPR_ASSERT(deque.Empty());
+  GPR_ASSERT(deque.Pop() == nullptr);
+  GPR_ASSERT(deque.Steal() == nullptr);
+  for (auto& c : closures) GPR_ASSERT(deque.Push(&c));
+  // Full.
+  grpc_closure extra;
+  GPR_ASSERT(!deque.Push(&extra));
+  // The owner pops the newest, thieves steal the oldest.
+  GPR_ASSERT(deque.Pop() == &closures.back());
+  GPR_ASSERT(deque.Steal() == &closures.front());
+  for (size_t i = closures.size() - 2; i > 0; i--) {
+    GPR_ASSERT(deque.Pop() == &closures[i]);
+  }
+  GPR_ASSERT(deque.Empty());
+  GPR_ASSERT(deque.Pop() == nullptr);
+  GPR_ASSERT(deque.Steal() == nullptr);
+  // Indices keep increasing past the capacity.
+  for (int i = 0; i < 3; i++) {
+    for (auto& c : closures) GPR_ASSERT(deque.Push(&c));
+    for (auto& c : closures) GPR_ASSERT(deque.Steal() == &c);
+  }
+}
+
+// The owner pushes and pops while thieves steal: every closure must be taken
+// exactly once.
+static void test_deque_concurrent_steal(void) {
+  gpr_log(GPR_INFO, "test_deque_concurrent_steal");
+  struct Shared {
+    Shared() : closures(kDequeIter), taken(kDequeIter) {
+      for (auto& t : taken) t.store(0);
+    }
+    void Take(grpc_closure* c) { taken[c - closures.data()]++; }
+
+    grpc_core::WorkStealingDeque deque;
+    std::vector<grpc_closure> closures;
+    std::vector<std::atomic<int>> taken;
+    std::atomic<bool> done{false};
+  } s;
+  std::vector<grpc_core::Thread> thieves;
+  for (int i = 0; i < kStealers; i++) {
+    thieves.emplace_back(
+        "test_thief",
+        [](void* arg) {
+          Shared* s = static_cast<Shared*>(arg);
+          while (!s->done.load() || !s->deque.Empty()) {
+            grpc_closure* c = s->deque.Steal();
+            if (c != nullptr) s->Take(c);
+          }
+        },
+        &s);
+    thieves.back().Start();
+  }
+  int pushed = 0;
+  while (pushed < kDequeIter) {
+    // Push a few, pop one, so that the owner and thieves meet at both ends.
+    for (int i = 0; i < 3 && pushed < kDequeIter; i++) {
+      if (!s.deque.Push(&s.closures[pushed])) break;
+      pushed++;
+    }
+    grpc_closure* c = s.deque.Pop();
+    if (c != nullptr) s.Take(c);
+  }
+  s.done.store(true);
+  for (auto& t : thieves) t.Join();
+  GPR_ASSERT(s.deque.Empty());
+  for (auto& t : s.taken) GPR_ASSERT(t.load() == 1);
+}
+
+struct Counter {
+  std::atomic<int> count{0};
+  gpr_event done;
+  int target;
+  explicit Counter(int target) : target(target) { gpr_event_init(&done); }
+  void Increment() {
+    if (++count == target) gpr_event_set(&done, reinterpret_cast<void*>(1));
+  }
+  void Wait() {
+    GPR_ASSERT(gpr_event_wait(&done, grpc_timeout_seconds_to_deadline(30)));
+  }
+};
+
+static void count_cb(void* arg, grpc_error_handle /*error*/) {
+  static_cast<Counter*>(arg)->Increment();
+}
+
+static void test_pool_add(void) {
+  gpr_log(GPR_INFO, "test_pool_add");
+  grpc_core::ExecCtx exec_ctx;
+  Counter counter(kPoolIter);
+  std::vector<grpc_closure> closures(kPoolIter);
+  grpc_core::WorkStealingThreadPool* pool =
+      new grpc_core::WorkStealingThreadPool("test_pool_add", kPoolThreads);
+  for (auto& c : closures) {
+    pool->Add(GRPC_CLOSURE_INIT(&c, count_cb, &counter, nullptr),
+              GRPC_ERROR_NONE, true);
+  }
+  counter.Wait();
+  GPR_ASSERT(pool->num_threads() >= 1);
+  GPR_ASSERT(pool->num_threads() <= kPoolThreads);
+  pool->Shutdown();
+  delete pool;
+}
+
+// Each closure adds two more from the pool until kPoolIter have run, which
+// exercises the LIFO slot, the deques and stealing.
+struct FanOut {
+  grpc_core::WorkStealingThreadPool* pool;
+  Counter* counter;
+  std::atomic<int> started{1};
+  std::vector<grpc_closure> closures = std::vector<grpc_closure>(kPoolIter);
+};
+
+static void fan_out_cb(void* arg, grpc_error_handle /*error*/) {
+  FanOut* f = static_cast<FanOut*>(arg);
+  for (int i = 0; i < 2; i++) {
+    int n = f->started++;
+    if (n >= kPoolIter) break;
+    f->pool->Add(GRPC_CLOSURE_INIT(&f->closures[n], fan_out_cb, f, nullptr),
+                 GRPC_ERROR_NONE, true);
+  }
+  f->counter->Increment();
+}
+
+static void test_pool_fan_out(void) {
+  gpr_log(GPR_INFO, "test_pool_fan_out");
+  grpc_core::ExecCtx exec_ctx;
+  Counter counter(kPoolIter);
+  FanOut f;
+  f.pool = new grpc_core::WorkStealingThreadPool("test_pool_fan_out",
+                                                 kPoolThreads);
+  f.counter = &counter;
+  f.pool->Add(GRPC_CLOSURE_INIT(&f.closures[0], fan_out_cb, &f, nullptr),
+              GRPC_ERROR_NONE, true);
+  counter.Wait();
+  f.pool->Shutdown();
+  delete f.pool;
+}
+
+// A closure that blocks until a closure it added runs: the added closure sits
+// in the blocked thread's LIFO slot and must be stolen by another thread.
+struct Blocking {
+  grpc_core::WorkStealingThreadPool* pool;
+  grpc_closure blocker;
+  grpc_closure unblocker;
+  gpr_event unblocked;
+};
+
+static void unblock_cb(void* arg, grpc_error_handle /*error*/) {
+  gpr_event_set(&static_cast<Blocking*>(arg)->unblocked,
+                reinterpret_cast<void*>(1));
+}
+
+static void block_cb(void* arg, grpc_error_handle /*error*/) {
+  Blocking* b = static_cast<Blocking*>(arg);
+  b->pool->Add(GRPC_CLOSURE_INIT(&b->unblocker, unblock_cb, b, nullptr),
+               GRPC_ERROR_NONE, true);
+  GPR_ASSERT(
+      gpr_event_wait(&b->unblocked, grpc_timeout_seconds_to_deadline(30)));
+}
+
+static void test_pool_blocked_thread(void) {
+  gpr_log(GPR_INFO, "test_pool_blocked_thread");
+  grpc_core::ExecCtx exec_ctx;
+  Blocking b;
+  gpr_event_init(&b.unblocked);
+  b.pool =
+      new grpc_core::WorkStealingThreadPool("test_pool_blocked_thread", 2);
+  Counter counter(1);
+  grpc_closure after;
+  b.pool->Add(GRPC_CLOSURE_INIT(&b.blocker, block_cb, &b, nullptr),
+              GRPC_ERROR_NONE, false);
+  b.pool->Add(GRPC_CLOSURE_INIT(&after, count_cb, &counter, nullptr),
+              GRPC_ERROR_NONE, true);
+  counter.Wait();
+  b.pool->Shutdown();
+  delete b.pool;
+}
+
+// Closures still queued at shutdown run in the destructor.
+static void test_pool_shutdown_runs_pending(void) {
+  gpr_log(GPR_INFO, "test_pool_shutdown_runs_pending");
+  grpc_core::ExecCtx exec_ctx;
+  Counter counter(kPoolIter);
+  std::vector<grpc_closure> closures(kPoolIter);
+  grpc_core::WorkStealingThreadPool* pool =
+      new grpc_core::WorkStealingThreadPool("test_pool_shutdown_runs_pending",
+                                            kPoolThreads);
+  for (auto& c : closures) {
+    pool->Add(GRPC_CLOSURE_INIT(&c, count_cb, &counter, nullptr),
+              GRPC_ERROR_NONE, true);
+  }
+  pool->Shutdown();
+  delete pool;
+  GPR_ASSERT(counter.count.load() == kPoolIter);
+}
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(argc, argv);
+  grpc_init();
+  test_deque_order();
+  test_deque_concurrent_steal();
+  test_pool_add();
+  test_pool_fan_out();
+  test_pool_blocked_thread();
+  test_pool_shutdown_runs_pending();
+  grpc_shutdown();
+  return 0;
+}
@@ -23,6 +23,8 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include "absl/strings/str_cat.h"
+
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 #include <grpc/support/string_util.h>
@@ -286,6 +288,59 @@ TEST(Json, Equality) {
   EXPECT_NE(Json(1), Json());
 }
 
+// Records each event as a string.
+class EventRecorder : public JsonEventHandler {
+ public:
+  void StartObject() override { events_.push_back("{"); }
+  void EndObject() override { events_.push_back("}"); }
+  void StartArray() override { events_.push_back("["); }
+  void EndArray() override { events_.push_back("]"); }
+  bool Key(absl::string_view key) override {
+    events_.push_back(absl::StrCat("key:", key));
+    return true;
+  }
+  void String(absl::string_view value) override {
+    events_.push_back(absl::StrCat("string:", value));
+  }
+  void Number(absl::string_view value) override {
+    events_.push_back(absl::StrCat("number:", value));
+  }
+  void Bool(bool value) override {
+    events_.push_back(value ? "true" : "false");
+  }
+  void Null() override { events_.push_back("null"); }
+
+  const std::vector<std::string>& events() const { return events_; }
+
+ private:
+  std::vector<std::string> events_;
+};
+
+TEST(Json, Events) {
+  EventRecorder recorder;
+  grpc_error_handle error = Json::Parse(
+      "{\"a\\tb\": [1, -2.5e3, \"x,y }\", \"\\u00e9\"], \"b\": {},"
+      " \"c\": [true, false, null], \"b\": 0}",
+      &recorder);
+  EXPECT_EQ(error, GRPC_ERROR_NONE) << grpc_error_std_string(error);
+  EXPECT_THAT(recorder.events(),
+              ::testing::ElementsAre(
+                  "{", "key:a\tb", "[", "number:1", "number:-2.5e3",
+                  "string:x,y }", "string:\xc3\xa9", "]", "key:b", "{", "}",
+                  "key:c", "[", "true", "false", "null", "]", "key:b",
+                  "number:0", "}"));
+  GRPC_ERROR_UNREF(error);
+}
+
+TEST(Json, EventsStopAtSyntaxError) {
+  EventRecorder recorder;
+  grpc_error_handle error = Json::Parse("[\"a\", 1 2]", &recorder);
+  EXPECT_NE(error, GRPC_ERROR_NONE);
+  EXPECT_THAT(recorder.events(),
+              ::testing::ElementsAre("[", "string:a", "number:1"));
+  GRPC_ERROR_UNREF(error);
+}
+
 }  // namespace grpc_core
 
 int main(int argc, char** argv) {
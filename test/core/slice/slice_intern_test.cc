@@ -21,12 +21,16 @@
 #include <inttypes.h>
 #include <string.h>
 
+#include <string>
+#include <vector>
+
 #include <grpc/grpc.h>
 #include <grpc/slice.h>
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 
 #include "src/core/lib/gprpp/memory.h"
+#include "src/core/lib/gprpp/thd.h"
 #include "src/core/lib/slice/slice_internal.h"
 #include "src/core/lib/transport/static_metadata.h"
 #include "test/core/util/test_config.h"
@@ -90,12 +94,74 @@ static void test_static_slice_copy_interning(void) {
   grpc_shutdown();
 }
 
+namespace {
+
+constexpr int kNumInternThreads = 8;
+constexpr int kNumInternStrings = 512;
+constexpr int kNumInternIterations = 50;
+
+struct InternThreadArgs {
+  const std::vector<std::string>* strings;
+  const std::vector<grpc_slice>* held;
+  int index;
+};
+
+void intern_thread_body(void* arg) {
+  InternThreadArgs* args = static_cast<InternThreadArgs*>(arg);
+  const std::vector<std::string>& strings = *args->strings;
+  std::vector<grpc_slice> interned(kNumInternStrings);
+  for (int n = 0; n < kNumInternIterations; n++) {
+    for (int i = 0; i < kNumInternStrings; i++) {
+      // Intern in a different order on each thread.
+      int j = (i * (2 * args->index + 1)) % kNumInternStrings;
+      interned[j] = grpc_slice_intern(
+          grpc_slice_from_static_buffer(strings[j].data(), strings[j].size()));
+      GPR_ASSERT(grpc_slice_str_cmp(interned[j], strings[j].c_str()) == 0);
+      if (j % 2 == 0) {
+        GPR_ASSERT(interned[j].refcount == (*args->held)[j / 2].refcount);
+      }
+    }
+    for (grpc_slice& slice : interned) grpc_slice_unref(slice);
+  }
+}
+
+}  // namespace
+
+// Threads concurrently intern and release strings, half of which the main
+// thread keeps interned throughout, while the table grows and slices are added
+// to and removed from it.
+static void test_concurrent_slice_interning(void) {
+  LOG_TEST_NAME("test_concurrent_slice_interning");
+
+  grpc_init();
+  std::vector<std::string> strings;
+  std::vector<grpc_slice> held;
+  for (int i = 0; i < kNumInternStrings; i++) {
+    strings.push_back("concurrently-interned-" + std::to_string(i));
+    if (i % 2 == 0) {
+      held.push_back(grpc_slice_intern(
+          grpc_slice_from_static_buffer(strings[i].data(), strings[i].size())));
+    }
+  }
+  InternThreadArgs args[kNumInternThreads];
+  std::vector<grpc_core::Thread> threads;
+  for (int t = 0; t < kNumInternThreads; t++) {
+    args[t] = {&strings, &held, t};
+    threads.emplace_back("grpc_intern_test", intern_thread_body, &args[t]);
+  }
+  for (grpc_core::Thread& thd : threads) thd.Start();
+  for (grpc_core::Thread& thd : threads) thd.Join();
+  for (grpc_slice& slice : held) grpc_slice_unref(slice);
+  grpc_shutdown();
+}
+
 int main(int argc, char** argv) {
   grpc::testing::TestEnvironment env(argc, argv);
   grpc_init();
   test_slice_interning();
   test_static_slice_interning();
   test_static_slice_copy_interning();
+  test_concurrent_slice_interning();
   grpc_shutdown();
   return 0;
 }
@@ -295,6 +295,11 @@ int main(int argc, char** argv) {
   test_threading(1, 10);
   test_threading(10, 1);
   test_threading(10, 10);
+  grpc_cq_set_next_shards(4);
+  test_threading(1, 10);
+  test_threading(10, 1);
+  test_threading(10, 10);
+  grpc_cq_set_next_shards(1);
   grpc_shutdown();
   return 0;
 }
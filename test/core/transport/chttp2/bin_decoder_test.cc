@@ -89,6 +89,41 @@ static size_t base64_infer_length(const char* s) {
   EXPECT_SLICE_EQ(           \
       s, grpc_chttp2_base64_decode_with_length(base64_encode(s), strlen(s)));
 
+// Round trips binary data of every length up to max_length, which covers both
+// the bulk and the tail paths of the decoder.
+static void expect_round_trips(size_t max_length) {
+  for (size_t length = 0; length <= max_length; length++) {
+    grpc_slice raw = GRPC_SLICE_MALLOC(length);
+    for (size_t i = 0; i < length; i++) {
+      GRPC_SLICE_START_PTR(raw)[i] = static_cast<uint8_t>(i * 97 + length);
+    }
+    grpc_slice encoded = grpc_chttp2_base64_encode(raw);
+    expect_slice_eq(grpc_slice_ref_internal(raw),
+                    grpc_chttp2_base64_decode_with_length(encoded, length),
+                    "round trip", __LINE__);
+    grpc_slice_unref_internal(encoded);
+    grpc_slice_unref_internal(raw);
+  }
+}
+
+// Replaces each character of a long encoded string in turn with an illegal
+// one, and checks that decoding fails wherever it lands.
+static void expect_illegal_chars_detected(size_t length) {
+  grpc_slice raw = GRPC_SLICE_MALLOC(length);
+  memset(GRPC_SLICE_START_PTR(raw), 'x', length);
+  grpc_slice encoded = grpc_chttp2_base64_encode(raw);
+  for (size_t i = 0; i < GRPC_SLICE_LENGTH(encoded); i++) {
+    grpc_slice corrupt = grpc_slice_copy(encoded);
+    GRPC_SLICE_START_PTR(corrupt)[i] = ':';
+    expect_slice_eq(grpc_empty_slice(),
+                    grpc_chttp2_base64_decode_with_length(corrupt, length),
+                    "illegal char", __LINE__);
+    grpc_slice_unref_internal(corrupt);
+  }
+  grpc_slice_unref_internal(encoded);
+  grpc_slice_unref_internal(raw);
+}
+
 int main(int argc, char** argv) {
   grpc::testing::TestEnvironment env(argc, argv);
   grpc_init();
@@ -165,6 +200,9 @@ int main(int argc, char** argv) {
     EXPECT_DECODED_LENGTH("a===", 0);
     EXPECT_DECODED_LENGTH("abcde", 0);
     EXPECT_DECODED_LENGTH("abcde===", 0);
+
+    expect_round_trips(100);
+    expect_illegal_chars_detected(48);
   }
   grpc_shutdown();
   return all_ok ? 0 : 1;
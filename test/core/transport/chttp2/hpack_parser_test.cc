@@ -19,13 +19,18 @@
 #include "src/core/ext/transport/chttp2/transport/hpack_parser.h"
 
 #include <stdarg.h>
+#include <string.h>
+
+#include <string>
 
 #include <grpc/grpc.h>
 #include <grpc/slice.h>
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 
+#include "src/core/ext/transport/chttp2/transport/bin_encoder.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/slice/slice_internal.h"
 #include "test/core/util/parse_hexstring.h"
 #include "test/core/util/slice_splitter.h"
 #include "test/core/util/test_config.h"
@@ -48,10 +53,9 @@ struct TestChecker {
   }
 };
 
-static void test_vector(grpc_core::HPackParser* parser,
-                        grpc_slice_split_mode mode, const char* hexstring,
-                        MDVec expect) {
-  grpc_slice input = parse_hexstring(hexstring);
+static void test_input(grpc_core::HPackParser* parser,
+                       grpc_slice_split_mode mode, grpc_slice input,
+                       MDVec expect) {
   grpc_slice* slices;
   size_t nslices;
   size_t i;
@@ -81,6 +85,73 @@ static void test_vector(grpc_core::HPackParser* parser,
   GPR_ASSERT(expect.empty());
 }
 
+static void test_vector(grpc_core::HPackParser* parser,
+                        grpc_slice_split_mode mode, const char* hexstring,
+                        MDVec expect) {
+  test_input(parser, mode, parse_hexstring(hexstring), std::move(expect));
+}
+
+// Appends an HPACK integer with the given prefix bits already in first.
+static void append_int(std::string* out, uint8_t first, int prefix_bits,
+                       size_t value) {
+  const size_t max_prefix = (1u << prefix_bits) - 1;
+  if (value < max_prefix) {
+    out->push_back(static_cast<char>(first | value));
+    return;
+  }
+  out->push_back(static_cast<char>(first | max_prefix));
+  value -= max_prefix;
+  while (value >= 128) {
+    out->push_back(static_cast<char>(0x80 | (value & 0x7f)));
+    value >>= 7;
+  }
+  out->push_back(static_cast<char>(value));
+}
+
+// Encodes value with grpc_chttp2_huffman_compress() as a literal header
+// (without indexing) and checks that the parser decodes it back.
+static void test_huffman_value(grpc_slice_split_mode mode, const char* key,
+                               const std::string& value) {
+  grpc_slice raw = grpc_slice_from_cpp_string(value);
+  grpc_slice huff = grpc_chttp2_huffman_compress(raw);
+  std::string frame;
+  append_int(&frame, 0x00, 4, 0);
+  append_int(&frame, 0x00, 7, strlen(key));
+  frame.append(key);
+  append_int(&frame, 0x80, 7, GRPC_SLICE_LENGTH(huff));
+  frame.append(reinterpret_cast<const char*>(GRPC_SLICE_START_PTR(huff)),
+               GRPC_SLICE_LENGTH(huff));
+  grpc_slice_unref(raw);
+  grpc_slice_unref(huff);
+  grpc_core::HPackParser parser;
+  test_input(&parser, mode, grpc_slice_from_cpp_string(std::move(frame)),
+             {std::make_pair(key, value.c_str())});
+}
+
+static void test_huffman(grpc_slice_split_mode mode) {
+  grpc_core::ExecCtx exec_ctx;
+  // Every non-NUL byte, so both short and long codes are exercised.
+  std::string all_bytes;
+  for (int c = 1; c < 256; c++) all_bytes.push_back(static_cast<char>(c));
+  test_huffman_value(mode, "all-bytes", all_bytes);
+  // Every suffix of a string exercises all end-of-string padding lengths.
+  const std::string text = "Bearer eyJhbGciOiJSUzI1NiIsInR5cCI6IkpXVCJ9";
+  for (size_t i = 0; i < text.size(); i++) {
+    test_huffman_value(mode, "authorization", text.substr(i));
+  }
+  // A long token-like value made of pseudo-random printable characters and
+  // the odd long code.
+  std::string token;
+  uint32_t x = 1;
+  for (int i = 0; i < 4096; i++) {
+    x = x * 1103515245 + 12345;
+    uint8_t c = static_cast<uint8_t>(0x20 + (x >> 16) % 95);
+    if ((x >> 8) % 61 == 0) c = static_cast<uint8_t>(0x80 + (x >> 20) % 128);
+    token.push_back(static_cast<char>(c));
+  }
+  test_huffman_value(mode, "x-token", token);
+}
+
 static void test_vectors(grpc_slice_split_mode mode) {
   grpc_core::ExecCtx exec_ctx;
 
@@ -258,6 +329,8 @@ int main(int argc, char** argv) {
   grpc_init();
   test_vectors(GRPC_SLICE_SPLIT_MERGE_ALL);
   test_vectors(GRPC_SLICE_SPLIT_ONE_BYTE);
+  test_huffman(GRPC_SLICE_SPLIT_MERGE_ALL);
+  test_huffman(GRPC_SLICE_SPLIT_ONE_BYTE);
   grpc_shutdown();
   return 0;
 }
@@ -167,6 +167,48 @@ static void test_periodic_compaction(uint32_t n) {
   grpc_chttp2_stream_map_destroy(&map);
 }
 
+/* delete every entry from inside for_each, as end_all_the_calls does, and make
+   sure each one is still visited once, in order */
+static void delete_in_for_each(void* user_data, uint32_t stream_id,
+                               void* ptr) {
+  grpc_chttp2_stream_map* map = static_cast<grpc_chttp2_stream_map*>(user_data);
+  GPR_ASSERT((void*)(uintptr_t)stream_id == ptr);
+  GPR_ASSERT(ptr == grpc_chttp2_stream_map_delete(map, stream_id));
+}
+
+static void count_for_each(void* user_data, uint32_t /*stream_id*/,
+                           void* /*ptr*/) {
+  ++*static_cast<uint32_t*>(user_data);
+}
+
+static void test_delete_during_for_each(uint32_t n) {
+  grpc_chttp2_stream_map map;
+  uint32_t i;
+  uint32_t visited = 0;
+
+  LOG_TEST("test_delete_during_for_each");
+  gpr_log(GPR_INFO, "n = %d", n);
+
+  grpc_chttp2_stream_map_init(&map, 8);
+  for (i = 1; i <= n; i++) {
+    grpc_chttp2_stream_map_add(&map, 2 * i + 1,
+                               reinterpret_cast<void*>(2 * i + 1));
+  }
+  grpc_chttp2_stream_map_for_each(&map, delete_in_for_each, &map);
+  GPR_ASSERT(0 == grpc_chttp2_stream_map_size(&map));
+  grpc_chttp2_stream_map_for_each(&map, count_for_each, &visited);
+  GPR_ASSERT(0 == visited);
+  /* the emptied map is reusable */
+  for (i = 1; i <= n; i++) {
+    uint32_t key = 2 * (n + i) + 1;
+    GPR_ASSERT(nullptr == grpc_chttp2_stream_map_find(&map, 2 * i + 1));
+    grpc_chttp2_stream_map_add(&map, key, reinterpret_cast<void*>(key));
+    GPR_ASSERT((void*)(uintptr_t)key == grpc_chttp2_stream_map_find(&map, key));
+  }
+  GPR_ASSERT(n == grpc_chttp2_stream_map_size(&map));
+  grpc_chttp2_stream_map_destroy(&map);
+}
+
 int main(int argc, char** argv) {
   uint32_t n = 1;
   uint32_t prev = 1;
@@ -182,6 +224,7 @@ int main(int argc, char** argv) {
     test_delete_evens_sweep(n);
     test_delete_evens_incremental(n);
     test_periodic_compaction(n);
+    test_delete_during_for_each(n);
 
     tmp = n;
     n += prev;
@@ -0,0 +1,311 @@
+/*
+ *
+ * Copyright 2021 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <grpc/support/port_platform.h>
+
+#include <string.h>
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "absl/synchronization/mutex.h"
+
+#include <grpc/byte_buffer.h>
+#include <grpc/grpc.h>
+#include <grpc/impl/codegen/grpc_types.h>
+#include <grpc/slice.h>
+#include <grpc/support/log.h>
+#include <grpc/support/time.h>
+
+#include "src/core/ext/transport/chttp2/transport/chttp2_transport.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/gprpp/host_port.h"
+#include "test/core/end2end/cq_verifier.h"
+#include "test/core/util/port.h"
+#include "test/core/util/test_config.h"
+
+namespace {
+
+void* tag(intptr_t t) { return reinterpret_cast<void*>(t); }
+
+class TransportCounter {
+ public:
+  static void CounterInitCallback() {
+    absl::MutexLock lock(&mu());
+    ++count_;
+  }
+
+  static void CounterDestructCallback() {
+    absl::MutexLock lock(&mu());
+    if (--count_ == 0) {
+      cv().SignalAll();
+    }
+  }
+
+  static void WaitForTransportsToBeDestroyed() {
+    absl::MutexLock lock(&mu());
+    while (count_ != 0) {
+      ASSERT_FALSE(cv().WaitWithTimeout(&mu(), absl::Seconds(10)));
+    }
+  }
+
+  static absl::Mutex& mu() {
+    static absl::Mutex* mu = new absl::Mutex();
+    return *mu;
+  }
+
+  static absl::CondVar& cv() {
+    static absl::CondVar* cv = new absl::CondVar();
+    return *cv;
+  }
+
+ private:
+  static int count_;
+};
+
+int TransportCounter::count_ = 0;
+
+// Opens two calls from a client to a server that holds writes back for
+// coalescing. With two open streams and a recent write (its settings), the
+// server transport holds the next write of stream data.
+class WriteCoalescingTest : public ::testing::Test {
+ protected:
+  static constexpr int kNumCalls = 2;
+  // Long enough that a write held until the timer fires fails the test.
+  static constexpr int kLongDelayMs = 60000;
+
+  void SetUp() override {
+    cq_ = grpc_completion_queue_create_for_next(nullptr);
+    cqv_ = cq_verifier_create(cq_);
+  }
+
+  void TearDown() override {
+    for (int i = 0; i < kNumCalls; i++) {
+      if (client_calls_[i] != nullptr) {
+        grpc_call_cancel(client_calls_[i], nullptr);
+        grpc_call_unref(client_calls_[i]);
+      }
+      if (server_calls_[i] != nullptr) grpc_call_unref(server_calls_[i]);
+      grpc_metadata_array_destroy(&initial_metadata_recv_[i]);
+      grpc_byte_buffer_destroy(message_recv_[i]);
+    }
+    if (client_ != nullptr) grpc_channel_destroy(client_);
+    if (server_ != nullptr) {
+      grpc_server_shutdown_and_notify(server_, cq_, tag(1000));
+      grpc_server_cancel_all_calls(server_);
+      grpc_event ev;
+      do {
+        ev = grpc_completion_queue_next(
+            cq_, grpc_timeout_seconds_to_deadline(5), nullptr);
+        GPR_ASSERT(ev.type == GRPC_OP_COMPLETE);
+      } while (ev.tag != tag(1000));
+      grpc_server_destroy(server_);
+    }
+    cq_verifier_destroy(cqv_);
+    grpc_completion_queue_shutdown(cq_);
+    while (grpc_completion_queue_next(cq_, gpr_inf_future(GPR_CLOCK_REALTIME),
+                                      nullptr)
+               .type != GRPC_QUEUE_SHUTDOWN) {
+    }
+    grpc_completion_queue_destroy(cq_);
+  }
+
+  // Starts the server, holding writes for up to delay_ms, and opens the
+  // calls.
+  void Start(int delay_ms, int target_write_size) {
+    std::vector<grpc_arg> args;
+    args.push_back(grpc_channel_arg_integer_create(
+        const_cast<char*>(GRPC_ARG_HTTP2_BDP_PROBE), 0));
+    // Lets the client close its connection once the channel is destroyed.
+    args.push_back(grpc_channel_arg_integer_create(
+        const_cast<char*>(GRPC_ARG_USE_LOCAL_SUBCHANNEL_POOL), 1));
+    grpc_channel_args* client_args =
+        grpc_channel_args_copy_and_add(nullptr, args.data(), args.size());
+    args.push_back(grpc_channel_arg_integer_create(
+        const_cast<char*>(GRPC_ARG_HTTP2_WRITE_COALESCING_DELAY_MS),
+        delay_ms));
+    if (target_write_size > 0) {
+      args.push_back(grpc_channel_arg_integer_create(
+          const_cast<char*>(GRPC_ARG_HTTP2_TARGET_WRITE_SIZE),
+          target_write_size));
+    }
+    grpc_channel_args* server_args =
+        grpc_channel_args_copy_and_add(nullptr, args.data(), args.size());
+    std::string address =
+        grpc_core::JoinHostPort("localhost", grpc_pick_unused_port_or_die());
+    server_ = grpc_server_create(server_args, nullptr);
+    grpc_server_register_completion_queue(server_, cq_, nullptr);
+    GPR_ASSERT(grpc_server_add_insecure_http2_port(server_, address.c_str()));
+    grpc_server_start(server_);
+    client_ = grpc_insecure_channel_create(address.c_str(), client_args,
+                                           nullptr);
+    grpc_channel_args_destroy(client_args);
+    grpc_channel_args_destroy(server_args);
+    for (int i = 0; i < kNumCalls; i++) {
+      grpc_call_details call_details;
+      grpc_call_details_init(&call_details);
+      grpc_metadata_array request_metadata_recv;
+      grpc_metadata_array_init(&request_metadata_recv);
+      GPR_ASSERT(GRPC_CALL_OK ==
+                 grpc_server_request_call(server_, &server_calls_[i],
+                                          &call_details,
+                                          &request_metadata_recv, cq_, cq_,
+                                          tag(200 + i)));
+      client_calls_[i] = grpc_channel_create_call(
+          client_, nullptr, GRPC_PROPAGATE_DEFAULTS, cq_,
+          grpc_slice_from_static_string("/foo"), nullptr,
+          gpr_inf_future(GPR_CLOCK_REALTIME), nullptr);
+      grpc_op op;
+      memset(&op, 0, sizeof(op));
+      op.op = GRPC_OP_SEND_INITIAL_METADATA;
+      op.flags = GRPC_INITIAL_METADATA_WAIT_FOR_READY;
+      GPR_ASSERT(GRPC_CALL_OK == grpc_call_start_batch(client_calls_[i], &op,
+                                                       1, tag(100 + i),
+                                                       nullptr));
+      CQ_EXPECT_COMPLETION(cqv_, tag(100 + i), true);
+      CQ_EXPECT_COMPLETION(cqv_, tag(200 + i), true);
+      cq_verify(cqv_);
+      grpc_call_details_destroy(&call_details);
+      grpc_metadata_array_destroy(&request_metadata_recv);
+    }
+  }
+
+  // Sends initial metadata and a message of length bytes on server call i.
+  // The batch completes with tag 300 + i.
+  void SendMessage(int i, size_t length) {
+    grpc_slice payload = grpc_slice_malloc(length);
+    memset(GRPC_SLICE_START_PTR(payload), 'a', length);
+    grpc_byte_buffer* message = grpc_raw_byte_buffer_create(&payload, 1);
+    grpc_op ops[2];
+    memset(ops, 0, sizeof(ops));
+    ops[0].op = GRPC_OP_SEND_INITIAL_METADATA;
+    ops[1].op = GRPC_OP_SEND_MESSAGE;
+    ops[1].data.send_message.send_message = message;
+    GPR_ASSERT(GRPC_CALL_OK == grpc_call_start_batch(server_calls_[i], ops, 2,
+                                                     tag(300 + i), nullptr));
+    grpc_byte_buffer_destroy(message);
+    grpc_slice_unref(payload);
+  }
+
+  // Receives initial metadata and a message on client call i. The batch
+  // completes with tag 400 + i.
+  void RecvMessage(int i) {
+    grpc_op ops[2];
+    memset(ops, 0, sizeof(ops));
+    ops[0].op = GRPC_OP_RECV_INITIAL_METADATA;
+    ops[0].data.recv_initial_metadata.recv_initial_metadata =
+        &initial_metadata_recv_[i];
+    ops[1].op = GRPC_OP_RECV_MESSAGE;
+    ops[1].data.recv_message.recv_message = &message_recv_[i];
+    GPR_ASSERT(GRPC_CALL_OK == grpc_call_start_batch(client_calls_[i], ops, 2,
+                                                     tag(400 + i), nullptr));
+  }
+
+  grpc_completion_queue* cq_ = nullptr;
+  cq_verifier* cqv_ = nullptr;
+  grpc_server* server_ = nullptr;
+  grpc_channel* client_ = nullptr;
+  grpc_call* client_calls_[kNumCalls] = {};
+  grpc_call* server_calls_[kNumCalls] = {};
+  grpc_metadata_array initial_metadata_recv_[kNumCalls] = {};
+  grpc_byte_buffer* message_recv_[kNumCalls] = {};
+};
+
+TEST_F(WriteCoalescingTest, HoldsWriteUntilTimerFires) {
+  Start(static_cast<int>(3000 * grpc_test_slowdown_factor()), 0);
+  RecvMessage(0);
+  SendMessage(0, 10);
+  cq_verify_empty_timeout(cqv_, 1);
+  CQ_EXPECT_COMPLETION(cqv_, tag(300), true);
+  CQ_EXPECT_COMPLETION(cqv_, tag(400), true);
+  cq_verify(cqv_);
+  ASSERT_NE(message_recv_[0], nullptr);
+  EXPECT_EQ(grpc_byte_buffer_length(message_recv_[0]), 10u);
+}
+
+TEST_F(WriteCoalescingTest, FlushesHeldWriteAtTargetWriteSize) {
+  Start(kLongDelayMs, 1024);
+  RecvMessage(0);
+  RecvMessage(1);
+  SendMessage(0, 10);
+  cq_verify_empty_timeout(cqv_, 1);
+  // Joins the held write, which now has more than 1024 bytes to send.
+  SendMessage(1, 2048);
+  CQ_EXPECT_COMPLETION(cqv_, tag(300), true);
+  CQ_EXPECT_COMPLETION(cqv_, tag(301), true);
+  CQ_EXPECT_COMPLETION(cqv_, tag(400), true);
+  CQ_EXPECT_COMPLETION(cqv_, tag(401), true);
+  cq_verify(cqv_);
+  ASSERT_NE(message_recv_[0], nullptr);
+  EXPECT_EQ(grpc_byte_buffer_length(message_recv_[0]), 10u);
+  ASSERT_NE(message_recv_[1], nullptr);
+  EXPECT_EQ(grpc_byte_buffer_length(message_recv_[1]), 2048u);
+}
+
+TEST_F(WriteCoalescingTest, DoesNotHoldWriteOfTargetWriteSize) {
+  Start(kLongDelayMs, 1024);
+  RecvMessage(0);
+  SendMessage(0, 2048);
+  CQ_EXPECT_COMPLETION(cqv_, tag(300), true);
+  CQ_EXPECT_COMPLETION(cqv_, tag(400), true);
+  cq_verify(cqv_);
+  ASSERT_NE(message_recv_[0], nullptr);
+  EXPECT_EQ(grpc_byte_buffer_length(message_recv_[0]), 2048u);
+}
+
+TEST_F(WriteCoalescingTest, CancelsHeldWriteOnClose) {
+  Start(kLongDelayMs, 0);
+  RecvMessage(0);
+  SendMessage(0, 10);
+  cq_verify_empty_timeout(cqv_, 1);
+  // The client cancels its calls and hangs up, closing the server transport
+  // while it holds a write with no streams left to send it for. The held
+  // write must not keep the transport alive until the timer fires.
+  for (int i = 0; i < kNumCalls; i++) {
+    grpc_call_cancel(client_calls_[i], nullptr);
+    grpc_call_unref(client_calls_[i]);
+    client_calls_[i] = nullptr;
+  }
+  grpc_channel_destroy(client_);
+  client_ = nullptr;
+  CQ_EXPECT_COMPLETION(cqv_, tag(300), false);
+  CQ_EXPECT_COMPLETION_ANY_STATUS(cqv_, tag(400));
+  cq_verify(cqv_);
+  for (int i = 0; i < kNumCalls; i++) {
+    grpc_call_unref(server_calls_[i]);
+    server_calls_[i] = nullptr;
+  }
+  TransportCounter::WaitForTransportsToBeDestroyed();
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc_core::TestOnlySetGlobalHttp2TransportInitCallback(
+      TransportCounter::CounterInitCallback);
+  grpc_core::TestOnlySetGlobalHttp2TransportDestructCallback(
+      TransportCounter::CounterDestructCallback);
+  grpc_init();
+  int result = RUN_ALL_TESTS();
+  grpc_shutdown();
+  return result;
+}
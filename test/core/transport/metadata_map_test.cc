@@ -57,6 +57,14 @@ class FakeEncoder {
     output_ += absl::StrCat("grpc-timeout: deadline=", deadline, "\n");
   }
 
+  void Encode(TeMetadata, TeMetadata::ValueType te) {
+    output_ += absl::StrCat("te: ", te, "\n");
+  }
+
+  void Encode(ContentTypeMetadata, ContentTypeMetadata::ValueType type) {
+    output_ += absl::StrCat("content-type: ", type, "\n");
+  }
+
  private:
   std::string output_;
 };
@@ -76,6 +84,59 @@ TEST(MetadataMapTest, TimeoutEncodeTest) {
   EXPECT_EQ(encoder.output(), "grpc-timeout: deadline=1234\n");
 }
 
+TEST(MetadataMapTest, KnownHeadersEncodeTest) {
+  FakeEncoder encoder;
+  grpc_metadata_batch map;
+  map.Set(ContentTypeMetadata(), ContentTypeMetadata::kApplicationGrpc);
+  map.Set(TeMetadata(), TeMetadata::kTrailers);
+  map.Set(GrpcTimeoutMetadata(), 1234);
+  EXPECT_EQ(map.count(), 3u);
+  map.Encode(&encoder);
+  EXPECT_EQ(encoder.output(),
+            absl::StrCat("grpc-timeout: deadline=1234\n", "te: ",
+                         TeMetadata::kTrailers, "\n", "content-type: ",
+                         ContentTypeMetadata::kApplicationGrpc, "\n"));
+}
+
+TEST(MetadataMapTest, CopyKnownMetadataTest) {
+  grpc_metadata_batch src;
+  src.Set(TeMetadata(), TeMetadata::kTrailers);
+  grpc_metadata_batch dst;
+  dst.Set(ContentTypeMetadata(), ContentTypeMetadata::kApplicationGrpc);
+  dst.CopyKnownMetadataFrom(src);
+  EXPECT_EQ(dst.get(TeMetadata()), TeMetadata::kTrailers);
+  EXPECT_EQ(dst.get(ContentTypeMetadata()), absl::nullopt);
+}
+
+TEST(MetadataMapTest, ParseTe) {
+  EXPECT_EQ(TeMetadata::Parse(grpc_slice_from_static_string("trailers")),
+            TeMetadata::kTrailers);
+  EXPECT_EQ(TeMetadata::Parse(grpc_slice_from_static_string("")),
+            TeMetadata::kInvalid);
+  EXPECT_EQ(TeMetadata::Parse(grpc_slice_from_static_string("gzip")),
+            TeMetadata::kInvalid);
+}
+
+TEST(MetadataMapTest, ParseContentType) {
+  EXPECT_EQ(ContentTypeMetadata::Parse(
+                grpc_slice_from_static_string("application/grpc")),
+            ContentTypeMetadata::kApplicationGrpc);
+  EXPECT_EQ(ContentTypeMetadata::Parse(
+                grpc_slice_from_static_string("application/grpc+proto")),
+            ContentTypeMetadata::kApplicationGrpc);
+  EXPECT_EQ(ContentTypeMetadata::Parse(
+                grpc_slice_from_static_string("application/grpc;charset=x")),
+            ContentTypeMetadata::kApplicationGrpc);
+  EXPECT_EQ(ContentTypeMetadata::Parse(grpc_slice_from_static_string("")),
+            ContentTypeMetadata::kEmpty);
+  EXPECT_EQ(ContentTypeMetadata::Parse(
+                grpc_slice_from_static_string("application/grpcx")),
+            ContentTypeMetadata::kInvalid);
+  EXPECT_EQ(
+      ContentTypeMetadata::Parse(grpc_slice_from_static_string("text/html")),
+      ContentTypeMetadata::kInvalid);
+}
+
 }  // namespace testing
 }  // namespace grpc_core
 
@@ -22,7 +22,11 @@
 #include <stdio.h>
 #include <string.h>
 
+#include <algorithm>
+#include <string>
+
 #include <grpc/grpc.h>
+#include <grpc/slice_buffer.h>
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 #include <grpc/support/string_util.h>
@@ -30,6 +34,7 @@
 #include "src/core/lib/iomgr/load_file.h"
 #include "src/core/lib/security/security_connector/security_connector.h"
 #include "src/core/tsi/transport_security.h"
+#include "src/core/tsi/transport_security_grpc.h"
 #include "src/core/tsi/transport_security_interface.h"
 #include "test/core/tsi/transport_security_test_lib.h"
 #include "test/core/util/test_config.h"
@@ -37,7 +42,9 @@
 extern "C" {
 #include <openssl/crypto.h>
 #include <openssl/err.h>
+#include <openssl/evp.h>
 #include <openssl/pem.h>
+#include <openssl/ssl.h>
 }
 
 #define SSL_TSI_TEST_ALPN1 "foo"
@@ -102,6 +109,7 @@ typedef struct ssl_tsi_test_fixture {
   size_t session_ticket_key_size;
   tsi_ssl_server_handshaker_factory* server_handshaker_factory;
   tsi_ssl_client_handshaker_factory* client_handshaker_factory;
+  bool track_write_traffic;
 } ssl_tsi_test_fixture;
 
 static void ssl_test_setup_handshakers(tsi_test_fixture* fixture) {
@@ -179,6 +187,10 @@ static void ssl_test_setup_handshakers(tsi_test_fixture* fixture) {
   GPR_ASSERT(tsi_ssl_server_handshaker_factory_create_handshaker(
                  ssl_fixture->server_handshaker_factory,
                  &ssl_fixture->base.server_handshaker) == TSI_OK);
+  if (ssl_fixture->track_write_traffic) {
+    tsi_ssl_handshaker_track_write_traffic(ssl_fixture->base.client_handshaker);
+    tsi_ssl_handshaker_track_write_traffic(ssl_fixture->base.server_handshaker);
+  }
 }
 
 static void check_alpn(ssl_tsi_test_fixture* ssl_fixture,
@@ -520,6 +532,7 @@ static tsi_test_fixture* ssl_tsi_test_fixture_create() {
   ssl_fixture->session_ticket_key = nullptr;
   ssl_fixture->session_ticket_key_size = 0;
   ssl_fixture->force_client_auth = false;
+  ssl_fixture->track_write_traffic = false;
   return &ssl_fixture->base;
 }
 
@@ -1018,6 +1031,270 @@ void ssl_tsi_test_extract_cert_chain() {
   sk_X509_pop_free(cert_chain, X509_free);
 }
 
+// Seals message into the next application data record the owner of keys
+// writes, the way the kernel does once the keys are handed to it. Returns the
+// size of the record.
+static size_t ssl_test_seal_record(const tsi_ssl_write_traffic_keys& keys,
+                                   const unsigned char* message,
+                                   size_t message_size, unsigned char* record) {
+  const size_t kHeaderSize = 5;
+  const size_t kTagSize = 16;
+  // The explicit part of the nonce goes ahead of the ciphertext.
+  size_t payload_size = sizeof(keys.iv) + message_size + kTagSize;
+  record[0] = SSL3_RT_APPLICATION_DATA;
+  record[1] = 3;
+  record[2] = 3;
+  record[3] = static_cast<unsigned char>(payload_size >> 8);
+  record[4] = static_cast<unsigned char>(payload_size);
+  memcpy(record + kHeaderSize, keys.iv, sizeof(keys.iv));
+  unsigned char nonce[12];
+  memcpy(nonce, keys.salt, sizeof(keys.salt));
+  memcpy(nonce + sizeof(keys.salt), keys.iv, sizeof(keys.iv));
+  unsigned char aad[13];
+  memcpy(aad, keys.record_sequence, sizeof(keys.record_sequence));
+  memcpy(aad + 8, record, 3);
+  aad[11] = static_cast<unsigned char>(message_size >> 8);
+  aad[12] = static_cast<unsigned char>(message_size);
+  unsigned char* out = record + kHeaderSize + sizeof(keys.iv);
+  int len;
+  EVP_CIPHER_CTX* ctx = EVP_CIPHER_CTX_new();
+  GPR_ASSERT(ctx != nullptr);
+  GPR_ASSERT(EVP_EncryptInit_ex(
+      ctx, keys.key_size == 16 ? EVP_aes_128_gcm() : EVP_aes_256_gcm(),
+      nullptr, keys.key, nonce));
+  GPR_ASSERT(EVP_EncryptUpdate(ctx, nullptr, &len, aad, sizeof(aad)));
+  GPR_ASSERT(EVP_EncryptUpdate(ctx, out, &len, message, message_size));
+  GPR_ASSERT(EVP_EncryptFinal_ex(ctx, out + message_size, &len));
+  GPR_ASSERT(EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_GCM_GET_TAG, kTagSize,
+                                 out + message_size));
+  EVP_CIPHER_CTX_free(ctx);
+  return kHeaderSize + payload_size;
+}
+
+void ssl_tsi_test_write_traffic_keys() {
+  gpr_log(GPR_INFO, "ssl_tsi_test_write_traffic_keys");
+  tsi_test_fixture* fixture = ssl_tsi_test_fixture_create();
+  ssl_tsi_test_fixture* ssl_fixture =
+      reinterpret_cast<ssl_tsi_test_fixture*>(fixture);
+  ssl_fixture->track_write_traffic = true;
+  fixture->test_unused_bytes = false;
+  tsi_test_do_handshake(fixture);
+  // Both sides have to export their keys before either creates its frame
+  // protector, which takes over the SSL object.
+  tsi_ssl_write_traffic_keys client_keys;
+  tsi_ssl_write_traffic_keys server_keys;
+  tsi_result client_result = tsi_ssl_handshaker_result_get_write_traffic_keys(
+      fixture->client_result, &client_keys);
+  tsi_result server_result = tsi_ssl_handshaker_result_get_write_traffic_keys(
+      fixture->server_result, &server_keys);
+#if !defined(OPENSSL_IS_BORINGSSL) && OPENSSL_VERSION_NUMBER < 0x10100000
+  GPR_ASSERT(client_result == TSI_UNIMPLEMENTED);
+  GPR_ASSERT(server_result == TSI_UNIMPLEMENTED);
+#else
+  if (test_tls_version == tsi_tls_version::TSI_TLS1_3) {
+    // TLS 1.3 traffic keys may be updated at any time, so they are not
+    // exported.
+    GPR_ASSERT(client_result == TSI_UNIMPLEMENTED);
+    GPR_ASSERT(server_result == TSI_UNIMPLEMENTED);
+    tsi_test_fixture_destroy(fixture);
+    return;
+  }
+  GPR_ASSERT(client_result == TSI_OK);
+  GPR_ASSERT(server_result == TSI_OK);
+  GPR_ASSERT(client_keys.tls_version == TLS1_2_VERSION);
+  GPR_ASSERT(server_keys.tls_version == TLS1_2_VERSION);
+  GPR_ASSERT(client_keys.key_size == server_keys.key_size);
+  GPR_ASSERT(memcmp(client_keys.key, server_keys.key, client_keys.key_size) !=
+             0);
+  tsi_test_channel* channel = fixture->channel;
+  const unsigned char kMessage[] = "sealed outside of the frame protector";
+  for (bool client_writes : {true, false}) {
+    const tsi_ssl_write_traffic_keys& keys =
+        client_writes ? client_keys : server_keys;
+    tsi_handshaker_result* reader =
+        client_writes ? fixture->server_result : fixture->client_result;
+    // The peer has to take a record sealed with the exported keys as the one
+    // following everything the handshake wrote.
+    uint8_t* peer_channel =
+        client_writes ? channel->server_channel : channel->client_channel;
+    size_t* bytes_written = client_writes
+                                ? &channel->bytes_written_to_server_channel
+                                : &channel->bytes_written_to_client_channel;
+    GPR_ASSERT(*bytes_written + sizeof(kMessage) + 64 <=
+               TSI_TEST_DEFAULT_CHANNEL_SIZE);
+    *bytes_written += ssl_test_seal_record(keys, kMessage, sizeof(kMessage),
+                                           peer_channel + *bytes_written);
+    tsi_frame_protector* protector = nullptr;
+    GPR_ASSERT(tsi_handshaker_result_create_frame_protector(
+                   reader, nullptr, &protector) == TSI_OK);
+    unsigned char received[sizeof(kMessage)];
+    size_t received_size = 0;
+    tsi_test_frame_protector_receive_message_from_peer(
+        fixture->config, channel, protector, received, &received_size,
+        !client_writes);
+    GPR_ASSERT(received_size == sizeof(kMessage));
+    GPR_ASSERT(memcmp(received, kMessage, sizeof(kMessage)) == 0);
+    tsi_frame_protector_destroy(protector);
+    // The keys can't be exported once the frame protector has the SSL object.
+    tsi_ssl_write_traffic_keys unused_keys;
+    GPR_ASSERT(tsi_ssl_handshaker_result_get_write_traffic_keys(
+                   reader, &unused_keys) == TSI_FAILED_PRECONDITION);
+  }
+#endif
+  tsi_test_fixture_destroy(fixture);
+}
+
+void ssl_tsi_test_write_traffic_keys_not_tracked() {
+  gpr_log(GPR_INFO, "ssl_tsi_test_write_traffic_keys_not_tracked");
+  tsi_test_fixture* fixture = ssl_tsi_test_fixture_create();
+  fixture->test_unused_bytes = false;
+  tsi_test_do_handshake(fixture);
+  // Handshakers that were not asked to track their keys can't export them.
+  tsi_ssl_write_traffic_keys keys;
+  GPR_ASSERT(tsi_ssl_handshaker_result_get_write_traffic_keys(
+                 fixture->client_result, &keys) == TSI_UNIMPLEMENTED);
+  GPR_ASSERT(tsi_ssl_handshaker_result_get_write_traffic_keys(
+                 fixture->server_result, &keys) == TSI_UNIMPLEMENTED);
+  tsi_test_fixture_destroy(fixture);
+}
+
+static std::string ssl_test_slice_buffer_to_string(grpc_slice_buffer* sb) {
+  std::string result;
+  for (size_t i = 0; i < sb->count; i++) {
+    result.append(
+        reinterpret_cast<const char*>(GRPC_SLICE_START_PTR(sb->slices[i])),
+        GRPC_SLICE_LENGTH(sb->slices[i]));
+  }
+  return result;
+}
+
+// Unprotects all of protected_bytes with a (non zero-copy) frame protector.
+static std::string ssl_test_unprotect(tsi_frame_protector* protector,
+                                      const std::string& protected_bytes) {
+  std::string result;
+  unsigned char buffer[1024];
+  const unsigned char* bytes =
+      reinterpret_cast<const unsigned char*>(protected_bytes.data());
+  size_t remaining = protected_bytes.size();
+  size_t buffer_size;
+  do {
+    size_t processed = remaining;
+    buffer_size = sizeof(buffer);
+    GPR_ASSERT(tsi_frame_protector_unprotect(protector, bytes, &processed,
+                                             buffer, &buffer_size) == TSI_OK);
+    result.append(reinterpret_cast<const char*>(buffer), buffer_size);
+    bytes += processed;
+    remaining -= processed;
+  } while (remaining > 0 || buffer_size > 0);
+  return result;
+}
+
+// Protects message with a (non zero-copy) frame protector.
+static std::string ssl_test_protect(tsi_frame_protector* protector,
+                                    const std::string& message) {
+  std::string result;
+  unsigned char buffer[1024];
+  const unsigned char* bytes =
+      reinterpret_cast<const unsigned char*>(message.data());
+  size_t remaining = message.size();
+  while (remaining > 0) {
+    size_t processed = remaining;
+    size_t buffer_size = sizeof(buffer);
+    GPR_ASSERT(tsi_frame_protector_protect(protector, bytes, &processed,
+                                           buffer, &buffer_size) == TSI_OK);
+    result.append(reinterpret_cast<const char*>(buffer), buffer_size);
+    bytes += processed;
+    remaining -= processed;
+  }
+  size_t still_pending;
+  do {
+    size_t buffer_size = sizeof(buffer);
+    GPR_ASSERT(tsi_frame_protector_protect_flush(
+                   protector, buffer, &buffer_size, &still_pending) == TSI_OK);
+    result.append(reinterpret_cast<const char*>(buffer), buffer_size);
+  } while (still_pending > 0);
+  return result;
+}
+
+void ssl_tsi_test_zero_copy_grpc_protector() {
+  gpr_log(GPR_INFO, "ssl_tsi_test_zero_copy_grpc_protector");
+  tsi_test_fixture* fixture = ssl_tsi_test_fixture_create();
+  fixture->test_unused_bytes = false;
+  tsi_test_do_handshake(fixture);
+  // The client protects and unprotects without copying, the server with the
+  // frame protector; both have to agree on the records on the wire.
+  size_t max_frame_size = 4096;
+  tsi_zero_copy_grpc_protector* client_protector = nullptr;
+  GPR_ASSERT(tsi_handshaker_result_create_zero_copy_grpc_protector(
+                 fixture->client_result, &max_frame_size,
+                 &client_protector) == TSI_OK);
+  size_t actual_max_frame_size = 0;
+  GPR_ASSERT(tsi_zero_copy_grpc_protector_max_frame_size(
+                 client_protector, &actual_max_frame_size) == TSI_OK);
+  GPR_ASSERT(actual_max_frame_size == max_frame_size);
+  tsi_frame_protector* server_protector = nullptr;
+  GPR_ASSERT(tsi_handshaker_result_create_frame_protector(
+                 fixture->server_result, nullptr, &server_protector) == TSI_OK);
+  // Slices both smaller and larger than a record.
+  const size_t kSliceSizes[] = {1, 7, 5000, 13, 20000, 1, 4096, 3};
+  std::string message;
+  grpc_slice_buffer unprotected;
+  grpc_slice_buffer protected_slices;
+  grpc_slice_buffer_init(&unprotected);
+  grpc_slice_buffer_init(&protected_slices);
+  for (size_t size : kSliceSizes) {
+    grpc_slice slice = grpc_slice_malloc(size);
+    for (size_t i = 0; i < size; i++) {
+      GRPC_SLICE_START_PTR(slice)[i] =
+          static_cast<uint8_t>('a' + (message.size() + i) % 26);
+    }
+    message.append(reinterpret_cast<const char*>(GRPC_SLICE_START_PTR(slice)),
+                   size);
+    grpc_slice_buffer_add(&unprotected, slice);
+  }
+  // Client to server.
+  GPR_ASSERT(tsi_zero_copy_grpc_protector_protect(
+                 client_protector, &unprotected, &protected_slices) == TSI_OK);
+  GPR_ASSERT(unprotected.length == 0);
+  GPR_ASSERT(ssl_test_unprotect(server_protector,
+                                ssl_test_slice_buffer_to_string(
+                                    &protected_slices)) == message);
+  grpc_slice_buffer_reset_and_unref(&protected_slices);
+  // Server to client, behind whatever the handshake left for the client
+  // (e.g. TLS 1.3 session tickets), cut at arbitrary points.
+  tsi_test_channel* channel = fixture->channel;
+  std::string protected_bytes(
+      reinterpret_cast<const char*>(channel->client_channel +
+                                    channel->bytes_read_from_client_channel),
+      channel->bytes_written_to_client_channel -
+          channel->bytes_read_from_client_channel);
+  protected_bytes += ssl_test_protect(server_protector, message);
+  size_t offset = 0;
+  for (size_t chunk_size : {1, 4, 100, 5000, 3}) {
+    chunk_size = std::min(chunk_size, protected_bytes.size() - offset);
+    grpc_slice_buffer_add(&protected_slices,
+                          grpc_slice_from_copied_buffer(
+                              protected_bytes.data() + offset, chunk_size));
+    offset += chunk_size;
+    GPR_ASSERT(tsi_zero_copy_grpc_protector_unprotect(
+                   client_protector, &protected_slices, &unprotected) ==
+               TSI_OK);
+    GPR_ASSERT(protected_slices.length == 0);
+  }
+  grpc_slice_buffer_add(&protected_slices,
+                        grpc_slice_from_copied_buffer(
+                            protected_bytes.data() + offset,
+                            protected_bytes.size() - offset));
+  GPR_ASSERT(tsi_zero_copy_grpc_protector_unprotect(
+                 client_protector, &protected_slices, &unprotected) == TSI_OK);
+  GPR_ASSERT(ssl_test_slice_buffer_to_string(&unprotected) == message);
+  grpc_slice_buffer_destroy(&unprotected);
+  grpc_slice_buffer_destroy(&protected_slices);
+  tsi_frame_protector_destroy(server_protector);
+  tsi_zero_copy_grpc_protector_destroy(client_protector);
+  tsi_test_fixture_destroy(fixture);
+}
+
 int main(int argc, char** argv) {
   grpc::testing::TestEnvironment env(argc, argv);
   grpc_init();
@@ -1054,6 +1331,9 @@ int main(int argc, char** argv) {
     ssl_tsi_test_duplicate_root_certificates();
     ssl_tsi_test_extract_x509_subject_names();
     ssl_tsi_test_extract_cert_chain();
+    ssl_tsi_test_write_traffic_keys();
+    ssl_tsi_test_write_traffic_keys_not_tracked();
+    ssl_tsi_test_zero_copy_grpc_protector();
   }
   grpc_shutdown();
   return 0;
@@ -150,7 +150,8 @@ static const grpc_endpoint_vtable vtable = {te_read,
                                             te_get_peer,
                                             te_get_local_address,
                                             te_get_fd,
-                                            te_can_track_err};
+                                            te_can_track_err,
+                                            nullptr};
 
 grpc_endpoint* grpc_trickle_endpoint_create(grpc_endpoint* wrap,
                                             double bytes_per_second) {
@@ -0,0 +1,233 @@
+//
+// Copyright 2021 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "src/core/ext/xds/xds_route_table.h"
+
+#include <random>
+#include <thread>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "absl/strings/ascii.h"
+#include "absl/strings/str_cat.h"
+
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace testing {
+namespace {
+
+XdsApi::Route::Matchers PathMatchers(StringMatcher::Type type,
+                                     absl::string_view path,
+                                     bool case_sensitive = true) {
+  XdsApi::Route::Matchers matchers;
+  auto path_matcher = StringMatcher::Create(type, path, case_sensitive);
+  GPR_ASSERT(path_matcher.ok());
+  matchers.path_matcher = std::move(*path_matcher);
+  return matchers;
+}
+
+class XdsRouteTableTest : public ::testing::Test {
+ protected:
+  void AddRoute(XdsApi::Route::Matchers matchers) {
+    routes_.push_back(
+        absl::make_unique<XdsApi::Route::Matchers>(std::move(matchers)));
+  }
+
+  void BuildTable() {
+    std::vector<const XdsApi::Route::Matchers*> routes;
+    for (const auto& route : routes_) routes.push_back(route.get());
+    table_ = absl::make_unique<XdsRouteTable>(std::move(routes));
+  }
+
+  // Returns the route that a linear scan in route order would select.
+  absl::optional<size_t> LinearMatch(absl::string_view path) {
+    for (size_t i = 0; i < routes_.size(); ++i) {
+      if (routes_[i]->path_matcher.Match(path)) return i;
+    }
+    return absl::nullopt;
+  }
+
+  absl::optional<size_t> GetRoute(absl::string_view path) {
+    return table_->GetRouteForRequest(path, &metadata_);
+  }
+
+  std::vector<std::unique_ptr<XdsApi::Route::Matchers>> routes_;
+  std::unique_ptr<XdsRouteTable> table_;
+  grpc_metadata_batch metadata_;
+};
+
+TEST_F(XdsRouteTableTest, FirstMatchingRouteWins) {
+  AddRoute(PathMatchers(StringMatcher::Type::kPrefix, "/service/"));
+  AddRoute(PathMatchers(StringMatcher::Type::kExact, "/service/Method"));
+  AddRoute(PathMatchers(StringMatcher::Type::kSafeRegex, "/other/.*"));
+  AddRoute(PathMatchers(StringMatcher::Type::kPrefix, ""));
+  BuildTable();
+  EXPECT_EQ(GetRoute("/service/Method"), 0u);
+  EXPECT_EQ(GetRoute("/other/Method"), 2u);
+  EXPECT_EQ(GetRoute("/unknown/Method"), 3u);
+}
+
+TEST_F(XdsRouteTableTest, NoMatch) {
+  AddRoute(PathMatchers(StringMatcher::Type::kExact, "/service/Method"));
+  AddRoute(PathMatchers(StringMatcher::Type::kPrefix, "/service/Method/"));
+  AddRoute(PathMatchers(StringMatcher::Type::kSafeRegex, "/a.*"));
+  BuildTable();
+  EXPECT_EQ(GetRoute("/service/Method2"), absl::nullopt);
+  EXPECT_EQ(GetRoute("/service/Metho"), absl::nullopt);
+  // Regexes must match the whole path.
+  EXPECT_EQ(GetRoute("/b/a"), absl::nullopt);
+  EXPECT_EQ(GetRoute("/service/Method"), 0u);
+  EXPECT_EQ(GetRoute("/a/b"), 2u);
+}
+
+TEST_F(XdsRouteTableTest, CaseInsensitive) {
+  AddRoute(PathMatchers(StringMatcher::Type::kExact, "/Service/Method",
+                        /*case_sensitive=*/false));
+  AddRoute(PathMatchers(StringMatcher::Type::kPrefix, "/OTHER/",
+                        /*case_sensitive=*/false));
+  AddRoute(PathMatchers(StringMatcher::Type::kPrefix, "/Third/"));
+  BuildTable();
+  EXPECT_EQ(GetRoute("/sErViCe/METHOD"), 0u);
+  EXPECT_EQ(GetRoute("/other/Method"), 1u);
+  EXPECT_EQ(GetRoute("/Third/Method"), 2u);
+  EXPECT_EQ(GetRoute("/third/Method"), absl::nullopt);
+}
+
+TEST_F(XdsRouteTableTest, SuffixAndContainsMatchers) {
+  AddRoute(PathMatchers(StringMatcher::Type::kSuffix, "/Method"));
+  AddRoute(PathMatchers(StringMatcher::Type::kContains, "vice"));
+  BuildTable();
+  EXPECT_EQ(GetRoute("/service/Method"), 0u);
+  EXPECT_EQ(GetRoute("/service/Other"), 1u);
+  EXPECT_EQ(GetRoute("/foo/Other"), absl::nullopt);
+}
+
+TEST_F(XdsRouteTableTest, HeaderMatchers) {
+  XdsApi::Route::Matchers matchers =
+      PathMatchers(StringMatcher::Type::kPrefix, "/service/");
+  auto header_matcher = HeaderMatcher::Create(
+      "version", HeaderMatcher::Type::kExact, "canary");
+  ASSERT_TRUE(header_matcher.ok());
+  matchers.header_matchers.push_back(std::move(*header_matcher));
+  AddRoute(std::move(matchers));
+  AddRoute(PathMatchers(StringMatcher::Type::kPrefix, "/service/"));
+  BuildTable();
+  EXPECT_EQ(GetRoute("/service/Method"), 1u);
+  grpc_linked_mdelem storage;
+  storage.md = grpc_mdelem_from_slices(
+      grpc_slice_intern(grpc_slice_from_static_string("version")),
+      grpc_slice_intern(grpc_slice_from_static_string("canary")));
+  ASSERT_EQ(metadata_.LinkHead(&storage), GRPC_ERROR_NONE);
+  // The path was cached without headers; the headers are still evaluated.
+  EXPECT_EQ(GetRoute("/service/Method"), 0u);
+  metadata_.Remove(&storage);
+  EXPECT_EQ(GetRoute("/service/Method"), 1u);
+}
+
+TEST_F(XdsRouteTableTest, RuntimeFraction) {
+  XdsApi::Route::Matchers matchers =
+      PathMatchers(StringMatcher::Type::kPrefix, "/");
+  matchers.fraction_per_million = 0;
+  AddRoute(std::move(matchers));
+  matchers = PathMatchers(StringMatcher::Type::kPrefix, "/");
+  matchers.fraction_per_million = 1000000;
+  AddRoute(std::move(matchers));
+  BuildTable();
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_EQ(GetRoute("/service/Method"), 1u);
+  }
+}
+
+TEST_F(XdsRouteTableTest, MatchesLinearScanOnLargeTable) {
+  std::mt19937 rng(42);
+  auto random_path = [&rng]() {
+    return absl::StrCat("/pkg", rng() % 20, ".Service", rng() % 20, "/Method",
+                        rng() % 10);
+  };
+  for (int i = 0; i < 2000; ++i) {
+    std::string path = random_path();
+    switch (rng() % 5) {
+      case 0:
+        AddRoute(PathMatchers(StringMatcher::Type::kExact, path));
+        break;
+      case 1:
+        AddRoute(PathMatchers(StringMatcher::Type::kPrefix,
+                              path.substr(0, path.size() - rng() % 8)));
+        break;
+      case 2:
+        AddRoute(PathMatchers(StringMatcher::Type::kExact,
+                              absl::AsciiStrToUpper(path),
+                              /*case_sensitive=*/false));
+        break;
+      case 3:
+        AddRoute(PathMatchers(StringMatcher::Type::kSafeRegex,
+                              absl::StrCat(path.substr(0, path.size() - 1),
+                                           "[", rng() % 5, "-9]")));
+        break;
+      case 4:
+        AddRoute(PathMatchers(StringMatcher::Type::kSuffix,
+                              path.substr(path.find('.'))));
+        break;
+    }
+  }
+  BuildTable();
+  for (int i = 0; i < 2000; ++i) {
+    std::string path = random_path();
+    // Look up twice to check both the uncached and the cached result.
+    EXPECT_EQ(GetRoute(path), LinearMatch(path)) << path;
+    EXPECT_EQ(GetRoute(path), LinearMatch(path)) << path;
+  }
+}
+
+TEST_F(XdsRouteTableTest, ConcurrentLookups) {
+  for (int i = 0; i < 100; ++i) {
+    AddRoute(PathMatchers(StringMatcher::Type::kPrefix,
+                          absl::StrCat("/service", i, "/")));
+  }
+  BuildTable();
+  // More distinct paths than the cache holds, so that some lookups hit the
+  // cache while others fill it or find it full.
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([this, t]() {
+      for (int i = 0; i < 3000; ++i) {
+        const int service = (i * 7 + t) % 150;
+        const std::string path =
+            absl::StrCat("/service", service, "/Method", i % 20);
+        absl::optional<size_t> expected;
+        if (service < 100) expected = service;
+        EXPECT_EQ(table_->GetRouteForRequest(path, &metadata_), expected)
+            << path;
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc::testing::TestEnvironment env(argc, argv);
+  grpc_init();
+  auto result = RUN_ALL_TESTS();
+  grpc_shutdown();
+  return result;
+}
@@ -21,6 +21,7 @@
 #include <string.h>
 
 #include <memory>
+#include <string>
 #include <sstream>
 
 #include <benchmark/benchmark.h>
@@ -28,6 +29,8 @@
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 
+#include "src/core/ext/transport/chttp2/transport/bin_decoder.h"
+#include "src/core/ext/transport/chttp2/transport/bin_encoder.h"
 #include "src/core/ext/transport/chttp2/transport/hpack_encoder.h"
 #include "src/core/ext/transport/chttp2/transport/hpack_parser.h"
 #include "src/core/ext/transport/chttp2/transport/incoming_metadata.h"
@@ -48,6 +51,20 @@ static grpc_slice MakeSlice(std::vector<uint8_t> bytes) {
   return s;
 }
 
+// A token-like string of printable characters, as found in auth and tracing
+// headers.
+static std::string MakeToken(size_t length) {
+  static const char kAlphabet[] =
+      "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-._~+/";
+  std::string token;
+  uint32_t x = 1;
+  for (size_t i = 0; i < length; i++) {
+    x = x * 1103515245 + 12345;
+    token.push_back(kAlphabet[(x >> 16) % (sizeof(kAlphabet) - 1)]);
+  }
+  return token;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // HPACK encoder
 //
@@ -418,6 +435,67 @@ BENCHMARK_TEMPLATE(BM_HpackEncoderEncodeHeader,
 
 }  // namespace hpack_encoder_fixtures
 
+static void BM_HpackHuffmanCompress(benchmark::State& state) {
+  TrackCounters track_counters;
+  grpc_slice input = grpc_slice_from_cpp_string(MakeToken(state.range(0)));
+  for (auto _ : state) {
+    grpc_slice_unref(grpc_chttp2_huffman_compress(input));
+  }
+  grpc_slice_unref(input);
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_HpackHuffmanCompress)->Arg(16)->Arg(256)->Arg(4096);
+
+// Binary metadata of range(0) bytes, as a serialized trace context or auth
+// blob would be.
+static grpc_slice MakeBinaryValue(size_t length) {
+  grpc_slice value = grpc_slice_malloc(length);
+  for (size_t i = 0; i < length; i++) {
+    GRPC_SLICE_START_PTR(value)[i] = static_cast<uint8_t>(i * 131 + 7);
+  }
+  return value;
+}
+
+static void BM_Base64Encode(benchmark::State& state) {
+  TrackCounters track_counters;
+  grpc_slice input = MakeBinaryValue(state.range(0));
+  for (auto _ : state) {
+    grpc_slice_unref(grpc_chttp2_base64_encode(input));
+  }
+  grpc_slice_unref(input);
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_Base64Encode)->Arg(16)->Arg(256)->Arg(4096);
+
+static void BM_Base64EncodeAndHuffmanCompress(benchmark::State& state) {
+  TrackCounters track_counters;
+  grpc_slice input = MakeBinaryValue(state.range(0));
+  for (auto _ : state) {
+    grpc_slice_unref(grpc_chttp2_base64_encode_and_huffman_compress(input));
+  }
+  grpc_slice_unref(input);
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_Base64EncodeAndHuffmanCompress)->Arg(16)->Arg(256)->Arg(4096);
+
+static void BM_Base64Decode(benchmark::State& state) {
+  TrackCounters track_counters;
+  grpc_slice raw = MakeBinaryValue(state.range(0));
+  grpc_slice input = grpc_chttp2_base64_encode(raw);
+  for (auto _ : state) {
+    grpc_slice_unref(
+        grpc_chttp2_base64_decode_with_length(input, state.range(0)));
+  }
+  grpc_slice_unref(input);
+  grpc_slice_unref(raw);
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_Base64Decode)->Arg(16)->Arg(256)->Arg(4096);
+
 ////////////////////////////////////////////////////////////////////////////////
 // HPACK parser
 //
@@ -635,6 +713,58 @@ class NonIndexedBinaryElem<100, false> {
   }
 };
 
+// Appends a string length as an HPACK integer with a 7 bit prefix; huff_bit is
+// 0x80 for Huffman coded strings.
+static void AppendLength(std::vector<uint8_t>* v, uint8_t huff_bit,
+                         size_t length) {
+  if (length < 0x7f) {
+    v->push_back(static_cast<uint8_t>(huff_bit | length));
+    return;
+  }
+  v->push_back(static_cast<uint8_t>(huff_bit | 0x7f));
+  length -= 0x7f;
+  while (length >= 0x80) {
+    v->push_back(static_cast<uint8_t>(0x80 | (length & 0x7f)));
+    length >>= 7;
+  }
+  v->push_back(static_cast<uint8_t>(length));
+}
+
+// A non-indexed binary header carrying kLength bytes as (unpadded) base64.
+template <int kLength>
+class NonIndexedBase64Elem {
+ public:
+  static std::vector<grpc_slice> GetInitSlices() { return {}; }
+  static std::vector<grpc_slice> GetBenchmarkSlices() {
+    grpc_slice raw = MakeBinaryValue(kLength);
+    grpc_slice value = grpc_chttp2_base64_encode(raw);
+    std::vector<uint8_t> v = {0x00, 0x07, 'a', 'b', 'c', '-', 'b', 'i', 'n'};
+    AppendLength(&v, 0x00, GRPC_SLICE_LENGTH(value));
+    v.insert(v.end(), GRPC_SLICE_START_PTR(value), GRPC_SLICE_END_PTR(value));
+    grpc_slice_unref(raw);
+    grpc_slice_unref(value);
+    return {MakeSlice(v)};
+  }
+};
+
+// A non-indexed header whose value is a Huffman coded token of kLength bytes.
+template <int kLength>
+class NonIndexedHuffmanElem {
+ public:
+  static std::vector<grpc_slice> GetInitSlices() { return {}; }
+  static std::vector<grpc_slice> GetBenchmarkSlices() {
+    grpc_slice value = grpc_slice_from_cpp_string(MakeToken(kLength));
+    grpc_slice huff = grpc_chttp2_huffman_compress(value);
+    std::vector<uint8_t> v = {0x00, 0x0d, 'a', 'u', 't', 'h', 'o', 'r',
+                              'i',  'z',  'a', 't', 'i', 'o', 'n'};
+    AppendLength(&v, 0x80, GRPC_SLICE_LENGTH(huff));
+    v.insert(v.end(), GRPC_SLICE_START_PTR(huff), GRPC_SLICE_END_PTR(huff));
+    grpc_slice_unref(value);
+    grpc_slice_unref(huff);
+    return {MakeSlice(v)};
+  }
+};
+
 class RepresentativeClientInitialMetadata {
  public:
   static std::vector<grpc_slice> GetInitSlices() {
@@ -899,6 +1029,16 @@ BENCHMARK_TEMPLATE(BM_HpackParserParseHeader, NonIndexedBinaryElem<31, true>,
                    UnrefHeader);
 BENCHMARK_TEMPLATE(BM_HpackParserParseHeader, NonIndexedBinaryElem<100, true>,
                    UnrefHeader);
+BENCHMARK_TEMPLATE(BM_HpackParserParseHeader, NonIndexedBase64Elem<256>,
+                   UnrefHeader);
+BENCHMARK_TEMPLATE(BM_HpackParserParseHeader, NonIndexedBase64Elem<4096>,
+                   UnrefHeader);
+BENCHMARK_TEMPLATE(BM_HpackParserParseHeader, NonIndexedHuffmanElem<16>,
+                   UnrefHeader);
+BENCHMARK_TEMPLATE(BM_HpackParserParseHeader, NonIndexedHuffmanElem<256>,
+                   UnrefHeader);
+BENCHMARK_TEMPLATE(BM_HpackParserParseHeader, NonIndexedHuffmanElem<4096>,
+                   UnrefHeader);
 BENCHMARK_TEMPLATE(BM_HpackParserParseHeader,
                    RepresentativeClientInitialMetadata, UnrefHeader);
 BENCHMARK_TEMPLATE(BM_HpackParserParseHeader,
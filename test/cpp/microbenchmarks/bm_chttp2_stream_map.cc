@@ -0,0 +1,109 @@
+/*
+ *
+ * Copyright 2021 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Microbenchmarks for the chttp2 stream map with many concurrent streams on
+   one transport */
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "src/core/ext/transport/chttp2/transport/stream_map.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace {
+
+// Client-initiated stream ids: odd, increasing.
+uint32_t StreamId(size_t n) { return static_cast<uint32_t>(2 * n + 1); }
+
+void* StreamValue(uint32_t id) { return reinterpret_cast<void*>(id); }
+
+// Looks up open streams in a random order, as frames for interleaved streams
+// arrive on the transport.
+static void BM_StreamMapFind(benchmark::State& state) {
+  TrackCounters track_counters;
+  const size_t streams = state.range(0);
+  grpc_chttp2_stream_map map;
+  grpc_chttp2_stream_map_init(&map, 8);
+  std::vector<uint32_t> ids;
+  for (size_t i = 0; i < streams; i++) {
+    ids.push_back(StreamId(i));
+    grpc_chttp2_stream_map_add(&map, ids.back(), StreamValue(ids.back()));
+  }
+  std::shuffle(ids.begin(), ids.end(), std::mt19937(42));
+  size_t i = 0;
+  for (auto _ : state) {
+    uint32_t id = ids[i++ % ids.size()];
+    benchmark::DoNotOptimize(grpc_chttp2_stream_map_find(&map, id));
+  }
+  grpc_chttp2_stream_map_destroy(&map);
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_StreamMapFind)->Arg(1)->Arg(100)->Arg(1000)->Arg(10000);
+
+// Keeps range(0) streams open: every iteration one stream, picked at random,
+// completes and a new stream starts, with a lookup for each of a few frames
+// on an open stream in between.
+static void BM_StreamMapChurn(benchmark::State& state) {
+  constexpr int kFramesPerStream = 4;
+  TrackCounters track_counters;
+  const size_t streams = state.range(0);
+  grpc_chttp2_stream_map map;
+  grpc_chttp2_stream_map_init(&map, 8);
+  std::vector<uint32_t> open;
+  size_t next = 0;
+  for (; next < streams; next++) {
+    open.push_back(StreamId(next));
+    grpc_chttp2_stream_map_add(&map, open.back(), StreamValue(open.back()));
+  }
+  std::mt19937 rng(42);
+  for (auto _ : state) {
+    for (int i = 0; i < kFramesPerStream; i++) {
+      benchmark::DoNotOptimize(
+          grpc_chttp2_stream_map_find(&map, open[rng() % open.size()]));
+    }
+    size_t victim = rng() % open.size();
+    grpc_chttp2_stream_map_delete(&map, open[victim]);
+    open[victim] = StreamId(next++);
+    grpc_chttp2_stream_map_add(&map, open[victim], StreamValue(open[victim]));
+  }
+  grpc_chttp2_stream_map_destroy(&map);
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_StreamMapChurn)->Arg(1)->Arg(100)->Arg(1000)->Arg(10000);
+
+}  // namespace
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  ::grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
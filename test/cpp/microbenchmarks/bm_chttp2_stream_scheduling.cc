@@ -0,0 +1,388 @@
+/*
+ *
+ * Copyright 2021 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark the latency of unary calls sharing an HTTP/2 connection with a
+ * bulk stream that always has data to write */
+
+#include <fcntl.h>
+#include <string.h>
+
+#include <algorithm>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <grpc/grpc.h>
+#include <grpc/grpc_posix.h>
+#include <grpc/support/log.h>
+
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/iomgr/socket_utils_posix.h"
+#include "src/core/lib/iomgr/unix_sockets_posix.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc {
+namespace testing {
+
+enum Tag : intptr_t {
+  kBulkClientSend = 1,
+  kBulkClientStatus,
+  kBulkServerCall,
+  kBulkServerRecv,
+  kUnaryClient,
+  kUnaryServerCall,
+  kUnaryServerRecv,
+  kUnaryServerSend,
+  kShutdown,
+};
+
+static void* tag(Tag t) { return reinterpret_cast<void*>(t); }
+
+static grpc_slice MakeSlice(size_t length) {
+  grpc_slice slice = grpc_slice_malloc(length);
+  memset(GRPC_SLICE_START_PTR(slice), 'a', length);
+  return slice;
+}
+
+// A client and server connected over a socketpair, with one client streaming
+// call sending large messages as fast as flow control allows and unary calls
+// started one at a time on request. Everything runs off one completion
+// queue.
+class SchedulingFixture {
+ public:
+  SchedulingFixture(int write_quantum, size_t bulk_message_size)
+      : cq_(grpc_completion_queue_create_for_next(nullptr)),
+        bulk_slice_(MakeSlice(bulk_message_size)),
+        unary_slice_(MakeSlice(100)) {
+    int sv[2];
+    grpc_create_socketpair_if_unix(sv);
+    for (int fd : sv) {
+      int flags = fcntl(fd, F_GETFL, 0);
+      GPR_ASSERT(fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0);
+      GPR_ASSERT(grpc_set_socket_no_sigpipe_if_possible(fd) ==
+                 GRPC_ERROR_NONE);
+    }
+    grpc_arg arg = grpc_channel_arg_integer_create(
+        const_cast<char*>(GRPC_ARG_HTTP2_STREAM_WRITE_QUANTUM), write_quantum);
+    grpc_channel_args args = {1, &arg};
+    server_ = grpc_server_create(&args, nullptr);
+    grpc_server_register_completion_queue(server_, cq_, nullptr);
+    grpc_server_start(server_);
+    grpc_server_add_insecure_channel_from_fd(server_, nullptr, sv[1]);
+    channel_ = grpc_insecure_channel_create_from_fd("scheduling", sv[0], &args);
+    StartBulkCall();
+  }
+
+  ~SchedulingFixture() {
+    grpc_call_cancel(bulk_client_call_, nullptr);
+    while (bulk_ops_pending_ > 0) Step();
+    grpc_call_unref(bulk_client_call_);
+    grpc_call_unref(bulk_server_call_);
+    grpc_metadata_array_destroy(&bulk_trailing_metadata_);
+    grpc_slice_unref(bulk_status_details_);
+    grpc_call_details_destroy(&bulk_details_);
+    grpc_metadata_array_destroy(&bulk_initial_metadata_);
+    grpc_channel_destroy(channel_);
+    grpc_server_shutdown_and_notify(server_, cq_, tag(kShutdown));
+    grpc_server_cancel_all_calls(server_);
+    while (!shutdown_) Step();
+    grpc_server_destroy(server_);
+    grpc_completion_queue_shutdown(cq_);
+    while (grpc_completion_queue_next(cq_, gpr_inf_future(GPR_CLOCK_MONOTONIC),
+                                      nullptr)
+               .type != GRPC_QUEUE_SHUTDOWN) {
+    }
+    grpc_completion_queue_destroy(cq_);
+    grpc_slice_unref(bulk_slice_);
+    grpc_slice_unref(unary_slice_);
+  }
+
+  // Performs one unary call while the bulk stream keeps writing, and returns
+  // how long it took in microseconds.
+  double UnaryCall() {
+    gpr_timespec start = gpr_now(GPR_CLOCK_MONOTONIC);
+    StartUnaryCall();
+    while (!unary_client_done_ || !unary_server_done_) Step();
+    gpr_timespec elapsed = gpr_time_sub(gpr_now(GPR_CLOCK_MONOTONIC), start);
+    FinishUnaryCall();
+    return elapsed.tv_sec * 1e6 + elapsed.tv_nsec / 1e3;
+  }
+
+  size_t bulk_bytes_received() const { return bulk_bytes_received_; }
+
+ private:
+  void StartBulkCall() {
+    bulk_client_call_ = grpc_channel_create_call(
+        channel_, nullptr, GRPC_PROPAGATE_DEFAULTS, cq_,
+        grpc_slice_from_static_string("/bulk"), nullptr,
+        gpr_inf_future(GPR_CLOCK_REALTIME), nullptr);
+    grpc_metadata_array_init(&bulk_trailing_metadata_);
+    grpc_op ops[2];
+    memset(ops, 0, sizeof(ops));
+    ops[0].op = GRPC_OP_SEND_INITIAL_METADATA;
+    ops[1].op = GRPC_OP_RECV_STATUS_ON_CLIENT;
+    ops[1].data.recv_status_on_client.trailing_metadata =
+        &bulk_trailing_metadata_;
+    ops[1].data.recv_status_on_client.status = &bulk_status_;
+    ops[1].data.recv_status_on_client.status_details = &bulk_status_details_;
+    GPR_ASSERT(GRPC_CALL_OK == grpc_call_start_batch(bulk_client_call_, ops, 2,
+                                                     tag(kBulkClientStatus),
+                                                     nullptr));
+    grpc_call_details_init(&bulk_details_);
+    grpc_metadata_array_init(&bulk_initial_metadata_);
+    GPR_ASSERT(GRPC_CALL_OK ==
+               grpc_server_request_call(server_, &bulk_server_call_,
+                                        &bulk_details_, &bulk_initial_metadata_,
+                                        cq_, cq_, tag(kBulkServerCall)));
+    bulk_ops_pending_ = 3;
+    SendBulkMessage();
+  }
+
+  void SendBulkMessage() {
+    bulk_send_buffer_ = grpc_raw_byte_buffer_create(&bulk_slice_, 1);
+    grpc_op op;
+    memset(&op, 0, sizeof(op));
+    op.op = GRPC_OP_SEND_MESSAGE;
+    op.data.send_message.send_message = bulk_send_buffer_;
+    GPR_ASSERT(GRPC_CALL_OK ==
+               grpc_call_start_batch(bulk_client_call_, &op, 1,
+                                     tag(kBulkClientSend), nullptr));
+  }
+
+  void RecvBulkMessage() {
+    grpc_op op;
+    memset(&op, 0, sizeof(op));
+    op.op = GRPC_OP_RECV_MESSAGE;
+    op.data.recv_message.recv_message = &bulk_recv_buffer_;
+    GPR_ASSERT(GRPC_CALL_OK ==
+               grpc_call_start_batch(bulk_server_call_, &op, 1,
+                                     tag(kBulkServerRecv), nullptr));
+  }
+
+  void StartUnaryCall() {
+    unary_client_done_ = false;
+    unary_server_done_ = false;
+    unary_client_call_ = grpc_channel_create_call(
+        channel_, nullptr, GRPC_PROPAGATE_DEFAULTS, cq_,
+        grpc_slice_from_static_string("/unary"), nullptr,
+        gpr_inf_future(GPR_CLOCK_REALTIME), nullptr);
+    grpc_metadata_array_init(&unary_initial_metadata_recv_);
+    grpc_metadata_array_init(&unary_trailing_metadata_);
+    unary_request_ = grpc_raw_byte_buffer_create(&unary_slice_, 1);
+    grpc_op ops[6];
+    memset(ops, 0, sizeof(ops));
+    ops[0].op = GRPC_OP_SEND_INITIAL_METADATA;
+    ops[1].op = GRPC_OP_SEND_MESSAGE;
+    ops[1].data.send_message.send_message = unary_request_;
+    ops[2].op = GRPC_OP_SEND_CLOSE_FROM_CLIENT;
+    ops[3].op = GRPC_OP_RECV_INITIAL_METADATA;
+    ops[3].data.recv_initial_metadata.recv_initial_metadata =
+        &unary_initial_metadata_recv_;
+    ops[4].op = GRPC_OP_RECV_MESSAGE;
+    ops[4].data.recv_message.recv_message = &unary_response_recv_;
+    ops[5].op = GRPC_OP_RECV_STATUS_ON_CLIENT;
+    ops[5].data.recv_status_on_client.trailing_metadata =
+        &unary_trailing_metadata_;
+    ops[5].data.recv_status_on_client.status = &unary_status_;
+    ops[5].data.recv_status_on_client.status_details = &unary_status_details_;
+    GPR_ASSERT(GRPC_CALL_OK == grpc_call_start_batch(unary_client_call_, ops,
+                                                     6, tag(kUnaryClient),
+                                                     nullptr));
+    grpc_call_details_init(&unary_details_);
+    grpc_metadata_array_init(&unary_initial_metadata_);
+    GPR_ASSERT(GRPC_CALL_OK ==
+               grpc_server_request_call(
+                   server_, &unary_server_call_, &unary_details_,
+                   &unary_initial_metadata_, cq_, cq_, tag(kUnaryServerCall)));
+  }
+
+  void FinishUnaryCall() {
+    GPR_ASSERT(unary_status_ == GRPC_STATUS_OK);
+    grpc_call_unref(unary_client_call_);
+    grpc_call_unref(unary_server_call_);
+    grpc_byte_buffer_destroy(unary_request_);
+    grpc_byte_buffer_destroy(unary_request_recv_);
+    grpc_byte_buffer_destroy(unary_response_);
+    grpc_byte_buffer_destroy(unary_response_recv_);
+    grpc_metadata_array_destroy(&unary_initial_metadata_recv_);
+    grpc_metadata_array_destroy(&unary_trailing_metadata_);
+    grpc_slice_unref(unary_status_details_);
+    grpc_call_details_destroy(&unary_details_);
+    grpc_metadata_array_destroy(&unary_initial_metadata_);
+  }
+
+  // Waits for the next completion and reacts to it.
+  void Step() {
+    grpc_event ev = grpc_completion_queue_next(
+        cq_, gpr_inf_future(GPR_CLOCK_MONOTONIC), nullptr);
+    GPR_ASSERT(ev.type == GRPC_OP_COMPLETE);
+    switch (static_cast<Tag>(reinterpret_cast<intptr_t>(ev.tag))) {
+      case kBulkClientSend:
+        grpc_byte_buffer_destroy(bulk_send_buffer_);
+        if (ev.success) {
+          SendBulkMessage();
+        } else {
+          --bulk_ops_pending_;
+        }
+        break;
+      case kBulkClientStatus:
+        --bulk_ops_pending_;
+        break;
+      case kBulkServerCall:
+        GPR_ASSERT(ev.success);
+        RecvBulkMessage();
+        break;
+      case kBulkServerRecv:
+        if (ev.success && bulk_recv_buffer_ != nullptr) {
+          bulk_bytes_received_ += grpc_byte_buffer_length(bulk_recv_buffer_);
+          grpc_byte_buffer_destroy(bulk_recv_buffer_);
+          bulk_recv_buffer_ = nullptr;
+          RecvBulkMessage();
+        } else {
+          --bulk_ops_pending_;
+        }
+        break;
+      case kUnaryClient:
+        GPR_ASSERT(ev.success);
+        unary_client_done_ = true;
+        break;
+      case kUnaryServerCall: {
+        GPR_ASSERT(ev.success);
+        grpc_op op;
+        memset(&op, 0, sizeof(op));
+        op.op = GRPC_OP_RECV_MESSAGE;
+        op.data.recv_message.recv_message = &unary_request_recv_;
+        GPR_ASSERT(GRPC_CALL_OK ==
+                   grpc_call_start_batch(unary_server_call_, &op, 1,
+                                         tag(kUnaryServerRecv), nullptr));
+        break;
+      }
+      case kUnaryServerRecv: {
+        GPR_ASSERT(ev.success);
+        unary_response_ = grpc_raw_byte_buffer_create(&unary_slice_, 1);
+        grpc_op ops[4];
+        memset(ops, 0, sizeof(ops));
+        ops[0].op = GRPC_OP_SEND_INITIAL_METADATA;
+        ops[1].op = GRPC_OP_SEND_MESSAGE;
+        ops[1].data.send_message.send_message = unary_response_;
+        ops[2].op = GRPC_OP_RECV_CLOSE_ON_SERVER;
+        ops[2].data.recv_close_on_server.cancelled = &unary_cancelled_;
+        ops[3].op = GRPC_OP_SEND_STATUS_FROM_SERVER;
+        ops[3].data.send_status_from_server.status = GRPC_STATUS_OK;
+        GPR_ASSERT(GRPC_CALL_OK ==
+                   grpc_call_start_batch(unary_server_call_, ops, 4,
+                                         tag(kUnaryServerSend), nullptr));
+        break;
+      }
+      case kUnaryServerSend:
+        GPR_ASSERT(ev.success);
+        unary_server_done_ = true;
+        break;
+      case kShutdown:
+        shutdown_ = true;
+        break;
+    }
+  }
+
+  grpc_completion_queue* cq_;
+  grpc_server* server_;
+  grpc_channel* channel_;
+  grpc_slice bulk_slice_;
+  grpc_slice unary_slice_;
+  bool shutdown_ = false;
+
+  // The bulk call.
+  grpc_call* bulk_client_call_;
+  grpc_call* bulk_server_call_ = nullptr;
+  grpc_byte_buffer* bulk_send_buffer_ = nullptr;
+  grpc_byte_buffer* bulk_recv_buffer_ = nullptr;
+  grpc_metadata_array bulk_trailing_metadata_;
+  grpc_status_code bulk_status_;
+  grpc_slice bulk_status_details_;
+  grpc_call_details bulk_details_;
+  grpc_metadata_array bulk_initial_metadata_;
+  int bulk_ops_pending_ = 0;
+  size_t bulk_bytes_received_ = 0;
+
+  // The unary call in progress.
+  grpc_call* unary_client_call_;
+  grpc_call* unary_server_call_;
+  grpc_byte_buffer* unary_request_;
+  grpc_byte_buffer* unary_request_recv_ = nullptr;
+  grpc_byte_buffer* unary_response_;
+  grpc_byte_buffer* unary_response_recv_ = nullptr;
+  grpc_metadata_array unary_initial_metadata_recv_;
+  grpc_metadata_array unary_trailing_metadata_;
+  grpc_status_code unary_status_;
+  grpc_slice unary_status_details_;
+  grpc_call_details unary_details_;
+  grpc_metadata_array unary_initial_metadata_;
+  int unary_cancelled_;
+  bool unary_client_done_;
+  bool unary_server_done_;
+};
+
+// Args: the stream write quantum (0 writes each stream's data in the order
+// the streams became writable), and the size of the bulk stream's messages.
+static void BM_UnaryLatencyUnderBulkStream(benchmark::State& state) {
+  TrackCounters track_counters;
+  std::vector<double> latencies;
+  size_t bulk_bytes;
+  {
+    SchedulingFixture fixture(state.range(0), state.range(1));
+    for (auto _ : state) {
+      latencies.push_back(fixture.UnaryCall());
+    }
+    bulk_bytes = fixture.bulk_bytes_received();
+  }
+  std::sort(latencies.begin(), latencies.end());
+  state.counters["p50_us"] = latencies[latencies.size() / 2];
+  state.counters["p99_us"] = latencies[latencies.size() * 99 / 100];
+  state.counters["bulk_bytes_per_call"] =
+      static_cast<double>(bulk_bytes) / latencies.size();
+  track_counters.Finish(state);
+}
+
+static void UnaryLatencyArgs(benchmark::internal::Benchmark* b) {
+  for (int quantum : {0, 16384}) {
+    for (int bulk_message_size : {64 * 1024, 4 * 1024 * 1024}) {
+      b->Args({quantum, bulk_message_size});
+    }
+  }
+}
+BENCHMARK(BM_UnaryLatencyUnderBulkStream)->Apply(UnaryLatencyArgs);
+
+}  // namespace testing
+}  // namespace grpc
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  ::grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
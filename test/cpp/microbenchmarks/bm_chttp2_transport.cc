@@ -59,7 +59,8 @@ class PhonyEndpoint : public grpc_endpoint {
                                                    get_peer,
                                                    get_local_address,
                                                    get_fd,
-                                                   can_track_err};
+                                                   can_track_err,
+                                                   nullptr};
     grpc_endpoint::vtable = &my_vtable;
   }
 
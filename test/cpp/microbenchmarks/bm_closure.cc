@@ -18,7 +18,12 @@
 
 /* Test various closure related operations */
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
 #include <sstream>
+#include <vector>
 
 #include <benchmark/benchmark.h>
 
@@ -28,6 +33,7 @@
 #include "src/core/lib/iomgr/closure.h"
 #include "src/core/lib/iomgr/combiner.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/iomgr/executor.h"
 #include "test/core/util/test_config.h"
 #include "test/cpp/microbenchmarks/helpers.h"
 #include "test/cpp/util/test_config.h"
@@ -388,6 +394,106 @@ static void BM_ClosureReschedOnExecCtx(benchmark::State& state) {
 }
 BENCHMARK(BM_ClosureReschedOnExecCtx);
 
+// Values of GRPC_EXECUTOR_IMPL.
+static const char* const kExecutorImpls[] = {"threads", "work_stealing"};
+
+// A chain of closures on an executor: each step enqueues the next until
+// kSteps have run. With skew set, one step in 16 spins for 100us, standing in
+// for a closure that blocks; steps record how long they waited to start.
+class ExecutorChain {
+ public:
+  static constexpr int kSteps = 1000;
+
+  ExecutorChain(grpc_core::Executor* executor, bool skew,
+                std::atomic<int>* pending, gpr_event* done)
+      : executor_(executor), skew_(skew), pending_(pending), done_(done) {
+    GRPC_CLOSURE_INIT(&closure_, Step, this, nullptr);
+  }
+
+  void Start() {
+    step_ = 0;
+    Enqueue();
+  }
+
+  const std::vector<double>& waits() const { return waits_; }
+
+ private:
+  void Enqueue() {
+    enqueued_ = std::chrono::steady_clock::now();
+    executor_->Enqueue(&closure_, GRPC_ERROR_NONE, true);
+  }
+
+  static void Step(void* arg, grpc_error_handle /*error*/) {
+    ExecutorChain* self = static_cast<ExecutorChain*>(arg);
+    auto start = std::chrono::steady_clock::now();
+    self->waits_.push_back(
+        std::chrono::duration<double, std::micro>(start - self->enqueued_)
+            .count());
+    if (self->skew_ && self->step_ % 16 == 0) {
+      auto end = start + std::chrono::microseconds(100);
+      while (std::chrono::steady_clock::now() < end) {
+      }
+    }
+    if (++self->step_ < kSteps) {
+      self->Enqueue();
+    } else if (--*self->pending_ == 0) {
+      gpr_event_set(self->done_, reinterpret_cast<void*>(1));
+    }
+  }
+
+  grpc_core::Executor* executor_;
+  const bool skew_;
+  std::atomic<int>* pending_;
+  gpr_event* done_;
+  grpc_closure closure_;
+  int step_ = 0;
+  std::chrono::steady_clock::time_point enqueued_;
+  std::vector<double> waits_;
+};
+
+// range(0): executor implementation, range(1): concurrent chains,
+// range(2): skewed load.
+static void BM_ClosureChainsOnExecutor(benchmark::State& state) {
+  TrackCounters track_counters;
+  grpc_core::ExecCtx exec_ctx;
+  GPR_GLOBAL_CONFIG_SET(grpc_executor_impl, kExecutorImpls[state.range(0)]);
+  grpc_core::Executor executor("bm_executor");
+  executor.Init();
+  const int num_chains = state.range(1);
+  std::atomic<int> pending;
+  gpr_event done;
+  std::vector<std::unique_ptr<ExecutorChain>> chains;
+  for (int i = 0; i < num_chains; i++) {
+    chains.emplace_back(
+        new ExecutorChain(&executor, state.range(2) != 0, &pending, &done));
+  }
+  while (state.KeepRunningBatch(num_chains * ExecutorChain::kSteps)) {
+    pending.store(num_chains);
+    gpr_event_init(&done);
+    for (auto& chain : chains) chain->Start();
+    gpr_event_wait(&done, gpr_inf_future(GPR_CLOCK_REALTIME));
+  }
+  executor.Shutdown();
+  GPR_GLOBAL_CONFIG_SET(grpc_executor_impl, kExecutorImpls[0]);
+  std::vector<double> waits;
+  for (auto& chain : chains) {
+    waits.insert(waits.end(), chain->waits().begin(), chain->waits().end());
+  }
+  std::sort(waits.begin(), waits.end());
+  state.SetItemsProcessed(state.iterations());
+  state.counters["wait_p50_us"] = waits[waits.size() / 2];
+  state.counters["wait_p99_us"] = waits[waits.size() * 99 / 100];
+  track_counters.Finish(state);
+}
+static void ExecutorChainsArgs(benchmark::internal::Benchmark* b) {
+  for (int impl = 0; impl < 2; impl++) {
+    for (int chains : {1, 8, 64}) {
+      for (int skew = 0; skew < 2; skew++) b->Args({impl, chains, skew});
+    }
+  }
+}
+BENCHMARK(BM_ClosureChainsOnExecutor)->Apply(ExecutorChainsArgs)->UseRealTime();
+
 // Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
 // and others do not. This allows us to support both modes.
 namespace benchmark {
@@ -110,7 +110,7 @@ static const grpc_event_engine_vtable* init_engine_vtable(bool) {
   return &g_vtable;
 }
 
-static void setup() {
+static void setup(int num_shards) {
   // This test should only ever be run with a non or any polling engine
   // Override the polling engine for the non-polling engine
   // and add a custom polling engine
@@ -123,6 +123,7 @@ static void setup() {
              strcmp(grpc_get_poll_strategy_name(), "bm_cq_multiple_threads") ==
                  0);
 
+  grpc_cq_set_next_shards(num_shards);
   g_cq = grpc_completion_queue_create_for_next(nullptr);
 }
 
@@ -137,6 +138,7 @@ static void teardown() {
   }
 
   grpc_completion_queue_destroy(g_cq);
+  grpc_cq_set_next_shards(1);
   grpc_shutdown();
 }
 
@@ -167,7 +169,7 @@ static void BM_Cq_Throughput(benchmark::State& state) {
   gpr_mu_lock(&g_mu);
   g_threads_active++;
   if (thd_idx == 0) {
-    setup();
+    setup(state.range(0));
     g_active = true;
     gpr_cv_broadcast(&g_cv);
   } else {
@@ -206,7 +208,12 @@ static void BM_Cq_Throughput(benchmark::State& state) {
   }
 }
 
-BENCHMARK(BM_Cq_Throughput)->ThreadRange(1, 16)->UseRealTime();
+// Arg: the number of sub-queues of the completion queue (0: one per core).
+BENCHMARK(BM_Cq_Throughput)
+    ->ThreadRange(1, 64)
+    ->Arg(1)
+    ->Arg(0)
+    ->UseRealTime();
 
 }  // namespace testing
 }  // namespace grpc
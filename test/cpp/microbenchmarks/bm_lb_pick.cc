@@ -0,0 +1,181 @@
+/*
+ *
+ * Copyright 2021 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark LB picks on one channel from many threads */
+
+#include <netinet/in.h>
+#include <string.h>
+
+#include <memory>
+
+#include <benchmark/benchmark.h>
+
+#include "absl/memory/memory.h"
+
+#include <grpc/grpc.h>
+#include <grpc/support/log.h>
+
+#include "src/core/ext/filters/client_channel/lb_policy.h"
+#include "src/core/ext/filters/client_channel/lb_policy_registry.h"
+#include "src/core/ext/filters/client_channel/server_address.h"
+#include "src/core/ext/filters/client_channel/subchannel_interface.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/iomgr/work_serializer.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc_core {
+namespace {
+
+constexpr int kNumBackends = 16;
+
+// A subchannel that is always READY and never reports a change.
+class ReadySubchannel : public SubchannelInterface {
+ public:
+  grpc_connectivity_state CheckConnectivityState() override {
+    return GRPC_CHANNEL_READY;
+  }
+  void WatchConnectivityState(
+      grpc_connectivity_state /*initial_state*/,
+      std::unique_ptr<ConnectivityStateWatcherInterface> watcher) override {
+    watcher_ = std::move(watcher);
+  }
+  void CancelConnectivityStateWatch(
+      ConnectivityStateWatcherInterface* /*watcher*/) override {
+    watcher_.reset();
+  }
+  void AttemptToConnect() override {}
+  void ResetBackoff() override {}
+  const grpc_channel_args* channel_args() override { return nullptr; }
+
+ private:
+  std::unique_ptr<ConnectivityStateWatcherInterface> watcher_;
+};
+
+class Helper : public LoadBalancingPolicy::ChannelControlHelper {
+ public:
+  explicit Helper(
+      std::unique_ptr<LoadBalancingPolicy::SubchannelPicker>* picker)
+      : picker_(picker) {}
+
+  RefCountedPtr<SubchannelInterface> CreateSubchannel(
+      ServerAddress /*address*/, const grpc_channel_args& /*args*/) override {
+    return MakeRefCounted<ReadySubchannel>();
+  }
+  void UpdateState(
+      grpc_connectivity_state state, const absl::Status& /*status*/,
+      std::unique_ptr<LoadBalancingPolicy::SubchannelPicker> picker) override {
+    if (state == GRPC_CHANNEL_READY) *picker_ = std::move(picker);
+  }
+  void RequestReresolution() override {}
+  void AddTraceEvent(TraceSeverity /*severity*/,
+                     absl::string_view /*message*/) override {}
+
+ private:
+  std::unique_ptr<LoadBalancingPolicy::SubchannelPicker>* picker_;
+};
+
+// An LB policy of the given type with kNumBackends READY backends, and the
+// picker it last reported.
+class PickFixture {
+ public:
+  explicit PickFixture(const char* policy_name) {
+    ExecCtx exec_ctx;
+    LoadBalancingPolicy::Args args;
+    args.work_serializer = std::make_shared<WorkSerializer>();
+    args.channel_control_helper = absl::make_unique<Helper>(&picker_);
+    policy_ = LoadBalancingPolicyRegistry::CreateLoadBalancingPolicy(
+        policy_name, std::move(args));
+    GPR_ASSERT(policy_ != nullptr);
+    LoadBalancingPolicy::UpdateArgs update;
+    for (int i = 0; i < kNumBackends; i++) {
+      grpc_resolved_address address;
+      memset(&address, 0, sizeof(address));
+      sockaddr_in* addr = reinterpret_cast<sockaddr_in*>(address.addr);
+      addr->sin_family = AF_INET;
+      addr->sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+      addr->sin_port = htons(10000 + i);
+      address.len = sizeof(*addr);
+      update.addresses.emplace_back(address, nullptr);
+    }
+    update.args = grpc_channel_args_copy(nullptr);
+    policy_->UpdateLocked(std::move(update));
+    GPR_ASSERT(picker_ != nullptr);
+  }
+
+  LoadBalancingPolicy::SubchannelPicker* picker() { return picker_.get(); }
+
+  // Stands in for the client channel's data plane mutex.
+  Mutex* mu() { return &mu_; }
+
+ private:
+  std::unique_ptr<LoadBalancingPolicy::SubchannelPicker> picker_;
+  OrphanablePtr<LoadBalancingPolicy> policy_;
+  Mutex mu_;
+};
+
+PickFixture* RoundRobinFixture() {
+  static PickFixture* fixture = new PickFixture("round_robin");
+  return fixture;
+}
+
+// All threads pick from the same round_robin picker. With range(0) set, each
+// pick is made under a shared mutex, as the client channel does today, to
+// show how much of the cost is the picker and how much is the lock.
+static void BM_RoundRobinPick(benchmark::State& state) {
+  TrackCounters track_counters;
+  PickFixture* fixture = RoundRobinFixture();
+  const bool locked = state.range(0);
+  for (auto _ : state) {
+    LoadBalancingPolicy::PickArgs args;
+    if (locked) {
+      MutexLock lock(fixture->mu());
+      benchmark::DoNotOptimize(fixture->picker()->Pick(args));
+    } else {
+      benchmark::DoNotOptimize(fixture->picker()->Pick(args));
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_RoundRobinPick)
+    ->Arg(/*locked=*/0)
+    ->Arg(/*locked=*/1)
+    ->ThreadRange(1, 64)
+    ->UseRealTime();
+
+}  // namespace
+}  // namespace grpc_core
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  ::grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
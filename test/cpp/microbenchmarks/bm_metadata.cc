@@ -18,6 +18,8 @@
 
 /* Test out various metadata handling primitives */
 
+#include <vector>
+
 #include <benchmark/benchmark.h>
 
 #include <grpc/grpc.h>
@@ -69,6 +71,53 @@ static void BM_SliceReIntern(benchmark::State& state) {
 }
 BENCHMARK(BM_SliceReIntern);
 
+// Keys and values of a typical request, as the hpack parser interns them.
+static const char* const kRequestHeaderStrings[] = {
+    ":path",
+    "/google.pubsub.v2.PublisherService/CreateTopic",
+    ":authority",
+    "pubsub.googleapis.com",
+    "grpc-timeout",
+    "1S",
+    "user-agent",
+    "grpc-c++/1.42.0-dev grpc-c/19.0.0 (linux; chttp2)",
+    "x-goog-api-client",
+    "gl-cpp/1.42.0-dev grpc/1.42.0-dev",
+    "x-goog-request-params",
+    "topic=projects/foo/topics/bar",
+    "authorization",
+    "Bearer ya29.a0ARrdaM-not-a-real-token",
+};
+
+// Every thread interns and unrefs the strings of a request. With arg 1, a
+// reference to each string is kept alive meanwhile, as concurrent calls
+// carrying the same headers would, so interning only looks strings up; with
+// arg 0, strings may be added to and removed from the table each time.
+static void BM_SliceInternRequestHeadersThreaded(benchmark::State& state) {
+  TrackCounters track_counters;
+  std::vector<grpc_slice> held;
+  if (state.range(0) != 0) {
+    for (const char* s : kRequestHeaderStrings) {
+      held.push_back(grpc_slice_intern(grpc_slice_from_static_string(s)));
+    }
+  }
+  std::vector<grpc_core::ExternallyManagedSlice> slices;
+  for (const char* s : kRequestHeaderStrings) slices.emplace_back(s);
+  for (auto _ : state) {
+    for (grpc_core::ExternallyManagedSlice& slice : slices) {
+      grpc_slice_unref(grpc_core::ManagedMemorySlice(&slice));
+    }
+  }
+  for (grpc_slice& slice : held) grpc_slice_unref(slice);
+  state.SetItemsProcessed(state.iterations() * slices.size());
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_SliceInternRequestHeadersThreaded)
+    ->Arg(0)
+    ->Arg(1)
+    ->ThreadRange(1, 64)
+    ->UseRealTime();
+
 static void BM_SliceInternStaticMetadata(benchmark::State& state) {
   TrackCounters track_counters;
   for (auto _ : state) {
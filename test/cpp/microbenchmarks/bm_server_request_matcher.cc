@@ -0,0 +1,209 @@
+/*
+ *
+ * Copyright 2021 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark matching incoming calls to calls requested by the application on
+ * a server with many completion queues */
+
+#include <string.h>
+
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <grpc/grpc.h>
+#include <grpc/support/log.h>
+
+#include "src/core/ext/transport/inproc/inproc_transport.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc {
+namespace testing {
+
+static void* tag(intptr_t t) { return reinterpret_cast<void*>(t); }
+
+static grpc_event next(grpc_completion_queue* cq) {
+  grpc_event ev = grpc_completion_queue_next(
+      cq, gpr_inf_future(GPR_CLOCK_MONOTONIC), nullptr);
+  GPR_ASSERT(ev.type == GRPC_OP_COMPLETE);
+  GPR_ASSERT(ev.success);
+  return ev;
+}
+
+// A server with one completion queue per Arg, and an in-process channel per
+// completion queue. Each channel's calls start matching at a randomly chosen
+// completion queue.
+class RequestMatchingFixture {
+ public:
+  explicit RequestMatchingFixture(int num_cqs)
+      : server_(grpc_server_create(nullptr, nullptr)),
+        client_cq_(grpc_completion_queue_create_for_next(nullptr)) {
+    for (int i = 0; i < num_cqs; i++) {
+      server_cqs_.push_back(grpc_completion_queue_create_for_next(nullptr));
+      grpc_server_register_completion_queue(server_, server_cqs_.back(),
+                                            nullptr);
+    }
+    grpc_server_start(server_);
+    for (int i = 0; i < num_cqs; i++) {
+      channels_.push_back(
+          grpc_inproc_channel_create(server_, nullptr, nullptr));
+    }
+  }
+
+  ~RequestMatchingFixture() {
+    for (grpc_channel* channel : channels_) grpc_channel_destroy(channel);
+    grpc_server_shutdown_and_notify(server_, server_cqs_[0], tag(-1));
+    while (next(server_cqs_[0]).tag != tag(-1)) {
+    }
+    grpc_server_destroy(server_);
+    server_cqs_.push_back(client_cq_);
+    for (grpc_completion_queue* cq : server_cqs_) {
+      grpc_completion_queue_shutdown(cq);
+      while (grpc_completion_queue_next(cq, gpr_inf_future(GPR_CLOCK_MONOTONIC),
+                                        nullptr)
+                 .type != GRPC_QUEUE_SHUTDOWN) {
+      }
+      grpc_completion_queue_destroy(cq);
+    }
+  }
+
+  // Starts a call on each channel and requests a call on each server
+  // completion queue, in either order, then waits for every call to be
+  // matched and cancels it.
+  void MatchCalls(bool calls_first) {
+    size_t n = channels_.size();
+    std::vector<ClientCall> client_calls(n);
+    std::vector<ServerCall> server_calls(n);
+    if (calls_first) {
+      StartClientCalls(&client_calls);
+      RequestServerCalls(&server_calls);
+    } else {
+      RequestServerCalls(&server_calls);
+      StartClientCalls(&client_calls);
+    }
+    for (size_t i = 0; i < n; i++) {
+      GPR_ASSERT(next(server_cqs_[i]).tag == tag(i));
+      ServerCall& sc = server_calls[i];
+      grpc_call_cancel(sc.call, nullptr);
+      grpc_call_unref(sc.call);
+      grpc_call_details_destroy(&sc.details);
+      grpc_metadata_array_destroy(&sc.initial_metadata);
+    }
+    for (size_t i = 0; i < n; i++) {
+      next(client_cq_);
+    }
+    for (ClientCall& cc : client_calls) {
+      grpc_call_unref(cc.call);
+      grpc_slice_unref(cc.status_details);
+      grpc_metadata_array_destroy(&cc.trailing_metadata);
+    }
+  }
+
+ private:
+  struct ClientCall {
+    grpc_call* call;
+    grpc_metadata_array trailing_metadata;
+    grpc_status_code status;
+    grpc_slice status_details;
+  };
+
+  struct ServerCall {
+    grpc_call* call;
+    grpc_call_details details;
+    grpc_metadata_array initial_metadata;
+  };
+
+  void StartClientCalls(std::vector<ClientCall>* calls) {
+    grpc_slice method = grpc_slice_from_static_string("/foo/bar");
+    for (size_t i = 0; i < calls->size(); i++) {
+      ClientCall& cc = (*calls)[i];
+      cc.call = grpc_channel_create_call(
+          channels_[i], nullptr, GRPC_PROPAGATE_DEFAULTS, client_cq_, method,
+          nullptr, gpr_inf_future(GPR_CLOCK_REALTIME), nullptr);
+      grpc_metadata_array_init(&cc.trailing_metadata);
+      grpc_op ops[3];
+      memset(ops, 0, sizeof(ops));
+      ops[0].op = GRPC_OP_SEND_INITIAL_METADATA;
+      ops[1].op = GRPC_OP_SEND_CLOSE_FROM_CLIENT;
+      ops[2].op = GRPC_OP_RECV_STATUS_ON_CLIENT;
+      ops[2].data.recv_status_on_client.trailing_metadata =
+          &cc.trailing_metadata;
+      ops[2].data.recv_status_on_client.status = &cc.status;
+      ops[2].data.recv_status_on_client.status_details = &cc.status_details;
+      GPR_ASSERT(GRPC_CALL_OK ==
+                 grpc_call_start_batch(cc.call, ops, 3, tag(i), nullptr));
+    }
+  }
+
+  void RequestServerCalls(std::vector<ServerCall>* calls) {
+    for (size_t i = 0; i < calls->size(); i++) {
+      ServerCall& sc = (*calls)[i];
+      grpc_call_details_init(&sc.details);
+      grpc_metadata_array_init(&sc.initial_metadata);
+      GPR_ASSERT(GRPC_CALL_OK ==
+                 grpc_server_request_call(server_, &sc.call, &sc.details,
+                                          &sc.initial_metadata, server_cqs_[i],
+                                          server_cqs_[i], tag(i)));
+    }
+  }
+
+  grpc_server* server_;
+  grpc_completion_queue* client_cq_;
+  std::vector<grpc_completion_queue*> server_cqs_;
+  std::vector<grpc_channel*> channels_;
+};
+
+// Args: the number of server completion queues, and whether the calls arrive
+// before they are requested (so that they wait on the pending lists).
+static void BM_RequestMatching(benchmark::State& state) {
+  TrackCounters track_counters;
+  RequestMatchingFixture fixture(state.range(0));
+  for (auto _ : state) {
+    fixture.MatchCalls(state.range(1) != 0);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  track_counters.Finish(state);
+}
+
+static void RequestMatchingArgs(benchmark::internal::Benchmark* b) {
+  for (int calls_first = 0; calls_first <= 1; calls_first++) {
+    for (int num_cqs = 1; num_cqs <= 64; num_cqs *= 4) {
+      b->Args({num_cqs, calls_first});
+    }
+  }
+}
+BENCHMARK(BM_RequestMatching)->Apply(RequestMatchingArgs);
+
+}  // namespace testing
+}  // namespace grpc
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  ::grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
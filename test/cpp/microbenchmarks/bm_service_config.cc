@@ -0,0 +1,107 @@
+/*
+ *
+ * Copyright 2021 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark parsing large service configs */
+
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include "absl/strings/str_cat.h"
+
+#include <grpc/support/log.h>
+
+#include "src/core/ext/filters/client_channel/service_config.h"
+#include "src/core/lib/json/json.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc {
+namespace testing {
+
+// Returns a service config with num_methods method configs, each naming a
+// separate service.
+static std::string LargeServiceConfig(int num_methods) {
+  std::string json = "{\"loadBalancingConfig\": [{\"round_robin\": {}}],";
+  absl::StrAppend(&json, "\"methodConfig\": [");
+  for (int i = 0; i < num_methods; i++) {
+    absl::StrAppend(
+        &json, i == 0 ? "" : ",",
+        "{\"name\": [{\"service\": \"grpc.testing.Service", i,
+        "\", \"method\": \"Method\"}, {\"service\": \"grpc.testing.Service", i,
+        "\", \"method\": \"OtherMethod\"}],"
+        "\"waitForReady\": true,"
+        "\"timeout\": \"1.5s\","
+        "\"maxRequestMessageBytes\": 1048576,"
+        "\"maxResponseMessageBytes\": 4194304,"
+        "\"retryPolicy\": {"
+        "\"maxAttempts\": 3,"
+        "\"initialBackoff\": \"0.1s\","
+        "\"maxBackoff\": \"1s\","
+        "\"backoffMultiplier\": 2,"
+        "\"retryableStatusCodes\": [\"UNAVAILABLE\", \"ABORTED\"]}}");
+  }
+  absl::StrAppend(&json, "]}");
+  return json;
+}
+
+static void BM_JsonParse(benchmark::State& state) {
+  TrackCounters track_counters;
+  std::string json_string = LargeServiceConfig(state.range(0));
+  for (auto _ : state) {
+    grpc_error_handle error = GRPC_ERROR_NONE;
+    grpc_core::Json json = grpc_core::Json::Parse(json_string, &error);
+    GPR_ASSERT(error == GRPC_ERROR_NONE);
+  }
+  state.SetBytesProcessed(state.iterations() * json_string.size());
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_JsonParse)->Range(1, 4096);
+
+static void BM_ServiceConfigCreate(benchmark::State& state) {
+  TrackCounters track_counters;
+  std::string json_string = LargeServiceConfig(state.range(0));
+  for (auto _ : state) {
+    grpc_error_handle error = GRPC_ERROR_NONE;
+    auto service_config =
+        grpc_core::ServiceConfig::Create(nullptr, json_string, &error);
+    GPR_ASSERT(error == GRPC_ERROR_NONE);
+  }
+  state.SetBytesProcessed(state.iterations() * json_string.size());
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_ServiceConfigCreate)->Range(1, 4096);
+
+}  // namespace testing
+}  // namespace grpc
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  ::grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
@@ -0,0 +1,290 @@
+/*
+ *
+ * Copyright 2021 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark how the posix TCP endpoint sizes its read buffers: memory pinned
+   by idle connections, and read syscalls spent per MB of bursty traffic. */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <memory>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <grpc/grpc.h>
+#include <grpc/support/alloc.h>
+#include <grpc/support/log.h>
+
+#include "src/core/lib/iomgr/endpoint.h"
+#include "src/core/lib/iomgr/ev_posix.h"
+#include "src/core/lib/iomgr/pollset.h"
+#include "src/core/lib/iomgr/tcp_posix.h"
+#include "test/core/util/resource_user_util.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace {
+
+constexpr size_t kIdleConnections = 64;
+
+class Poller {
+ public:
+  Poller() {
+    pollset_ = static_cast<grpc_pollset*>(gpr_zalloc(grpc_pollset_size()));
+    grpc_pollset_init(pollset_, &mu_);
+  }
+
+  ~Poller() {
+    grpc_closure destroyed;
+    GRPC_CLOSURE_INIT(&destroyed, Destroy, pollset_, grpc_schedule_on_exec_ctx);
+    gpr_mu_lock(mu_);
+    grpc_pollset_shutdown(pollset_, &destroyed);
+    gpr_mu_unlock(mu_);
+    grpc_core::ExecCtx::Get()->Flush();
+    gpr_free(pollset_);
+  }
+
+  grpc_pollset* pollset() { return pollset_; }
+
+  void PollOnce() {
+    gpr_mu_lock(mu_);
+    grpc_pollset_worker* worker = nullptr;
+    GPR_ASSERT(GRPC_LOG_IF_ERROR(
+        "pollset_work",
+        grpc_pollset_work(pollset_, &worker,
+                          grpc_core::ExecCtx::Get()->Now() + 100)));
+    gpr_mu_unlock(mu_);
+    grpc_core::ExecCtx::Get()->Flush();
+  }
+
+ private:
+  static void Destroy(void* p, grpc_error_handle /*error*/) {
+    grpc_pollset_destroy(static_cast<grpc_pollset*>(p));
+  }
+
+  grpc_pollset* pollset_;
+  gpr_mu* mu_;
+};
+
+// A loopback TCP connection (rather than a socketpair) so that the endpoint
+// gets TCP_INQ information, with the client side left as a raw fd.
+class Connection {
+ public:
+  explicit Connection(Poller* poller) : poller_(poller) {
+    int sv[2];
+    CreateSockets(sv);
+    client_fd_ = sv[0];
+    ep_ = grpc_tcp_create(grpc_fd_create(sv[1], "bm_tcp_read", false),
+                          nullptr, "bm_tcp_read",
+                          grpc_slice_allocator_create_unlimited());
+    grpc_endpoint_add_to_pollset(ep_, poller_->pollset());
+    grpc_slice_buffer_init(&incoming_);
+    GRPC_CLOSURE_INIT(&on_read_, OnRead, this, grpc_schedule_on_exec_ctx);
+  }
+
+  ~Connection() {
+    grpc_endpoint_shutdown(
+        ep_, GRPC_ERROR_CREATE_FROM_STATIC_STRING("benchmark done"));
+    grpc_endpoint_destroy(ep_);
+    grpc_core::ExecCtx::Get()->Flush();
+    grpc_slice_buffer_destroy_internal(&incoming_);
+    close(client_fd_);
+  }
+
+  grpc_endpoint* endpoint() { return ep_; }
+
+  // Bytes of read buffer currently handed to the endpoint.
+  size_t pinned_bytes() const { return incoming_.length; }
+
+  size_t reads() const { return reads_; }
+
+  // Writes as much of data[*offset, size) as the socket takes right now.
+  void Write(const std::vector<char>& data, size_t* offset) {
+    while (*offset < data.size()) {
+      ssize_t n =
+          write(client_fd_, data.data() + *offset, data.size() - *offset);
+      if (n < 0) {
+        GPR_ASSERT(errno == EAGAIN || errno == EINTR);
+        if (errno == EAGAIN) return;
+        continue;
+      }
+      *offset += static_cast<size_t>(n);
+    }
+  }
+
+  // Sends data from the peer and issues reads until all of it has been
+  // received, writing more as socket space frees up.
+  void ReadAll(const std::vector<char>& data) {
+    size_t written = 0;
+    target_ = data.size();
+    received_ = 0;
+    done_ = false;
+    Write(data, &written);
+    StartRead();
+    while (!done_) {
+      Write(data, &written);
+      poller_->PollOnce();
+    }
+  }
+
+  void StartRead() {
+    grpc_endpoint_read(ep_, &incoming_, &on_read_, /*urgent=*/false);
+  }
+
+ private:
+  static void CreateSockets(int sv[2]) {
+    int listener = socket(AF_INET, SOCK_STREAM, 0);
+    GPR_ASSERT(listener >= 0);
+    sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t len = sizeof(addr);
+    GPR_ASSERT(bind(listener, reinterpret_cast<sockaddr*>(&addr), len) == 0);
+    GPR_ASSERT(listen(listener, 1) == 0);
+    GPR_ASSERT(getsockname(listener, reinterpret_cast<sockaddr*>(&addr),
+                           &len) == 0);
+    int client = socket(AF_INET, SOCK_STREAM, 0);
+    GPR_ASSERT(client >= 0);
+    GPR_ASSERT(connect(client, reinterpret_cast<sockaddr*>(&addr), len) == 0);
+    int server;
+    do {
+      server = accept(listener, nullptr, nullptr);
+    } while (server == -1 && errno == EINTR);
+    GPR_ASSERT(server >= 0);
+    close(listener);
+    sv[0] = client;
+    sv[1] = server;
+    for (int i = 0; i < 2; i++) {
+      int flags = fcntl(sv[i], F_GETFL, 0);
+      GPR_ASSERT(fcntl(sv[i], F_SETFL, flags | O_NONBLOCK) == 0);
+    }
+  }
+
+  static void OnRead(void* arg, grpc_error_handle error) {
+    Connection* c = static_cast<Connection*>(arg);
+    if (error != GRPC_ERROR_NONE) return;
+    c->reads_++;
+    c->received_ += c->incoming_.length;
+    grpc_slice_buffer_reset_and_unref_internal(&c->incoming_);
+    if (c->received_ >= c->target_) {
+      c->done_ = true;
+    } else {
+      c->StartRead();
+    }
+  }
+
+  Poller* poller_;
+  int client_fd_;
+  grpc_endpoint* ep_;
+  grpc_slice_buffer incoming_;
+  grpc_closure on_read_;
+  size_t target_ = 0;
+  size_t received_ = 0;
+  size_t reads_ = 0;
+  bool done_ = false;
+};
+
+// Every connection receives one small message, then goes idle with a read
+// outstanding. Reports how much read buffer each idle connection pins.
+static void BM_TcpReadIdleMemory(benchmark::State& state) {
+  TrackCounters track_counters;
+  grpc_core::ExecCtx exec_ctx;
+  Poller poller;
+  std::vector<char> message(state.range(0), 'a');
+  size_t pinned = 0;
+  for (auto _ : state) {
+    std::vector<std::unique_ptr<Connection>> connections;
+    for (size_t i = 0; i < kIdleConnections; i++) {
+      connections.emplace_back(new Connection(&poller));
+      connections.back()->ReadAll(message);
+      connections.back()->StartRead();
+    }
+    grpc_core::ExecCtx::Get()->Flush();
+    for (auto& c : connections) pinned += c->pinned_bytes();
+  }
+  state.counters["idle_bytes_per_conn"] = benchmark::Counter(
+      static_cast<double>(pinned) / kIdleConnections,
+      benchmark::Counter::kAvgIterations);
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_TcpReadIdleMemory)->Arg(64)->Arg(4096)->Arg(65536);
+
+// Bursts of range(0) bytes on a single connection; range(1) says whether the
+// reader announces the burst size through grpc_endpoint_set_read_hint(), as
+// chttp2 does with the size of the frame it is waiting for.
+static void BM_TcpReadBursts(benchmark::State& state) {
+  TrackCounters track_counters;
+  grpc_core::ExecCtx exec_ctx;
+  Poller poller;
+  Connection connection(&poller);
+  std::vector<char> burst(state.range(0), 'a');
+#ifdef GRPC_COLLECT_STATS
+  grpc_stats_data stats_begin;
+  grpc_stats_collect(&stats_begin);
+#endif
+  for (auto _ : state) {
+    if (state.range(1)) {
+      grpc_endpoint_set_read_hint(connection.endpoint(), burst.size());
+    }
+    connection.ReadAll(burst);
+  }
+  double mb = static_cast<double>(state.iterations()) * burst.size() /
+              (1024 * 1024);
+  state.counters["reads_per_MB"] = connection.reads() / mb;
+#ifdef GRPC_COLLECT_STATS
+  grpc_stats_data stats_end;
+  grpc_stats_collect(&stats_end);
+  state.counters["syscalls_per_MB"] =
+      (stats_end.counters[GRPC_STATS_COUNTER_SYSCALL_READ] -
+       stats_begin.counters[GRPC_STATS_COUNTER_SYSCALL_READ]) /
+      mb;
+#endif
+  state.SetBytesProcessed(state.iterations() * burst.size());
+  track_counters.Finish(state);
+}
+static void BurstArgs(benchmark::internal::Benchmark* b) {
+  for (int burst : {16 * 1024, 256 * 1024, 4 * 1024 * 1024}) {
+    b->Args({burst, 0});
+    b->Args({burst, 1});
+  }
+}
+BENCHMARK(BM_TcpReadBursts)->Apply(BurstArgs);
+
+}  // namespace
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  ::grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
@@ -16,14 +16,19 @@
  *
  */
 
+#include <algorithm>
+#include <chrono>
 #include <condition_variable>
 #include <mutex>
+#include <vector>
 
 #include <benchmark/benchmark.h>
 
 #include <grpc/grpc.h>
 
+#include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/iomgr/executor/threadpool.h"
+#include "src/core/lib/iomgr/executor/work_stealing_pool.h"
 #include "test/core/util/test_config.h"
 #include "test/cpp/microbenchmarks/helpers.h"
 #include "test/cpp/util/test_config.h"
@@ -311,6 +316,212 @@ static void BM_SpikyLoad(benchmark::State& state) {
 }
 BENCHMARK(BM_SpikyLoad)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Arg(16);
 
+// A closure for the work-stealing pool that adds another closure from the
+// pool until it has added num_add, as AddAnotherFunctor does.
+class AddAnotherClosure {
+ public:
+  AddAnotherClosure(grpc_core::WorkStealingThreadPool* pool,
+                    BlockingCounter* counter, int num_add)
+      : pool_(pool), counter_(counter), num_add_(num_add) {
+    GRPC_CLOSURE_INIT(&closure_, Run, this, nullptr);
+  }
+
+  grpc_closure* closure() { return &closure_; }
+
+ private:
+  static void Run(void* arg, grpc_error_handle /*error*/) {
+    auto* self = static_cast<AddAnotherClosure*>(arg);
+    if (--self->num_add_ > 0) {
+      auto* next =
+          new AddAnotherClosure(self->pool_, self->counter_, self->num_add_);
+      self->pool_->Add(next->closure(), GRPC_ERROR_NONE, true);
+    } else {
+      self->counter_->DecrementCount();
+    }
+    delete self;
+  }
+
+  grpc_core::WorkStealingThreadPool* pool_;
+  BlockingCounter* counter_;
+  int num_add_;
+  grpc_closure closure_;
+};
+
+template <int kConcurrentFunctor>
+static void WorkStealingPoolAddAnother(benchmark::State& state) {
+  const int num_iterations = state.range(0);
+  const int num_threads = state.range(1);
+  const int num_add = num_iterations / kConcurrentFunctor;
+  grpc_core::ExecCtx exec_ctx;
+  grpc_core::WorkStealingThreadPool pool("bm_work_stealing", num_threads);
+  while (state.KeepRunningBatch(num_iterations)) {
+    BlockingCounter counter(kConcurrentFunctor);
+    for (int i = 0; i < kConcurrentFunctor; ++i) {
+      pool.Add((new AddAnotherClosure(&pool, &counter, num_add))->closure(),
+               GRPC_ERROR_NONE, true);
+    }
+    counter.Wait();
+  }
+  pool.Shutdown();
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_TEMPLATE(WorkStealingPoolAddAnother, 1)
+    ->RangePair(524288, 524288, 1, 1024);
+BENCHMARK_TEMPLATE(WorkStealingPoolAddAnother, 8)
+    ->RangePair(524288, 524288, 1, 1024);
+BENCHMARK_TEMPLATE(WorkStealingPoolAddAnother, 64)
+    ->RangePair(524288, 524288, 1, 1024);
+BENCHMARK_TEMPLATE(WorkStealingPoolAddAnother, 512)
+    ->RangePair(524288, 524288, 1, 1024);
+
+const int kLongTaskEvery = 16;
+const int kShortTaskMicros = 1;
+const int kLongTaskMicros = 200;
+
+// A task of a skewed load: most tasks are short, one in kLongTaskEvery spins
+// for kLongTaskMicros. Records how long it waited between being added and
+// starting to run.
+class SkewedTask : public grpc_completion_queue_functor {
+ public:
+  SkewedTask() {
+    functor_run = &SkewedTask::RunFunctor;
+    inlineable = false;
+    internal_next = this;
+    internal_success = 0;
+    GRPC_CLOSURE_INIT(&closure_, RunClosure, this, nullptr);
+  }
+
+  void Prepare(int index, BlockingCounter* counter) {
+    counter_ = counter;
+    work_micros_ = index % kLongTaskEvery == 0 ? kLongTaskMicros
+                                               : kShortTaskMicros;
+  }
+
+  void AddTo(grpc_core::ThreadPool* pool) {
+    added_ = std::chrono::steady_clock::now();
+    pool->Add(this);
+  }
+  void AddTo(grpc_core::WorkStealingThreadPool* pool) {
+    added_ = std::chrono::steady_clock::now();
+    pool->Add(&closure_, GRPC_ERROR_NONE, true);
+  }
+
+  double wait_micros() const { return wait_micros_; }
+
+ private:
+  static void RunFunctor(grpc_completion_queue_functor* cb, int /*ok*/) {
+    static_cast<SkewedTask*>(cb)->Run();
+  }
+  static void RunClosure(void* arg, grpc_error_handle /*error*/) {
+    static_cast<SkewedTask*>(arg)->Run();
+  }
+
+  void Run() {
+    auto start = std::chrono::steady_clock::now();
+    wait_micros_ =
+        std::chrono::duration<double, std::micro>(start - added_).count();
+    auto end = start + std::chrono::microseconds(work_micros_);
+    while (std::chrono::steady_clock::now() < end) {
+    }
+    counter_->DecrementCount();
+  }
+
+  grpc_closure closure_;
+  BlockingCounter* counter_ = nullptr;
+  int work_micros_ = 0;
+  std::chrono::steady_clock::time_point added_;
+  double wait_micros_ = 0;
+};
+
+// Adds a batch of SkewedTasks from a task running on the pool, so that the
+// work-stealing pool queues them on that thread and the other threads have
+// to steal them.
+template <class Pool>
+class SkewedSpawner : public grpc_completion_queue_functor {
+ public:
+  SkewedSpawner(Pool* pool, std::vector<SkewedTask>* tasks)
+      : pool_(pool), tasks_(tasks) {
+    functor_run = &SkewedSpawner::RunFunctor;
+    inlineable = false;
+    internal_next = this;
+    internal_success = 0;
+    GRPC_CLOSURE_INIT(&closure_, RunClosure, this, nullptr);
+  }
+
+  void AddTo(grpc_core::ThreadPool* pool) { pool->Add(this); }
+  void AddTo(grpc_core::WorkStealingThreadPool* pool) {
+    pool->Add(&closure_, GRPC_ERROR_NONE, true);
+  }
+
+ private:
+  static void RunFunctor(grpc_completion_queue_functor* cb, int /*ok*/) {
+    static_cast<SkewedSpawner*>(cb)->Run();
+  }
+  static void RunClosure(void* arg, grpc_error_handle /*error*/) {
+    static_cast<SkewedSpawner*>(arg)->Run();
+  }
+
+  void Run() {
+    for (auto& task : *tasks_) task.AddTo(pool_);
+  }
+
+  Pool* pool_;
+  std::vector<SkewedTask>* tasks_;
+  grpc_closure closure_;
+};
+
+template <class Pool>
+Pool* NewPool(int num_threads);
+template <>
+grpc_core::ThreadPool* NewPool(int num_threads) {
+  return new grpc_core::ThreadPool(num_threads);
+}
+template <>
+grpc_core::WorkStealingThreadPool* NewPool(int num_threads) {
+  return new grpc_core::WorkStealingThreadPool("bm_skewed_load", num_threads);
+}
+
+void DeletePool(grpc_core::ThreadPool* pool) { delete pool; }
+void DeletePool(grpc_core::WorkStealingThreadPool* pool) {
+  pool->Shutdown();
+  delete pool;
+}
+
+// Runs batches of skewed tasks and reports, besides throughput, the median
+// and tail of the time tasks wait to start: a pool that lets short tasks queue
+// behind long ones shows it in wait_p99_us.
+template <class Pool>
+static void BM_SkewedLoad(benchmark::State& state) {
+  const int num_threads = state.range(0);
+  const int batch_size = 32 * num_threads;
+  grpc_core::ExecCtx exec_ctx;
+  Pool* pool = NewPool<Pool>(num_threads);
+  std::vector<SkewedTask> tasks(batch_size);
+  std::vector<double> waits;
+  while (state.KeepRunningBatch(batch_size)) {
+    BlockingCounter counter(batch_size);
+    for (int i = 0; i < batch_size; ++i) tasks[i].Prepare(i, &counter);
+    SkewedSpawner<Pool> spawner(pool, &tasks);
+    spawner.AddTo(pool);
+    counter.Wait();
+    for (const auto& task : tasks) waits.push_back(task.wait_micros());
+  }
+  DeletePool(pool);
+  state.SetItemsProcessed(state.iterations());
+  std::sort(waits.begin(), waits.end());
+  state.counters["wait_p50_us"] = waits[waits.size() / 2];
+  state.counters["wait_p99_us"] = waits[waits.size() * 99 / 100];
+}
+BENCHMARK_TEMPLATE(BM_SkewedLoad, grpc_core::ThreadPool)
+    ->RangeMultiplier(2)
+    ->Range(1, 16)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_SkewedLoad, grpc_core::WorkStealingThreadPool)
+    ->RangeMultiplier(2)
+    ->Range(1, 16)
+    ->UseRealTime();
+
 }  // namespace testing
 }  // namespace grpc
 
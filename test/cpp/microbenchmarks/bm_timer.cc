@@ -18,6 +18,7 @@
 
 #include <string.h>
 
+#include <algorithm>
 #include <atomic>
 #include <vector>
 
@@ -61,6 +62,40 @@ static void BM_InitCancelTimer(benchmark::State& state) {
 }
 BENCHMARK(BM_InitCancelTimer);
 
+// Every thread keeps kTimerCount timers outstanding with RPC-like deadlines a
+// few seconds out, cancelling the oldest before arming a new one, the way
+// calls that finish before their deadline do. Compare implementations by
+// running with GRPC_TIMER_IMPL=heap and GRPC_TIMER_IMPL=wheel.
+static void BM_InitCancelTimerThreaded(benchmark::State& state) {
+  constexpr int kTimerCount = 1024;
+  TrackCounters track_counters;
+  grpc_core::ExecCtx exec_ctx;
+  std::vector<TimerClosure> timer_closures(kTimerCount);
+  const grpc_millis start = grpc_core::ExecCtx::Get()->Now();
+  size_t i = 0;
+  for (auto _ : state) {
+    TimerClosure* timer_closure = &timer_closures[i % kTimerCount];
+    if (i >= kTimerCount) {
+      grpc_timer_cancel(&timer_closure->timer);
+      exec_ctx.Flush();
+    }
+    GRPC_CLOSURE_INIT(
+        &timer_closure->closure,
+        [](void* /*args*/, grpc_error_handle /*err*/) {}, nullptr,
+        grpc_schedule_on_exec_ctx);
+    grpc_timer_init(&timer_closure->timer, start + 5000 + (i * 7919) % 20000,
+                    &timer_closure->closure);
+    i++;
+  }
+  for (size_t j = 0; j < std::min<size_t>(i, kTimerCount); j++) {
+    grpc_timer_cancel(&timer_closures[j].timer);
+  }
+  exec_ctx.Flush();
+  state.SetItemsProcessed(state.iterations());
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_InitCancelTimerThreaded)->ThreadRange(1, 128)->UseRealTime();
+
 static void BM_TimerBatch(benchmark::State& state) {
   constexpr int kTimerCount = 1024;
   const bool check = state.range(0);
@@ -0,0 +1,183 @@
+/*
+ *
+ * Copyright 2021 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark route selection in large xDS route configurations */
+
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+
+#include <grpc/grpc.h>
+#include <grpc/support/log.h>
+
+#include "src/core/ext/xds/xds_route_table.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc {
+namespace testing {
+
+namespace {
+
+constexpr int kMethodsPerService = 10;
+
+std::string MethodPath(int method) {
+  return absl::StrCat("/pkg.Service", method / kMethodsPerService, "/Method",
+                      method % kMethodsPerService);
+}
+
+grpc_core::StringMatcher MakeStringMatcher(grpc_core::StringMatcher::Type type,
+                                           absl::string_view matcher) {
+  auto string_matcher = grpc_core::StringMatcher::Create(type, matcher);
+  GPR_ASSERT(string_matcher.ok());
+  return std::move(*string_matcher);
+}
+
+// A route configuration with num_routes routes, one per method.  Every
+// regex_every-th route matches its method with a regex, every fifth of the
+// others matches the whole service by prefix and the rest match exactly.
+// The last route catches all remaining paths.
+std::vector<grpc_core::XdsApi::Route::Matchers> MakeRoutes(int num_routes,
+                                                           int regex_every) {
+  std::vector<grpc_core::XdsApi::Route::Matchers> routes(num_routes);
+  for (int i = 0; i < num_routes - 1; ++i) {
+    if (regex_every > 0 && i % regex_every == 0) {
+      routes[i].path_matcher = MakeStringMatcher(
+          grpc_core::StringMatcher::Type::kSafeRegex,
+          absl::StrCat("/pkg\\.Service", i / kMethodsPerService,
+                       "/Method[", i % kMethodsPerService, "]"));
+    } else if (i % 5 == 0) {
+      routes[i].path_matcher = MakeStringMatcher(
+          grpc_core::StringMatcher::Type::kPrefix,
+          absl::StrCat("/pkg.Service", i / kMethodsPerService, "/"));
+    } else {
+      routes[i].path_matcher = MakeStringMatcher(
+          grpc_core::StringMatcher::Type::kExact, MethodPath(i));
+    }
+  }
+  routes.back().path_matcher =
+      MakeStringMatcher(grpc_core::StringMatcher::Type::kPrefix, "");
+  return routes;
+}
+
+std::vector<const grpc_core::XdsApi::Route::Matchers*> RoutePointers(
+    const std::vector<grpc_core::XdsApi::Route::Matchers>& routes) {
+  std::vector<const grpc_core::XdsApi::Route::Matchers*> pointers;
+  for (const auto& route : routes) pointers.push_back(&route);
+  return pointers;
+}
+
+// Paths spread evenly over the routes.
+std::vector<std::string> MakePaths(int num_routes) {
+  std::vector<std::string> paths;
+  for (int i = 0; i < 64; ++i) {
+    paths.push_back(MethodPath(i * (num_routes - 1) / 64));
+  }
+  return paths;
+}
+
+}  // namespace
+
+static void RouteConfigArgs(benchmark::internal::Benchmark* b) {
+  for (int num_routes : {100, 1000, 10000}) {
+    // First argument is the number of routes
+    // Second argument is how often a route uses a regex (0 for never)
+    b->Args({num_routes, 0});
+    b->Args({num_routes, 10});
+  }
+}
+
+// Route selection as done before route tables were compiled: every path
+// matcher in order until one matches.
+static void BM_LinearRouteScan(benchmark::State& state) {
+  auto routes = MakeRoutes(state.range(0), state.range(1));
+  auto paths = MakePaths(state.range(0));
+  size_t i = 0;
+  for (auto _ : state) {
+    const std::string& path = paths[i++ % paths.size()];
+    for (const auto& route : routes) {
+      if (route.path_matcher.Match(path)) break;
+    }
+  }
+}
+BENCHMARK(BM_LinearRouteScan)->Apply(RouteConfigArgs);
+
+static void BM_XdsRouteTableLookup(benchmark::State& state) {
+  auto routes = MakeRoutes(state.range(0), state.range(1));
+  auto paths = MakePaths(state.range(0));
+  grpc_core::XdsRouteTable table(RoutePointers(routes));
+  grpc_metadata_batch initial_metadata;
+  size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(table.GetRouteForRequest(
+        paths[i++ % paths.size()], &initial_metadata));
+  }
+}
+BENCHMARK(BM_XdsRouteTableLookup)->Apply(RouteConfigArgs);
+
+// Lookups of paths that are not cached, as for the first call to each method.
+static void BM_XdsRouteTableUncachedLookup(benchmark::State& state) {
+  auto routes = MakeRoutes(state.range(0), state.range(1));
+  auto paths = MakePaths(state.range(0));
+  grpc_metadata_batch initial_metadata;
+  std::unique_ptr<grpc_core::XdsRouteTable> table;
+  size_t i = 0;
+  for (auto _ : state) {
+    if (i % paths.size() == 0) {
+      state.PauseTiming();
+      table =
+          absl::make_unique<grpc_core::XdsRouteTable>(RoutePointers(routes));
+      state.ResumeTiming();
+    }
+    benchmark::DoNotOptimize(table->GetRouteForRequest(
+        paths[i++ % paths.size()], &initial_metadata));
+  }
+}
+BENCHMARK(BM_XdsRouteTableUncachedLookup)->Apply(RouteConfigArgs);
+
+// Compiling the route table, done on every route configuration update.
+static void BM_XdsRouteTableBuild(benchmark::State& state) {
+  auto routes = MakeRoutes(state.range(0), state.range(1));
+  for (auto _ : state) {
+    grpc_core::XdsRouteTable table(RoutePointers(routes));
+  }
+}
+BENCHMARK(BM_XdsRouteTableBuild)->Apply(RouteConfigArgs);
+
+}  // namespace testing
+}  // namespace grpc
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char* argv[]) {
+  grpc::testing::TestEnvironment env(argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  ::grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
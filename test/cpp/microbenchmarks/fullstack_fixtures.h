@@ -32,6 +32,7 @@
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/iomgr/endpoint.h"
 #include "src/core/lib/iomgr/endpoint_pair.h"
+#include "src/core/lib/iomgr/ev_posix.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/iomgr/tcp_posix.h"
 #include "src/core/lib/surface/channel.h"
@@ -128,6 +129,33 @@ class TCP : public FullstackFixture {
   }
 };
 
+// Sets the poller's busy polling budget for as long as it is alive.
+class ScopedBusyPoll {
+ public:
+  explicit ScopedBusyPoll(int usec)
+      : saved_usec_(grpc_event_engine_busy_poll_us()) {
+    grpc_event_engine_set_busy_poll_us(usec);
+  }
+  ~ScopedBusyPoll() { grpc_event_engine_set_busy_poll_us(saved_usec_); }
+
+ private:
+  const int saved_usec_;
+};
+
+// TCP, with the poller spinning for a while before it sleeps and SO_BUSY_POLL
+// set on the server's connections. Only epoll1 busy polls; with any other
+// engine this is equivalent to TCP.
+class BusyPollTCP : private ScopedBusyPoll, public TCP {
+ public:
+  explicit BusyPollTCP(Service* service,
+                       const FixtureConfiguration& fixture_configuration =
+                           FixtureConfiguration())
+      : ScopedBusyPoll(kBusyPollUs), TCP(service, fixture_configuration) {}
+
+ private:
+  static constexpr int kBusyPollUs = 50;
+};
+
 class UDS : public FullstackFixture {
  public:
   explicit UDS(Service* service,
@@ -327,6 +355,7 @@ class MinStackize : public Base {
 };
 
 typedef MinStackize<TCP> MinTCP;
+typedef MinStackize<BusyPollTCP> MinBusyPollTCP;
 typedef MinStackize<UDS> MinUDS;
 typedef MinStackize<InProcess> MinInProcess;
 typedef MinStackize<SockPair> MinSockPair;
@@ -20,6 +20,8 @@
 
 #include "src/cpp/thread_manager/thread_manager.h"
 
+#include <inttypes.h>
+
 #include <atomic>
 #include <chrono>
 #include <climits>
@@ -178,6 +180,33 @@ TEST_P(ThreadManagerTest, TestThreadQuota) {
   }
 }
 
+// With a single poller, every piece of work found needs another thread to take
+// over the polling. Threads that finish their work park and are reused for
+// that instead of a new thread being created each time.
+TEST(ThreadManagerStatsTest, TestThreadReuse) {
+  TestThreadManagerSettings settings = {
+      1 /* min_pollers */,     1 /* max_pollers */,
+      1 /* poll_duration_ms */, 2 /* work_duration_ms */,
+      200 /* max_poll_calls */, INT_MAX /* thread_limit */,
+      1 /* thread_manager_count */};
+  grpc_resource_quota* rq = grpc_resource_quota_create("Thread manager test");
+  TestThreadManager tm("TestThreadManager", rq, settings);
+  grpc_resource_quota_unref(rq);
+  tm.Initialize();
+  tm.Wait();
+  ThreadManager::Stats stats = tm.GetStats();
+  gpr_log(GPR_DEBUG,
+          "%d work found: %" PRId64 " threads created, %" PRId64 " reused",
+          tm.num_work_found(), stats.threads_created, stats.threads_reused);
+  EXPECT_EQ(tm.num_do_work(), tm.num_work_found());
+  EXPECT_GT(stats.threads_reused, 0);
+  EXPECT_LT(stats.threads_created, tm.num_work_found());
+  EXPECT_EQ(stats.threads_created, stats.threads_exited);
+  EXPECT_EQ(stats.num_threads, 0);
+  EXPECT_EQ(stats.num_parked, 0);
+  EXPECT_EQ(stats.target_pollers, 1);
+}
+
 }  // namespace
 }  // namespace grpc
 
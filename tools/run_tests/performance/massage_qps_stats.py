@@ -43,6 +43,10 @@ def massage_qps_stats(scenario_result):
                     core_stats, "server_channels_created")
             stats["core_syscall_poll"] = massage_qps_stats_helpers.counter(
                 core_stats, "syscall_poll")
+            stats["core_busy_poll_spins"] = massage_qps_stats_helpers.counter(
+                core_stats, "busy_poll_spins")
+            stats["core_busy_poll_hits"] = massage_qps_stats_helpers.counter(
+                core_stats, "busy_poll_hits")
             stats["core_syscall_wait"] = massage_qps_stats_helpers.counter(
                 core_stats, "syscall_wait")
             stats["core_pollset_kick"] = massage_qps_stats_helpers.counter(
@@ -80,6 +84,12 @@ def massage_qps_stats(scenario_result):
             stats[
                 "core_tcp_backup_poller_polls"] = massage_qps_stats_helpers.counter(
                     core_stats, "tcp_backup_poller_polls")
+            stats[
+                "core_tcp_rx_zerocopy_hits"] = massage_qps_stats_helpers.counter(
+                    core_stats, "tcp_rx_zerocopy_hits")
+            stats[
+                "core_tcp_rx_zerocopy_fallbacks"] = massage_qps_stats_helpers.counter(
+                    core_stats, "tcp_rx_zerocopy_fallbacks")
             stats["core_http2_op_batches"] = massage_qps_stats_helpers.counter(
                 core_stats, "http2_op_batches")
             stats["core_http2_op_cancel"] = massage_qps_stats_helpers.counter(
@@ -119,6 +129,9 @@ def massage_qps_stats(scenario_result):
             stats[
                 "core_http2_partial_writes"] = massage_qps_stats_helpers.counter(
                     core_stats, "http2_partial_writes")
+            stats[
+                "core_http2_writes_coalesced"] = massage_qps_stats_helpers.counter(
+                    core_stats, "http2_writes_coalesced")
             stats[
                 "core_http2_initiate_write_due_to_initial_write"] = massage_qps_stats_helpers.counter(
                     core_stats, "http2_initiate_write_due_to_initial_write")
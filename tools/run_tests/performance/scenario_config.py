@@ -299,6 +299,21 @@ class CXXLanguage(Language):
             server_threads_per_cq=1,
             categories=[SCALABLE])
 
+        # Poisson arrivals make the number of sync server threads needed vary
+        # over time, which exercises how the ThreadManager sizes its pool.
+        yield _ping_pong_scenario(
+            'cpp_protobuf_async_client_sync_server_unary_10Kqps_poisson',
+            rpc_type='UNARY',
+            client_type='ASYNC_CLIENT',
+            server_type='SYNC_SERVER',
+            unconstrained_client='async',
+            outstanding=1000,
+            channels=64,
+            offered_load=10000,
+            secure=False,
+            minimal_stack=True,
+            categories=[SWEEP])
+
         for secure in [True, False]:
             secstr = 'secure' if secure else 'insecure'
             smoketest_categories = ([SMOKETEST] if secure else [])
@@ -63,7 +63,7 @@ _FORCE_ENVIRON_FOR_WRAPPERS = {
 }
 
 _POLLING_STRATEGIES = {
-    'linux': ['epollex', 'epoll1', 'poll'],
+    'linux': ['epollex', 'epoll1', 'poll', 'io_uring'],
     'mac': ['poll'],
 }
 
@@ -1756,6 +1756,23 @@ def _has_epollexclusive():
         return False
 
 
+def _has_io_uring():
+    # io_uring_setup has the same syscall number on every architecture. It
+    # fails when the kernel is too old or a seccomp filter blocks it, as in
+    # many containers, and the io_uring poller can't initialize then.
+    try:
+        import ctypes
+        libc = ctypes.CDLL(None, use_errno=True)
+        params = ctypes.create_string_buffer(120)
+        fd = libc.syscall(425, 1, params)
+    except (OSError, AttributeError):
+        return False
+    if fd < 0:
+        return False
+    os.close(fd)
+    return True
+
+
 # returns a list of things that failed (or an empty list on success)
 def _build_and_run(check_cancelled,
                    newline_on_success,
@@ -1783,6 +1800,11 @@ def _build_and_run(check_cancelled,
         print('\n\nOmitting EPOLLEXCLUSIVE tests\n\n')
         _POLLING_STRATEGIES[platform_string()].remove('epollex')
 
+    if 'io_uring' in _POLLING_STRATEGIES.get(platform_string(),
+                                             []) and not _has_io_uring():
+        print('\n\nOmitting io_uring tests\n\n')
+        _POLLING_STRATEGIES[platform_string()].remove('io_uring')
+
     # start antagonists
     antagonists = [
         subprocess.Popen(['tools/run_tests/python_utils/antagonist.py'])